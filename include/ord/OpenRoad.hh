@@ -213,7 +213,8 @@ public:
 		    bool sort,
 		    bool include_pwr_gnd,
 		    std::vector<sta::LibertyCell*> *remove_cells);
-  void linkDesign(const char *top_cell_name);
+  void linkDesign(const char *top_cell_name,
+                  bool release_verilog = false);
 
   void readDb(const char *filename);
   void writeDb(const char *filename);
@@ -44,6 +44,7 @@
 
 #include "utl/MakeLogger.h"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 
 #include "odb/db.h"
 #include "odb/lefin.h"
@@ -423,10 +424,11 @@ OpenRoad::readVerilog(const char *filename)
 }
 
 void
-OpenRoad::linkDesign(const char *design_name)
+OpenRoad::linkDesign(const char *design_name,
+                     bool release_verilog)
 
 {
-  dbLinkDesign(design_name, verilog_network_, db_, logger_);
+  dbLinkDesign(design_name, verilog_network_, db_, logger_, release_verilog);
   for (Observer* observer : observers_) {
     observer->postReadDb(db_);
   }
@@ -507,6 +509,7 @@ OpenRoad::setThreadCount(int threads, bool printInfo) {
 
   // place limits on tools with threads
   sta_->setThreadCount(threads_);
+  utl::ThreadPool::get().setThreadCount(threads_);
 }
 
 void
@@ -719,7 +719,7 @@ void AntennaChecker::calculate_PAR_info(PARinfo& it)
 {
   dbWireGraph::Node* wireroot = it.WirerootNode;
   odb::dbTechLayer* tech_layer = wireroot->layer();
-  ANTENNAmodel am = layer_info[tech_layer];
+  const ANTENNAmodel& am = layer_info.at(tech_layer);
 
   double metal_factor = am.metal_factor;
   double diff_metal_factor = am.diff_metal_factor;
@@ -895,7 +895,7 @@ void AntennaChecker::build_VIA_PAR_table(
       dbTechLayer* layer = get_via_layer(
           find_via(wireroot, wireroot->layer()->getRoutingLevel()));
 
-      ANTENNAmodel am = layer_info[layer];
+      const ANTENNAmodel& am = layer_info.at(layer);
       minus_diff_factor = am.minus_diff_factor;
       plus_diff_factor = am.plus_diff_factor;
       diff_metal_reduce_factor = am.diff_metal_reduce_factor;
@@ -1719,7 +1719,7 @@ AntennaChecker::PAR_max_wire_length(dbNet* net, int layer)
             wireroot, iterm_areas, tech_layer->getRoutingLevel(), iv, nv);
         double wire_width = defdist(tech_layer->getWidth());
 
-        ANTENNAmodel am = layer_info[tech_layer];
+        const ANTENNAmodel& am = layer_info.at(tech_layer);
         double metal_factor = am.metal_factor;
         double diff_metal_factor = am.diff_metal_factor;
 
@@ -1968,7 +1968,7 @@ AntennaChecker::get_violated_wire_length(dbNet* net, int routing_level)
 
       double wire_width = defdist(tech_layer->getWidth());
 
-      ANTENNAmodel am = layer_info[tech_layer];
+      const ANTENNAmodel& am = layer_info.at(tech_layer);
       double metal_factor = am.metal_factor;
       double diff_metal_factor = am.diff_metal_factor;
 
@@ -95,6 +95,8 @@ class TritonCTS
   void findClockRoots();
   void buildClockTrees();
   void runPostCtsOpt();
+  bool canRunBuildersConcurrently() const;
+  void runBuilders(const std::function<void(TreeBuilder*)>& func);
   void writeDataToDb();
 
   // db functions
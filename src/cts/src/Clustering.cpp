@@ -205,7 +205,9 @@ float Clustering::Kmeans(unsigned N,
     fixSegmentLengths(means);
 
     // flop to slot matching based on min-cost flow
-    if (iter == 1)
+    if (N == 2 && flops_.size() >= sortedMatchingMinFlops_)
+      sortedMatching(means, CAP, IDX, 5200, power);
+    else if (iter == 1)
       minCostFlow(means, CAP, IDX, 5200, power);
     else if (iter == 2)
       minCostFlow(means, CAP, IDX, 5200, power);
@@ -474,6 +476,101 @@ void Clustering::minCostFlow(const std::vector<std::pair<float, float>>& means,
   }
 }
 
+/*** Sorted Matching ******************************************************/
+// Same assignment problem as minCostFlow, solved directly for two means.
+// Once the flops that can reach only one mean are placed, the rest go to
+// mean 0 in order of how much cheaper mean 0 is for them, so a sort replaces
+// the flow graph that gets too large for big clock domains.
+void Clustering::sortedMatching(
+    const std::vector<std::pair<float, float>>& means,
+    unsigned CAP,
+    unsigned IDX,
+    float DIST,
+    unsigned power)
+{
+  const long int numFlops = flops_.size();
+  const int remaining = numFlops % means.size();
+
+  // Arc costs as minCostFlow computes them, -1 where there is no arc.
+  std::vector<std::array<long int, 2>> costs(numFlops);
+  for (long int i = 0; i < numFlops; ++i) {
+    for (long int j = 0; j < 2; ++j) {
+      float d = calcDist(means[j], &flops_[i]);
+      if (d <= DIST && std::pow(d, power) < std::numeric_limits<int>::max()) {
+        d = std::pow(d, power);
+        costs[i][j] = (int) d;
+      } else {
+        costs[i][j] = -1;
+      }
+    }
+    flops_[i].match_idx[IDX] = std::make_pair(-1, -1);
+  }
+
+  long int slots[2];
+  std::vector<long int> forced[2];
+  std::vector<long int> shared;
+  for (long int j = 0; j < 2; ++j) {
+    slots[j] = (j < remaining) ? CAP + 1 : CAP;
+  }
+  for (long int i = 0; i < numFlops; ++i) {
+    if (costs[i][0] >= 0 && costs[i][1] >= 0) {
+      shared.push_back(i);
+    } else if (costs[i][0] >= 0) {
+      forced[0].push_back(i);
+    } else if (costs[i][1] >= 0) {
+      forced[1].push_back(i);
+    }
+  }
+
+  long int assigned = 0;
+  // Flops that reach a single mean take it, cheapest first.
+  for (long int j = 0; j < 2; ++j) {
+    std::stable_sort(
+        forced[j].begin(), forced[j].end(), [&](long int a, long int b) {
+          return costs[a][j] < costs[b][j];
+        });
+    const long int count = std::min<long int>(forced[j].size(), slots[j]);
+    for (long int k = 0; k < count; ++k) {
+      flops_[forced[j][k]].match_idx[IDX] = std::make_pair(j, 0);
+    }
+    slots[j] -= count;
+    assigned += count;
+  }
+
+  // Flops that reach both means are ordered by how much they gain by going
+  // to mean 0; a prefix of that order goes to mean 0, the rest to mean 1.
+  std::stable_sort(shared.begin(), shared.end(), [&](long int a, long int b) {
+    return costs[a][0] - costs[a][1] < costs[b][0] - costs[b][1];
+  });
+  const long int numShared = shared.size();
+  long int toFirst = 0;
+  while (toFirst < numShared
+         && costs[shared[toFirst]][0] < costs[shared[toFirst]][1]) {
+    ++toFirst;
+  }
+  // Keep both means within their capacity. When there are more flops than
+  // slots, the ones in the middle of the order are left to the nearest mean
+  // fallback in Kmeans.
+  toFirst = std::max(toFirst, numShared - slots[1]);
+  toFirst = std::min(toFirst, slots[0]);
+  const long int toSecond = std::min(numShared - toFirst, slots[1]);
+  for (long int k = 0; k < toFirst; ++k) {
+    flops_[shared[k]].match_idx[IDX] = std::make_pair(0, 0);
+  }
+  for (long int k = numShared - toSecond; k < numShared; ++k) {
+    flops_[shared[k]].match_idx[IDX] = std::make_pair(1, 0);
+  }
+  assigned += toFirst + toSecond;
+
+  debugPrint(logger_,
+             CTS,
+             "tritoncts",
+             1,
+             "Sorted matching assigned {} of {} flops",
+             assigned,
+             numFlops);
+}
+
 void Clustering::plotClusters(
     const std::vector<std::vector<Flop*>>& clusters,
     const std::vector<std::pair<float, float>>& means,
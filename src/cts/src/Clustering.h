@@ -67,6 +67,8 @@ class Clustering
 
   static const int test_layout_ = 1;
   static const int test_iter_ = 1;
+  // Two-means clustering of at least this many flops skips the flow graph.
+  static const unsigned sortedMatchingMinFlops_ = 20000;
   std::string plotFile_;
 
   float segmentLength_;
@@ -99,7 +101,13 @@ class Clustering
                    unsigned,
                    float,
                    unsigned);
+  void sortedMatching(const std::vector<std::pair<float, float>>&,
+                      unsigned,
+                      unsigned,
+                      float,
+                      unsigned);
   void setPlotFileName(const std::string fileName) { plotFile_ = fileName; }
+  const std::vector<Flop>& getFlops() const { return flops_; }
   void getClusters(std::vector<std::vector<unsigned>>&);
   void fixSegmentLengths(std::vector<std::pair<float, float>>&);
   void fixSegment(const std::pair<float, float>& fixedPoint,
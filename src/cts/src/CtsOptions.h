@@ -113,6 +113,8 @@ class CtsOptions
   }
   void setOutputPath(const std::string& path) { outputPath_ = path; }
   std::string getOutputPath() const { return outputPath_; }
+  void setCharCacheDir(const std::string& dir) { charCacheDir_ = dir; }
+  std::string getCharCacheDir() const { return charCacheDir_; }
   void setCapInter(double cap) { capInter_ = cap; }
   double getCapInter() const { return capInter_; }
   void setSlewInter(double slew) { slewInter_ = slew; }
@@ -206,6 +208,7 @@ class CtsOptions
  private:
   std::string blockName_ = "";
   std::string outputPath_ = "";
+  std::string charCacheDir_ = "";
   std::string clockNets_ = "";
   std::string rootBuffer_ = "";
   std::string sinkBuffer_ = "";
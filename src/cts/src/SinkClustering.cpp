@@ -44,6 +44,7 @@
 #include <tuple>
 
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 
 namespace cts {
 
@@ -154,19 +155,6 @@ void SinkClustering::run(unsigned groupSize, float maxDiameter, int scaleFactor)
 
 void SinkClustering::findBestMatching(unsigned groupSize)
 {
-  // Counts how many clusters are in each solution.
-  vector<unsigned> clusters(groupSize, 0);
-  // Keeps track of the total cost of each solution.
-  vector<double> costs(groupSize, 0);
-  vector<double> previousCosts(groupSize, 0);
-  // Has the points for each cluster of each solution.
-  vector<vector<vector<Point<double>>>> solutionPoints;
-  // Has the points index for each cluster of each solution.
-  // example: solutionsPointsIdx[solutionId][clusterIdx][pointIdx]
-  vector<vector<vector<unsigned>>> solutionPointsIdx;
-  // Has the sink indexes for each cluster of each solution.
-  vector<vector<vector<unsigned>>> solutions;
-
   if (useMaxCapLimit_) {
     debugPrint(logger_,
                CTS,
@@ -175,174 +163,38 @@ void SinkClustering::findBestMatching(unsigned groupSize)
                "Clustering with max cap limit of {:.3e}",
                options_->getSinkBufferMaxCap());
   }
-  // Iterates over the theta vector.
-  for (unsigned i = 0; i < thetaIndexVector_.size(); ++i) {
-    // The - groupSize is because each solution will start on a different index.
-    // There is groupSize solutions.
-    for (unsigned j = 0; j < groupSize; ++j) {
-      if (!((i + j) >= thetaIndexVector_.size())) {
-        // Add vectors in case they are no allocated yet.
-        if (solutions.size() < (j + 1)) {
-          vector<vector<unsigned>> clusterIndexes;
-          solutions.push_back(clusterIndexes);
-          vector<vector<Point<double>>> clusterPoints;
-          solutionPoints.push_back(clusterPoints);
-          vector<vector<unsigned>> clusterPointsIdx;
-          solutionPointsIdx.push_back(clusterPointsIdx);
-        }
-        if (solutions[j].size() < (clusters[j] + 1)) {
-          vector<unsigned> indexesVector;
-          solutions[j].push_back(indexesVector);
-          vector<Point<double>> pointsVector;
-          solutionPoints[j].push_back(pointsVector);
-          vector<unsigned> idxVector;
-          solutionPointsIdx[j].push_back(idxVector);
-        }
-        // Get the current point
-        unsigned idx = thetaIndexVector_[i + j].second;
-        Point<double>& p = points_[idx];
-        double distanceCost = 0;
-        double capCost = pointsCap_[idx];
-        unsigned pointIdx = 0;
-        // Check the distance from the current point to others in the cluster,
-        // if there are any.
-        for (Point<double> comparisonPoint : solutionPoints[j][clusters[j]]) {
-          double cost = p.computeDist(comparisonPoint);
-          if (useMaxCapLimit_) {
-            capCost
-                += cost * capPerUnit_
-                   + pointsCap_[solutionPointsIdx[j][clusters[j]][pointIdx]];
-          }
-          pointIdx++;
-          if (cost > distanceCost) {
-            distanceCost = cost;
-          }
-        }
-        // If the cluster size is higher than groupSize,
-        // or the distance is higher than maxInternalDiameter_
-        //-> start another cluster and save the cost of the current one.
-        if (isLimitExceeded(solutionPoints[j][clusters[j]].size(),
-                            distanceCost,
-                            capCost,
-                            groupSize)) {
-          debugPrint(logger_,
-                     CTS,
-                     "Stree",
-                     4,
-                     "Created cluster of size {}, dia {:.3}, cap {:.3e}",
-                     solutionPoints[j][clusters[j]].size(),
-                     distanceCost,
-                     capCost);
-          // The cost is computed as the highest cost found on the current
-          // cluster
-          if (previousCosts[j] == 0) {
-            previousCosts[j] = maxInternalDiameter_;
-          }
-          costs[j] += previousCosts[j];
-          // A new cluster is defined
-          clusters[j] = clusters[j] + 1;
-          // The cost was already saved, so the same structure can be used for
-          // the next cluster.
-          previousCosts[j] = 0;
-        } else {
-          // Node will be a part of the current cluster, thus, save the highest
-          // cost.
-          if (distanceCost > previousCosts[j]) {
-            previousCosts[j] = distanceCost;
-          }
-        }
-        // Add vectors in case they are no allocated yet. (Depends if a new
-        // cluster was defined above)
-        if (solutions[j].size() < (clusters[j] + 1)) {
-          vector<unsigned> indexesVector;
-          solutions[j].push_back(indexesVector);
-          vector<Point<double>> pointsVector;
-          solutionPoints[j].push_back(pointsVector);
-          vector<unsigned> idxVector;
-          solutionPointsIdx[j].push_back(idxVector);
-        }
-        // Save the current Point in it's respective cluster. (Depends if a new
-        // cluster was defined above)
-        solutionPoints[j][clusters[j]].push_back(p);
-        solutionPointsIdx[j][clusters[j]].push_back(idx);
-        solutions[j][clusters[j]].push_back(idx);
-      }
-    }
-  }
 
-  // Same computation as above, however, only for the first groupSize Points.
-  for (unsigned i = 0; i < groupSize; ++i) {
-    // This is because every solution after the first one skips a Point (starts
-    // one late).
-    for (unsigned j = (i + 1); j < groupSize; ++j) {
-      if (solutions[j].size() < (clusters[j] + 1)) {
-        vector<unsigned> indexesVector;
-        solutions[j].push_back(indexesVector);
-        vector<Point<double>> pointsVector;
-        solutionPoints[j].push_back(pointsVector);
-        vector<unsigned> idxVector;
-        solutionPointsIdx[j].push_back(idxVector);
-      }
-      // Thus here we will assign the Points missing from those solutions.
-      unsigned idx = thetaIndexVector_[i].second;
-      Point<double>& p = points_[idx];
-      unsigned pointIdx = 0;
-      double distanceCost = 0;
-      double capCost = pointsCap_[idx];
-      for (Point<double> comparisonPoint : solutionPoints[j][clusters[j]]) {
-        double cost = p.computeDist(comparisonPoint);
-        if (useMaxCapLimit_) {
-          capCost += cost * capPerUnit_
-                     + pointsCap_[solutionPointsIdx[j][clusters[j]][pointIdx]];
-        }
-        pointIdx++;
-        if (cost > distanceCost) {
-          distanceCost = cost;
-        }
-      }
-
-      if (isLimitExceeded(solutionPoints[j][clusters[j]].size(),
-                          distanceCost,
-                          capCost,
-                          groupSize)) {
-        debugPrint(logger_,
-                   CTS,
-                   "Stree",
-                   4,
-                   "Created cluster of size {}, dia {:.3}, cap {:.3e}",
-                   solutionPoints[j][clusters[j]].size(),
-                   distanceCost,
-                   capCost);
-        if (previousCosts[j] == 0) {
-          previousCosts[j] = maxInternalDiameter_;
-        }
-        costs[j] += previousCosts[j];
-        clusters[j] = clusters[j] + 1;
-        previousCosts[j] = 0;
-      } else {
-        if (distanceCost > previousCosts[j]) {
-          previousCosts[j] = distanceCost;
-        }
-      }
-      if (solutions[j].size() < (clusters[j] + 1)) {
-        vector<unsigned> indexesVector;
-        solutions[j].push_back(indexesVector);
-        vector<Point<double>> pointsVector;
-        solutionPoints[j].push_back(pointsVector);
-        vector<unsigned> idxVector;
-        solutionPointsIdx[j].push_back(idxVector);
-      }
-      solutionPoints[j][clusters[j]].push_back(p);
-      solutionPointsIdx[j][clusters[j]].push_back(idx);
-      solutions[j][clusters[j]].push_back(idx);
-    }
+  const unsigned numPoints = thetaIndexVector_.size();
+  bestSolution_.clear();
+  if (numPoints == 0) {
+    return;
   }
 
+  // Solution j visits the sorted thetas starting at index j and wraps around
+  // to the first j points. Only the cluster boundaries of each solution are
+  // kept, so memory stays linear in the number of points even for very large
+  // clock domains.
+  const unsigned numSolutions = std::min(groupSize, numPoints);
+  // Keeps track of the total cost of each solution.
+  vector<double> costs(numSolutions, 0);
+  // Has the theta positions where each cluster of each solution starts.
+  vector<vector<unsigned>> clusterStarts(numSolutions);
+  // Per cluster debug messages are only readable when solutions are built one
+  // after the other.
+  const int maxThreads = logger_->debugCheck(CTS, "Stree", 4) ? 1 : 0;
+  utl::ThreadPool::get().parallelFor(
+      0,
+      numSolutions,
+      [&](int j) {
+        costs[j] = solutionCost(j, groupSize, clusterStarts[j]);
+      },
+      maxThreads);
+
   unsigned bestSolution = 0;
   double bestSolutionCost = costs[0];
 
   // Find the solution with minimum cost.
-  for (unsigned j = 1; j < groupSize; ++j) {
+  for (unsigned j = 1; j < numSolutions; ++j) {
     if (costs[j] < bestSolutionCost) {
       bestSolution = j;
       bestSolutionCost = costs[j];
@@ -351,7 +203,78 @@ void SinkClustering::findBestMatching(unsigned groupSize)
   debugPrint(
       logger_, CTS, "Stree", 2, "Best solution cost = {:.3}", bestSolutionCost);
   // Save the solution for the Tree Builder.
-  bestSolution_ = solutions[bestSolution];
+  const vector<unsigned>& starts = clusterStarts[bestSolution];
+  bestSolution_.resize(starts.size());
+  for (unsigned cluster = 0; cluster < starts.size(); ++cluster) {
+    const unsigned clusterEnd
+        = (cluster + 1 < starts.size()) ? starts[cluster + 1] : numPoints;
+    for (unsigned pos = starts[cluster]; pos < clusterEnd; ++pos) {
+      const unsigned idx
+          = thetaIndexVector_[(bestSolution + pos) % numPoints].second;
+      bestSolution_[cluster].push_back(idx);
+    }
+  }
+}
+
+double SinkClustering::solutionCost(unsigned start,
+                                    unsigned groupSize,
+                                    vector<unsigned>& clusterStarts)
+{
+  const unsigned numPoints = thetaIndexVector_.size();
+  // Keeps track of the total cost of the solution.
+  double cost = 0;
+  double previousCost = 0;
+  clusterStarts.push_back(0);
+  for (unsigned pos = 0; pos < numPoints; ++pos) {
+    // Get the current point
+    const unsigned idx = thetaIndexVector_[(start + pos) % numPoints].second;
+    const Point<double>& p = points_[idx];
+    double distanceCost = 0;
+    double capCost = pointsCap_[idx];
+    // Check the distance from the current point to others in the cluster,
+    // if there are any.
+    for (unsigned other = clusterStarts.back(); other < pos; ++other) {
+      const unsigned otherIdx
+          = thetaIndexVector_[(start + other) % numPoints].second;
+      double dist = p.computeDist(points_[otherIdx]);
+      if (useMaxCapLimit_) {
+        capCost += dist * capPerUnit_ + pointsCap_[otherIdx];
+      }
+      if (dist > distanceCost) {
+        distanceCost = dist;
+      }
+    }
+    // If the cluster size is higher than groupSize,
+    // or the distance is higher than maxInternalDiameter_
+    //-> start another cluster and save the cost of the current one.
+    const unsigned clusterSize = pos - clusterStarts.back();
+    if (isLimitExceeded(clusterSize, distanceCost, capCost, groupSize)) {
+      debugPrint(logger_,
+                 CTS,
+                 "Stree",
+                 4,
+                 "Created cluster of size {}, dia {:.3}, cap {:.3e}",
+                 clusterSize,
+                 distanceCost,
+                 capCost);
+      // The cost is computed as the highest cost found on the current
+      // cluster
+      if (previousCost == 0) {
+        previousCost = maxInternalDiameter_;
+      }
+      cost += previousCost;
+      // A new cluster is defined, starting at the current point.
+      clusterStarts.push_back(pos);
+      previousCost = 0;
+    } else {
+      // Node will be a part of the current cluster, thus, save the highest
+      // cost.
+      if (distanceCost > previousCost) {
+        previousCost = distanceCost;
+      }
+    }
+  }
+  return cost;
 }
 
 bool SinkClustering::isLimitExceeded(unsigned size,
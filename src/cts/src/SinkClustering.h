@@ -90,6 +90,9 @@ class SinkClustering
   void sortPoints();
   void writePlotFile();
   void findBestMatching(unsigned groupSize);
+  double solutionCost(unsigned start,
+                      unsigned groupSize,
+                      std::vector<unsigned>& clusterStarts);
   void writePlotFile(unsigned groupSize);
 
   double computeTheta(double x, double y) const;
@@ -36,8 +36,11 @@
 #include "TechChar.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstdio>
 #include <fstream>
 #include <iomanip>
+#include <limits>
 #include <ostream>
 #include <sstream>
 
@@ -1119,6 +1122,37 @@ void TechChar::create()
 {
   // Setup of the attributes required to run the characterization.
   initCharacterization();
+  std::vector<ResultData> convertedSolutions;
+  const std::string cacheFile = characterizationCacheFile();
+  if (cacheFile.empty()
+      || !readCharacterizationCache(cacheFile, convertedSolutions)) {
+    runCharacterization();
+    // Post-processing of the results.
+    convertedSolutions = characterizationPostProcess();
+    if (!cacheFile.empty()) {
+      writeCharacterizationCache(cacheFile, convertedSolutions);
+    }
+  }
+  // Changes the segment units back to micron and creates the wire segments.
+  float dbUnitsPerMicron = charBlock_->getDbUnitsPerMicron();
+  float segmentDistance = options_->getWireSegmentUnit();
+  options_->setWireSegmentUnit(segmentDistance / dbUnitsPerMicron);
+  compileLut(convertedSolutions);
+  // Saves the characterization file if needed.
+  if (options_->getOutputPath().length() > 0) {
+    printCharacterization();
+    printSolution();
+  }
+  // super confused -cherry
+  if (openStaChar_ != nullptr) {
+    openStaChar_->clear();
+    delete openStaChar_;
+    openStaChar_ = nullptr;
+  }
+}
+
+void TechChar::runCharacterization()
+{
   long unsigned int topologiesCreated = 0;
   for (unsigned setupWirelength : wirelengthsToTest_) {
     // Creates the topologies for the current wirelength.
@@ -1239,23 +1273,187 @@ void TechChar::create()
     openStaChar_ = nullptr;
   }
   logger_->info(CTS, 39, "Number of created patterns = {}.", topologiesCreated);
-  // Post-processing of the results.
-  std::vector<ResultData> convertedSolutions = characterizationPostProcess();
-  // Changes the segment units back to micron and creates the wire segments.
-  float dbUnitsPerMicron = charBlock_->getDbUnitsPerMicron();
-  float segmentDistance = options_->getWireSegmentUnit();
-  options_->setWireSegmentUnit(segmentDistance / dbUnitsPerMicron);
-  compileLut(convertedSolutions);
-  // Saves the characterization file if needed.
-  if (options_->getOutputPath().length() > 0) {
-    printCharacterization();
-    printSolution();
+}
+
+// Characterization cache
+
+// Size and FNV-1a hash of the file contents, so an edited file does not
+// reuse results characterized with the old one.
+std::string TechChar::fileSignature(const std::string& fileName)
+{
+  std::ifstream in(fileName, std::ios::binary);
+  if (!in.is_open()) {
+    return "unreadable";
   }
-  // super confused -cherry
-  if (openStaChar_ != nullptr) {
-    openStaChar_->clear();
-    delete openStaChar_;
-    openStaChar_ = nullptr;
+
+  uint64_t hash = 14695981039346656037ull;
+  uint64_t size = 0;
+  std::vector<char> buffer(1 << 20);
+  while (in) {
+    in.read(buffer.data(), buffer.size());
+    const std::streamsize count = in.gcount();
+    for (std::streamsize i = 0; i < count; i++) {
+      hash ^= static_cast<unsigned char>(buffer[i]);
+      hash *= 1099511628211ull;
+    }
+    size += count;
+  }
+
+  std::ostringstream signature;
+  signature << size << ":" << std::hex << hash;
+  return signature.str();
+}
+
+std::string TechChar::characterizationCacheFile()
+{
+  const std::string cacheDir = options_->getCharCacheDir();
+  if (cacheDir.empty()) {
+    return "";
+  }
+
+  // The key holds every input of the characterization loop. Liberty files
+  // are represented by their contents. The LEF files are not known to ODB,
+  // so the buffer masters are represented by the geometry that was read.
+  std::ostringstream key;
+  key << std::setprecision(std::numeric_limits<double>::max_digits10);
+  key << "v2 dbu " << db_->getTech()->getDbUnitsPerMicron();
+  for (odb::dbLib* lib : db_->getLibs()) {
+    key << " lef " << lib->getName();
+  }
+  for (const std::string& masterName : options_->getBufferList()) {
+    odb::dbMaster* master = db_->findMaster(masterName.c_str());
+    key << " buf " << masterName << " " << master->getWidth() << " "
+        << master->getHeight();
+    for (odb::dbMTerm* mterm : master->getMTerms()) {
+      key << " " << mterm->getName();
+      for (odb::dbMPin* mpin : mterm->getMPins()) {
+        for (odb::dbBox* box : mpin->getGeometry()) {
+          key << " " << (box->getTechLayer() ? box->getTechLayer()->getName()
+                                             : "via")
+              << " " << box->xMin() << " " << box->yMin() << " "
+              << box->xMax() << " " << box->yMax();
+        }
+      }
+    }
+    sta::LibertyCell* libertyCell
+        = db_network_->libertyCell(db_network_->dbToSta(master));
+    if (libertyCell) {
+      sta::LibertyPort *input, *output;
+      libertyCell->bufferPorts(input, output);
+      const char* libertyFile = libertyCell->libertyLibrary()->filename();
+      key << " " << libertyFile << " " << fileSignature(libertyFile);
+      if (input) {
+        key << " " << input->capacitance();
+      }
+    }
+  }
+  key << " corner " << openSta_->cmdCorner()->name();
+  key << " rc " << resPerDBU_ << " " << capPerDBU_;
+  key << " slew " << charMaxSlew_ << " " << charSlewInter_ << " "
+      << slewsToTest_.size();
+  key << " cap " << charMaxCap_ << " " << charCapInter_ << " "
+      << loadsToTest_.size();
+  key << " wire " << options_->getWireSegmentUnit() << " "
+      << wirelengthsToTest_.size();
+  cacheKey_ = key.str();
+
+  std::ostringstream fileName;
+  fileName << cacheDir << "/cts_char_" << std::hex
+           << std::hash<std::string>{}(cacheKey_) << ".lut";
+  return fileName.str();
+}
+
+bool TechChar::readCharacterizationCache(const std::string& fileName,
+                                         std::vector<ResultData>& lutSols)
+{
+  std::ifstream in(fileName);
+  if (!in.is_open()) {
+    return false;
+  }
+
+  std::string key;
+  std::getline(in, key);
+  if (key != cacheKey_) {
+    logger_->warn(CTS,
+                  105,
+                  "Characterization cache {} does not match the current "
+                  "setup. Ignoring it.",
+                  fileName);
+    return false;
+  }
+
+  std::size_t numResults = 0;
+  in >> minSegmentLength_ >> maxSegmentLength_ >> minCapacitance_
+      >> maxCapacitance_ >> minSlew_ >> maxSlew_ >> numResults;
+  lutSols.clear();
+  lutSols.reserve(numResults);
+  for (std::size_t i = 0; i < numResults && in; ++i) {
+    ResultData result;
+    std::size_t topologySize = 0;
+    in >> result.load >> result.inSlew >> result.wirelength >> result.pinSlew
+        >> result.pinArrival >> result.totalcap >> result.totalPower
+        >> result.isPureWire >> topologySize;
+    result.topology.resize(topologySize);
+    for (std::string& topologyS : result.topology) {
+      in >> topologyS;
+    }
+    lutSols.push_back(result);
+  }
+
+  if (!in || lutSols.size() != numResults) {
+    logger_->warn(CTS,
+                  106,
+                  "Characterization cache {} is truncated. Ignoring it.",
+                  fileName);
+    lutSols.clear();
+    return false;
+  }
+
+  logger_->info(CTS,
+                107,
+                "Read {} characterization results from cache {}.",
+                lutSols.size(),
+                fileName);
+  return true;
+}
+
+void TechChar::writeCharacterizationCache(
+    const std::string& fileName,
+    const std::vector<ResultData>& lutSols) const
+{
+  // Written to a temporary file and renamed so concurrent runs sharing the
+  // cache directory never read a partial file.
+  const std::string tmpFileName = fileName + ".tmp";
+  std::ofstream out(tmpFileName);
+  if (!out.is_open()) {
+    logger_->warn(
+        CTS, 108, "Could not write characterization cache {}.", fileName);
+    return;
+  }
+
+  out << std::setprecision(std::numeric_limits<float>::max_digits10);
+  out << cacheKey_ << "\n";
+  out << minSegmentLength_ << " " << maxSegmentLength_ << " "
+      << minCapacitance_ << " " << maxCapacitance_ << " " << minSlew_ << " "
+      << maxSlew_ << " " << lutSols.size() << "\n";
+  for (const ResultData& result : lutSols) {
+    out << result.load << " " << result.inSlew << " " << result.wirelength
+        << " " << result.pinSlew << " " << result.pinArrival << " "
+        << result.totalcap << " " << result.totalPower << " "
+        << result.isPureWire << " " << result.topology.size();
+    for (const std::string& topologyS : result.topology) {
+      out << " " << topologyS;
+    }
+    out << "\n";
+  }
+  out.close();
+
+  if (!out || std::rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+    std::remove(tmpFileName.c_str());
+    logger_->warn(CTS,
+                  109,
+                  "Could not finish writing characterization cache {}.",
+                  fileName);
   }
 }
 
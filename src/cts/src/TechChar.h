@@ -281,6 +281,13 @@ class TechChar
                                     unsigned setupWirelength);
   SolutionData updateBufferTopologies(SolutionData solution);
   std::vector<ResultData> characterizationPostProcess();
+  void runCharacterization();
+  std::string characterizationCacheFile();
+  static std::string fileSignature(const std::string& fileName);
+  bool readCharacterizationCache(const std::string& fileName,
+                                 std::vector<ResultData>& lutSols);
+  void writeCharacterizationCache(const std::string& fileName,
+                                  const std::vector<ResultData>& lutSols) const;
   unsigned normalizeCharResults(float value,
                                 float iter,
                                 unsigned* min,
@@ -325,6 +332,9 @@ class TechChar
   std::vector<float> slewsToTest_;
 
   std::map<CharKey, std::vector<ResultData>> solutionMap_;
+  // Everything the characterization results depend on. Stored in the cache
+  // file and compared on read so a hash collision can not return a stale LUT.
+  std::string cacheKey_;
 };
 
 }  // namespace cts
@@ -37,6 +37,7 @@
 
 #include <chrono>
 #include <ctime>
+#include <exception>
 #include <fstream>
 #include <iterator>
 #include <unordered_set>
@@ -55,6 +56,8 @@
 #include "sta/Liberty.hh"
 #include "sta/Sdc.hh"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
+#include "utl/Tracer.h"
 
 namespace cts {
 
@@ -88,6 +91,7 @@ TritonCTS::~TritonCTS()
 
 void TritonCTS::runTritonCts()
 {
+  utl::TraceScope trace(CTS, "clock_tree_synthesis");
   setupCharacterization();
   findClockRoots();
   populateTritonCTS();
@@ -156,8 +160,8 @@ void TritonCTS::buildClockTrees()
 {
   for (TreeBuilder* builder : *builders_) {
     builder->setTechChar(*techChar_);
-    builder->run();
   }
+  runBuilders([](TreeBuilder* builder) { builder->run(); });
 
   if (options_->getBalanceLevels()) {
     for (TreeBuilder* builder : *builders_) {
@@ -172,9 +176,53 @@ void TritonCTS::buildClockTrees()
 void TritonCTS::runPostCtsOpt()
 {
   if (options_->runPostCtsOpt()) {
-    for (TreeBuilder* builder : *builders_) {
+    runBuilders([&](TreeBuilder* builder) {
       PostCtsOpt opt(builder, options_, techChar_, logger_);
       opt.run();
+    });
+  }
+}
+
+bool TritonCTS::canRunBuildersConcurrently() const
+{
+  // Fake LUT entries are added to the shared characterization and
+  // plots are numbered by a global count, so those stay serial.
+  return builders_->size() > 1
+         && utl::ThreadPool::get().threadCount() > 1
+         && !options_->isFakeLutEntriesEnabled()
+         && !options_->getPlotSolution()
+         && !logger_->debugCheck(CTS, "HTree", 2);
+}
+
+// The trees of different clock nets only share read-only data until they
+// are written to the db, so they are built concurrently.  The messages
+// of each builder are held back and printed in builder order, which
+// keeps the log the same as a serial run.
+void TritonCTS::runBuilders(const std::function<void(TreeBuilder*)>& func)
+{
+  if (!canRunBuildersConcurrently()) {
+    for (TreeBuilder* builder : *builders_) {
+      func(builder);
+    }
+    return;
+  }
+
+  const int builderCount = builders_->size();
+  std::vector<utl::MessageBuffer> messages(builderCount);
+  std::vector<std::exception_ptr> errors(builderCount);
+  utl::ThreadPool::get().parallelFor(0, builderCount, [&](int i) {
+    messages[i].begin();
+    try {
+      func((*builders_)[i]);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+    messages[i].end();
+  });
+  for (int i = 0; i < builderCount; i++) {
+    messages[i].flush(logger_);
+    if (errors[i]) {
+      std::rethrow_exception(errors[i]);
     }
   }
 }
@@ -101,6 +101,12 @@ set_out_path(const char* path)
   getTritonCts()->getParms()->setOutputPath(path);
 }
 
+void
+set_char_cache_dir(const char* dir)
+{
+  getTritonCts()->getParms()->setCharCacheDir(dir);
+}
+
 void
 set_slew_inter(double slew)
 {
@@ -37,11 +37,12 @@ sta::define_cmd_args "configure_cts_characterization" {[-max_cap cap] \
                                                        [-max_slew slew] \
                                                        [-slew_inter slewvalue] \
                                                        [-cap_inter capvalue] \
+                                                       [-cache_dir dir] \
                                                       }
 
 proc configure_cts_characterization { args } {
   sta::parse_key_args "configure_cts_characterization" args \
-    keys {-max_cap -max_slew -slew_inter -cap_inter} flags {}
+    keys {-max_cap -max_slew -slew_inter -cap_inter -cache_dir} flags {}
 
   sta::check_argc_eq0 "configure_cts_characterization" $args
 
@@ -64,6 +65,14 @@ proc configure_cts_characterization { args } {
     set cap $keys(-cap_inter)
     cts::set_cap_inter $cap
   }
+
+  if { [info exists keys(-cache_dir)] } {
+    set cache_dir $keys(-cache_dir)
+    if { ![file isdirectory $cache_dir] } {
+      file mkdir $cache_dir
+    }
+    cts::set_char_cache_dir $cache_dir
+  }
 }
 
 sta::define_cmd_args "clock_tree_synthesis" {[-wire_unit unit]
@@ -0,0 +1,34 @@
+# balance_levels builds the trees of clk and the gated clk2 concurrently
+# with several threads. The trees and the log must be the ones of a single
+# thread run.
+source "helpers.tcl"
+
+proc run_cts { threads } {
+  set ::env(CTS_THREADS) $threads
+  set ::env(CTS_DEF) [make_result_file balance_levels_threads_$threads.def]
+  set log [exec [info nameofexecutable] -no_init -no_splash -exit \
+             balance_levels_threads_run.tcl 2>@1]
+  # Only the thread count report differs.
+  set lines {}
+  foreach line [split $log "\n"] {
+    if { ![string match "*ORD-0030*" $line] } {
+      lappend lines $line
+    }
+  }
+  return $lines
+}
+
+set log1 [run_cts 1]
+set log4 [run_cts 4]
+
+if { $log1 != $log4 } {
+  puts "fail: cts logs differ between 1 and 4 threads"
+  exit 1
+}
+if { [diff_files [make_result_file balance_levels_threads_1.def] \
+        [make_result_file balance_levels_threads_4.def]] } {
+  puts "fail: clock trees differ between 1 and 4 threads"
+  exit 1
+}
+puts "pass"
+exit 0
@@ -0,0 +1,5 @@
+# balance_levels with $env(CTS_THREADS) threads for
+# balance_levels_threads.tcl.
+set_thread_count $env(CTS_THREADS)
+source balance_levels.tcl
+write_def $env(CTS_DEF)
@@ -0,0 +1,32 @@
+# The characterization cache is written by a first run, read back by a
+# second one and not used once the liberty file changes.
+source "helpers.tcl"
+
+set cache_dir [make_result_file char_cache]
+set lib_file [make_result_file char_cache.lib]
+file delete -force $cache_dir
+file copy -force Nangate45/Nangate45_typ.lib $lib_file
+
+proc run_characterization { } {
+  variable cache_dir
+  set log [exec [info nameofexecutable] -no_init -no_splash -exit \
+             char_cache_run.tcl 2>@1]
+  foreach line [split $log "\n"] {
+    if { [regexp {CTS-0039|CTS-0084|CTS-010[5-9]} $line] } {
+      regsub {cts_char_[0-9a-f]+} $line {cts_char_<key>} line
+      puts $line
+    }
+  }
+  puts "cache files: [llength [glob -nocomplain -directory $cache_dir *.lut]]"
+}
+
+puts "First run"
+run_characterization
+puts "Second run"
+run_characterization
+
+set stream [open $lib_file a]
+puts $stream "/* edited */"
+close $stream
+puts "Edited liberty file"
+run_characterization
@@ -0,0 +1,11 @@
+# Characterization run for char_cache.tcl, executed in its own process.
+read_lef Nangate45/Nangate45.lef
+read_liberty results/char_cache.lib
+read_def no_clock.def
+
+set_wire_rc -clock -layer metal5
+configure_cts_characterization -cache_dir results/char_cache
+catch {clock_tree_synthesis \
+         -root_buf CLKBUF_X3 \
+         -buf_list CLKBUF_X3 \
+         -wire_unit 20}
@@ -0,0 +1,120 @@
+// Times sink clustering on synthetic uniformly placed sinks.
+//
+//   BenchSinkClustering sinks <num_sinks> [group_size] [use_max_cap]
+//     runs SinkClustering (findBestMatching) as TritonCTS does
+//   BenchSinkClustering matching <num_sinks>
+//     runs the two-means Clustering::sortedMatching once
+//
+// Prints the run time, the peak resident memory and, for sink clustering, a
+// hash of the solution so that runs can be compared across changes.
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Clustering.h"
+#include "CtsOptions.h"
+#include "SinkClustering.h"
+#include "TechChar.h"
+#include "utl/Logger.h"
+
+static long peakMemoryMB()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss / 1024;
+}
+
+static void benchSinks(unsigned numSinks, unsigned groupSize, bool useMaxCap)
+{
+  utl::Logger logger;
+  cts::CtsOptions options(&logger, nullptr);
+  options.setSinkClusteringUseMaxCap(useMaxCap);
+  options.setSinkBufferMaxCap(6e-14);
+  cts::TechChar techChar(
+      &options, nullptr, nullptr, nullptr, nullptr, nullptr, &logger);
+  cts::SinkClustering clustering(&options, &techChar);
+
+  std::mt19937 rng(numSinks);
+  std::uniform_real_distribution<double> location(0, 2000000);
+  std::uniform_real_distribution<double> cap(1e-15, 3e-15);
+  for (unsigned i = 0; i < numSinks; i++) {
+    clustering.addPoint(location(rng), location(rng));
+    clustering.addCap(cap(rng));
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  clustering.run(groupSize, 50000, 1);
+  std::chrono::duration<double> elapsed
+      = std::chrono::steady_clock::now() - start;
+
+  unsigned long hash = 14695981039346656037UL;
+  size_t numPoints = 0;
+  auto solution = clustering.sinkClusteringSolution();
+  for (auto& cluster : solution) {
+    hash = (hash ^ (cluster.size() + 7)) * 1099511628211UL;
+    for (unsigned idx : cluster) {
+      hash = (hash ^ idx) * 1099511628211UL;
+      numPoints++;
+    }
+  }
+  printf("sinks=%u clusters=%zu points=%zu hash=%016lx time=%.2fs peak=%ldMB\n",
+         numSinks,
+         solution.size(),
+         numPoints,
+         hash,
+         elapsed.count(),
+         peakMemoryMB());
+}
+
+static void benchMatching(unsigned numSinks)
+{
+  utl::Logger logger;
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> location(0, 100);
+  std::vector<std::pair<float, float>> sinks;
+  for (unsigned i = 0; i < numSinks; i++) {
+    sinks.emplace_back(location(rng), location(rng));
+  }
+  CKMeans::Clustering clustering(sinks, 0, 0, &logger);
+  std::vector<std::pair<float, float>> means = {{25, 50}, {75, 50}};
+
+  auto start = std::chrono::steady_clock::now();
+  clustering.sortedMatching(means, numSinks * 0.6, 0, 5200, 4);
+  std::chrono::duration<double> elapsed
+      = std::chrono::steady_clock::now() - start;
+  printf("sinks=%u time=%.3fs peak=%ldMB\n",
+         numSinks,
+         elapsed.count(),
+         peakMemoryMB());
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 3) {
+    fprintf(stderr,
+            "usage: %s sinks <num_sinks> [group_size] [use_max_cap]\n"
+            "       %s matching <num_sinks>\n",
+            argv[0],
+            argv[0]);
+    return 1;
+  }
+  const unsigned numSinks = atoi(argv[2]);
+  if (strcmp(argv[1], "sinks") == 0) {
+    const unsigned groupSize = argc > 3 ? atoi(argv[3]) : 20;
+    const bool useMaxCap = argc > 4 && atoi(argv[4]) != 0;
+    benchSinks(numSinks, groupSize, useMaxCap);
+  } else if (strcmp(argv[1], "matching") == 0) {
+    benchMatching(numSinks);
+  } else {
+    fprintf(stderr, "unknown benchmark %s\n", argv[1]);
+    return 1;
+  }
+  return 0;
+}
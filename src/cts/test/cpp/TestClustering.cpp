@@ -0,0 +1,113 @@
+#define BOOST_TEST_MODULE TestClustering
+#include <boost/test/included/unit_test.hpp>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Clustering.h"
+#include "utl/Logger.h"
+
+using namespace CKMeans;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+// Arc cost the way minCostFlow and sortedMatching compute it, -1 if the
+// flop cannot go to the mean.
+static long int matchCost(const std::pair<float, float>& mean,
+                          const Flop& flop,
+                          float dist,
+                          unsigned power)
+{
+  float d = std::fabs(mean.first - flop.x) + std::fabs(mean.second - flop.y);
+  if (d <= dist && std::pow(d, power) < std::numeric_limits<int>::max()) {
+    return (int) std::pow(d, power);
+  }
+  return -1;
+}
+
+// Number of flops assigned and their total cost; -1 if a mean is over its
+// capacity or a flop went to a mean it cannot reach.
+static std::pair<long int, long int> evalMatching(
+    const Clustering& clustering,
+    const std::vector<std::pair<float, float>>& means,
+    const long int caps[2],
+    float dist,
+    unsigned power)
+{
+  long int count[2] = {0, 0};
+  long int cost = 0;
+  for (const Flop& flop : clustering.getFlops()) {
+    const int mean = flop.match_idx[0].first;
+    if (mean < 0) {
+      continue;
+    }
+    const long int c = matchCost(means[mean], flop, dist, power);
+    if (c < 0) {
+      return {-1, -1};
+    }
+    count[mean]++;
+    cost += c;
+  }
+  if (count[0] > caps[0] || count[1] > caps[1]) {
+    return {-1, -1};
+  }
+  return {count[0] + count[1], cost};
+}
+
+// sortedMatching must find an assignment as good as the flow based one
+// whenever every flop can be placed, which is when the flow is feasible.
+BOOST_AUTO_TEST_CASE(test_sorted_matching_vs_min_cost_flow)
+{
+  utl::Logger logger;
+  std::mt19937 rng(1);
+  int compared = 0;
+  for (int iter = 0; iter < 2000; iter++) {
+    const int numFlops = 1 + rng() % 40;
+    const unsigned cap = numFlops / 2;
+    const float dist = 5 + rng() % 30;
+    const unsigned power = 1 + rng() % 4;
+    std::vector<std::pair<float, float>> sinks;
+    for (int i = 0; i < numFlops; i++) {
+      sinks.emplace_back(rng() % 20, rng() % 20);
+    }
+    const std::vector<std::pair<float, float>> means
+        = {{float(rng() % 20), float(rng() % 20)},
+           {float(rng() % 20), float(rng() % 20)}};
+    const long int caps[2] = {cap + numFlops % 2, cap};
+
+    Clustering flow(sinks, 0, 0, &logger);
+    Clustering sorted(sinks, 0, 0, &logger);
+
+    long int only[2] = {0, 0};
+    bool feasible = true;
+    for (const Flop& flop : flow.getFlops()) {
+      const bool reach0 = matchCost(means[0], flop, dist, power) >= 0;
+      const bool reach1 = matchCost(means[1], flop, dist, power) >= 0;
+      if (!reach0 && !reach1) {
+        feasible = false;
+      } else if (!reach1) {
+        only[0]++;
+      } else if (!reach0) {
+        only[1]++;
+      }
+    }
+    if (!feasible || only[0] > caps[0] || only[1] > caps[1]) {
+      continue;
+    }
+
+    flow.minCostFlow(means, cap, 0, dist, power);
+    sorted.sortedMatching(means, cap, 0, dist, power);
+    const auto flowResult = evalMatching(flow, means, caps, dist, power);
+    const auto sortedResult = evalMatching(sorted, means, caps, dist, power);
+    BOOST_TEST(flowResult.first == numFlops);
+    BOOST_TEST(sortedResult.first == numFlops);
+    BOOST_TEST(sortedResult.second == flowResult.second);
+    compared++;
+  }
+  BOOST_TEST(compared > 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
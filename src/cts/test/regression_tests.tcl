@@ -11,4 +11,9 @@ record_tests {
   post_cts_opt
   balance_levels
   max_cap
+  char_cache
+}
+
+record_pass_fail_tests {
+  balance_levels_threads
 }
@@ -70,9 +70,13 @@ class dbVerilogNetwork : public ConcreteNetwork
   dbVerilogNetwork();
   virtual Cell* findAnyCell(const char* name);
   void init(dbNetwork* db_network);
+  // True when link_design -release_verilog deleted the linked top instance.
+  bool isReleased() const { return released_; }
+  void setReleased(bool released) { released_ = released; }
 
  private:
   NetworkReader* db_network_;
+  bool released_;
 };
 
 dbVerilogNetwork* makeDbVerilogNetwork();
@@ -87,9 +91,12 @@ void deleteDbVerilogNetwork(dbVerilogNetwork* verilog_network);
 // network.
 void dbReadVerilog(const char* filename, dbVerilogNetwork* verilog_network);
 
+// With release_verilog the linked verilog network is deleted once the
+// OpenDB netlist is built so the netlist is not held twice.
 void dbLinkDesign(const char* top_cell_name,
                   dbVerilogNetwork* verilog_network,
                   dbDatabase* db,
-                  utl::Logger* logger);
+                  utl::Logger* logger,
+                  bool release_verilog);
 
 }  // namespace ord
@@ -58,6 +58,7 @@ namespace sta {
 
 class dbSta;
 class dbNetwork;
+class dbSdcNetwork;
 class dbStaReport;
 class dbStaCbk;
 class PathRenderer;
@@ -95,6 +96,7 @@ public:
 
   dbDatabase *db() { return db_; }
   dbNetwork *getDbNetwork() { return db_network_; }
+  dbSdcNetwork *getDbSdcNetwork() { return db_sdc_network_; }
   dbStaReport *getDbReport() { return db_report_; }
 
   Slack netSlack(const dbNet *net,
@@ -138,6 +140,7 @@ protected:
   Logger *logger_;
 
   dbNetwork *db_network_;
+  dbSdcNetwork *db_sdc_network_;
   dbStaReport *db_report_;
   dbStaCbk *db_cbk_;
   PathRenderer *path_renderer_;
@@ -0,0 +1,217 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sta {
+
+// Sorted index of object names used to answer wildcard lookups
+// without matching the pattern against every name in the block.
+// Names are inserted by the owner when the index is built and then
+// kept current from the db callbacks. Erased entries are left as
+// tombstones and inserted entries are held aside until the next query
+// sorts them in. A name can have a tombstone and a live entry at the
+// same time, so entries are erased by name and object.
+template <class OBJ>
+class dbNameIndex
+{
+public:
+  dbNameIndex() : erased_count_(0), built_(false) {}
+
+  bool isBuilt() const { return built_; }
+  void setBuilt() { built_ = true; }
+  void clear();
+  void insert(const char *name,
+              OBJ *obj);
+  void erase(const char *name,
+             OBJ *obj);
+
+  // Call visitor(obj) for the objects whose name starts with prefix.
+  template <class VISITOR>
+  void visitPrefix(const std::string &prefix,
+                   VISITOR visitor);
+  // Call visitor(obj) for the objects whose name ends with suffix.
+  template <class VISITOR>
+  void visitSuffix(const std::string &suffix,
+                   VISITOR visitor);
+
+private:
+  typedef std::pair<std::string, OBJ*> Entry;
+  typedef std::vector<Entry> EntrySeq;
+
+  void flush();
+  static bool nameLess(const Entry &entry1,
+                       const Entry &entry2)
+  {
+    return entry1.first < entry2.first;
+  }
+  template <class VISITOR>
+  static void visitRange(EntrySeq &entries,
+                         const std::string &prefix,
+                         VISITOR visitor);
+
+  // Sorted by name.
+  EntrySeq entries_;
+  // Inserted since the last query.
+  EntrySeq pending_;
+  size_t erased_count_;
+  // Reversed names, sorted. Made by the first suffix query after an edit.
+  EntrySeq reversed_;
+  bool built_;
+};
+
+template <class OBJ>
+void
+dbNameIndex<OBJ>::clear()
+{
+  entries_.clear();
+  pending_.clear();
+  reversed_.clear();
+  erased_count_ = 0;
+  built_ = false;
+}
+
+template <class OBJ>
+void
+dbNameIndex<OBJ>::insert(const char *name,
+                         OBJ *obj)
+{
+  pending_.emplace_back(name, obj);
+  reversed_.clear();
+}
+
+template <class OBJ>
+void
+dbNameIndex<OBJ>::erase(const char *name,
+                        OBJ *obj)
+{
+  auto pending_iter = std::find_if(pending_.begin(), pending_.end(),
+                                   [=](const Entry &entry) {
+                                     return entry.second == obj
+                                       && entry.first == name;
+                                   });
+  if (pending_iter != pending_.end())
+    pending_.erase(pending_iter);
+  else {
+    auto range = std::equal_range(entries_.begin(), entries_.end(),
+                                  Entry(name, nullptr), nameLess);
+    for (auto iter = range.first; iter != range.second; iter++) {
+      if (iter->second == obj) {
+        iter->second = nullptr;
+        erased_count_++;
+        break;
+      }
+    }
+  }
+  reversed_.clear();
+}
+
+template <class OBJ>
+void
+dbNameIndex<OBJ>::flush()
+{
+  if (!pending_.empty()) {
+    std::sort(pending_.begin(), pending_.end(), nameLess);
+    size_t middle = entries_.size();
+    entries_.insert(entries_.end(),
+                    std::make_move_iterator(pending_.begin()),
+                    std::make_move_iterator(pending_.end()));
+    std::inplace_merge(entries_.begin(), entries_.begin() + middle,
+                       entries_.end(), nameLess);
+    pending_.clear();
+  }
+  if (erased_count_ > entries_.size() / 4) {
+    entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                  [](const Entry &entry) {
+                                    return entry.second == nullptr;
+                                  }),
+                   entries_.end());
+    erased_count_ = 0;
+  }
+}
+
+template <class OBJ>
+template <class VISITOR>
+void
+dbNameIndex<OBJ>::visitRange(EntrySeq &entries,
+                             const std::string &prefix,
+                             VISITOR visitor)
+{
+  auto iter = std::lower_bound(entries.begin(), entries.end(),
+                               Entry(prefix, nullptr), nameLess);
+  for (; iter != entries.end()
+         && iter->first.compare(0, prefix.size(), prefix) == 0;
+       iter++) {
+    if (iter->second)
+      visitor(iter->second);
+  }
+}
+
+template <class OBJ>
+template <class VISITOR>
+void
+dbNameIndex<OBJ>::visitPrefix(const std::string &prefix,
+                              VISITOR visitor)
+{
+  flush();
+  visitRange(entries_, prefix, visitor);
+}
+
+template <class OBJ>
+template <class VISITOR>
+void
+dbNameIndex<OBJ>::visitSuffix(const std::string &suffix,
+                              VISITOR visitor)
+{
+  flush();
+  if (reversed_.empty()) {
+    reversed_.reserve(entries_.size() - erased_count_);
+    for (const Entry &entry : entries_) {
+      if (entry.second)
+        reversed_.emplace_back(std::string(entry.first.rbegin(),
+                                           entry.first.rend()),
+                               entry.second);
+    }
+    std::sort(reversed_.begin(), reversed_.end(), nameLess);
+  }
+  visitRange(reversed_, std::string(suffix.rbegin(), suffix.rend()), visitor);
+}
+
+} // namespace
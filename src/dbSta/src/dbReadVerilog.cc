@@ -37,6 +37,7 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 
 #include "sta/Vector.hh"
 #include "sta/PortDirection.hh"
@@ -99,7 +100,8 @@ using utl::STA;
 
 dbVerilogNetwork::dbVerilogNetwork() :
   ConcreteNetwork(),
-  db_network_(nullptr)
+  db_network_(nullptr),
+  released_(false)
 {
   report_ = nullptr;
   debug_ = nullptr;
@@ -167,6 +169,7 @@ protected:
   void makeDbNets(const Instance *inst);
   bool hasTerminals(Net *net) const;
   dbMaster *getMaster(Cell *cell);
+  dbMTerm *getMTerm(dbMaster *master, const Port *port);
   dbModule *makeUniqueDbModule(const char* name);
   
   Network *network_;
@@ -175,23 +178,35 @@ protected:
   Logger *logger_;
   std::map<Cell*, dbMaster*> master_map_;
   std::map<std::string, int> uniquify_id_; // key: module name
+  // Leaf instances and ports resolved while building the netlist so
+  // connecting pins does not have to look them up by path name.
+  std::unordered_map<const Instance*, dbInst*> inst_map_;
+  std::unordered_map<const Port*, dbMTerm*> mterm_map_;
 };
 
 void
 dbLinkDesign(const char *top_cell_name,
 	     dbVerilogNetwork *verilog_network,
 	     dbDatabase *db,
-             Logger *logger)
+             Logger *logger,
+             bool release_verilog)
 {
   bool link_make_black_boxes = true;
   bool success = verilog_network->linkNetwork(top_cell_name,
 					      link_make_black_boxes,
 					      verilog_network->report());
   if (success) {
-    Verilog2db v2db(verilog_network, db, logger);
-    v2db.makeBlock();
-    v2db.makeDbNetlist();
+    // The linked network holds its own copy of the netlist, so the parsed
+    // verilog modules are released before the db netlist is built.
     deleteVerilogReader();
+    {
+      Verilog2db v2db(verilog_network, db, logger);
+      v2db.makeBlock();
+      v2db.makeDbNetlist();
+    }
+    if (release_verilog)
+      verilog_network->deleteTopInstance();
+    verilog_network->setReleased(release_verilog);
   }
 }
 
@@ -335,6 +350,7 @@ Verilog2db::makeDbModule(Instance* inst, dbModule* parent)
         continue;
       }
       module->addInst(db_inst);
+      inst_map_[child] = db_inst;
     }
   }
   delete child_iter;
@@ -398,13 +414,10 @@ Verilog2db::makeDbNets(const Instance *inst)
 	  }
 	}
 	else if (network_->isLeaf(pin)) {
-	  const char *port_name = network_->portName(pin);
-	  Instance *inst = network_->instance(pin);
-	  const char *inst_name = network_->pathName(inst);
-	  dbInst *db_inst = block_->findInst(inst_name);
-	  if (db_inst) {
-	    dbMaster *master = db_inst->getMaster();
-	    dbMTerm *mterm = master->findMTerm(block_, port_name);
+	  auto inst_iter = inst_map_.find(network_->instance(pin));
+	  if (inst_iter != inst_map_.end()) {
+	    dbInst *db_inst = inst_iter->second;
+	    dbMTerm *mterm = getMTerm(db_inst->getMaster(), network_->port(pin));
 	    if (mterm)
               db_inst->getITerm(mterm)->connect(db_net);
 	  }
@@ -422,6 +435,17 @@ Verilog2db::makeDbNets(const Instance *inst)
   delete child_iter;
 }
 
+dbMTerm *
+Verilog2db::getMTerm(dbMaster *master, const Port *port)
+{
+  auto miter = mterm_map_.find(port);
+  if (miter != mterm_map_.end())
+    return miter->second;
+  dbMTerm *mterm = master->findMTerm(block_, network_->name(port));
+  mterm_map_[port] = mterm;
+  return mterm;
+}
+
 bool
 Verilog2db::hasTerminals(Net *net) const
 {
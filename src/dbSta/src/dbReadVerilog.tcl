@@ -41,11 +41,16 @@ proc read_verilog { filename } {
   ord::read_verilog_cmd [file nativename $filename]
 }
 
-sta::define_cmd_args "link_design" {[top_cell_name]}
+sta::define_cmd_args "link_design" {[-release_verilog] [top_cell_name]}
 
-proc link_design { {top_cell_name ""} } {
+proc link_design { args } {
   variable current_design_name
 
+  sta::parse_key_args "link_design" args keys {} flags {-release_verilog}
+  sta::check_argc_eq0or1 "link_design" $args
+  set top_cell_name [lindex $args 0]
+  set release_verilog [info exists flags(-release_verilog)]
+
   if { $top_cell_name == "" } {
     if { $current_design_name == "" } {
       utl::error ORD 1009 "missing top_cell_name argument and no current_design."
@@ -57,7 +62,7 @@ proc link_design { {top_cell_name ""} } {
   if { ![ord::db_has_tech] } {
     utl::error ORD 1010 "no technology has been read."
   }
-  ord::link_design_db_cmd $top_cell_name
+  ord::link_design_db_cmd $top_cell_name $release_verilog
 }
 
 sta::define_cmd_args "write_verilog" {[-sort] [-include_pwr_gnd]\
@@ -35,20 +35,32 @@
 
 #include "dbSdcNetwork.hh"
 
+#include <algorithm>
+#include <string>
+
+#include "db_sta/dbNetwork.hh"
 #include "sta/PatternMatch.hh"
 #include "sta/ParseBus.hh"
 
 namespace sta {
 
+using std::string;
+
 static const char *
 escapeDividers(const char *token,
 	       const Network *network);
 static const char *
 escapeBrackets(const char *token,
 	       const Network *network);
+static bool
+patternLiterals(const PatternMatch *pattern,
+		// Return values.
+		string &prefix,
+		string &suffix);
 
-dbSdcNetwork::dbSdcNetwork(Network *network) :
-  SdcNetwork(network)
+dbSdcNetwork::dbSdcNetwork(dbNetwork *network) :
+  SdcNetwork(network),
+  db_network_(network)
 {
 }
 
@@ -93,13 +105,34 @@ void
 dbSdcNetwork::findInstancesMatching1(const PatternMatch *pattern,
 				     InstanceSeq *insts) const
 {
-  InstanceChildIterator *child_iter = childIterator(topInstance());
-  while (child_iter->hasNext()) {
-    Instance *child = child_iter->next();
-    if (pattern->match(staToSdc(name(child))))
-      insts->push_back(child);
+  string prefix, suffix;
+  if (patternLiterals(pattern, prefix, suffix)) {
+    ensureInstanceIndex();
+    size_t first = insts->size();
+    auto visitor = [&](Instance *inst) {
+      if (pattern->match(staToSdc(name(inst))))
+	insts->push_back(inst);
+    };
+    if (!prefix.empty())
+      instance_index_.visitPrefix(prefix, visitor);
+    else
+      instance_index_.visitSuffix(suffix, visitor);
+    // Return the matches in block order like the full scan below.
+    std::sort(insts->begin() + first, insts->end(),
+	      [this](const Instance *inst1, const Instance *inst2) {
+		return db_network_->staToDb(inst1)->getId()
+		  < db_network_->staToDb(inst2)->getId();
+	      });
+  }
+  else {
+    InstanceChildIterator *child_iter = childIterator(topInstance());
+    while (child_iter->hasNext()) {
+      Instance *child = child_iter->next();
+      if (pattern->match(staToSdc(name(child))))
+	insts->push_back(child);
+    }
+    delete child_iter;
   }
-  delete child_iter;
 }
 
 void
@@ -130,15 +163,102 @@ void
 dbSdcNetwork::findNetsMatching1(const PatternMatch *pattern,
 				NetSeq *nets) const
 {
-  NetIterator *net_iter = netIterator(topInstance());
-  while (net_iter->hasNext()) {
-    Net *net = net_iter->next();
-    if (pattern->match(staToSdc(name(net))))
-      nets->push_back(net);
+  string prefix, suffix;
+  if (patternLiterals(pattern, prefix, suffix)) {
+    ensureNetIndex();
+    size_t first = nets->size();
+    auto visitor = [&](Net *net) {
+      if (pattern->match(staToSdc(name(net))))
+	nets->push_back(net);
+    };
+    if (!prefix.empty())
+      net_index_.visitPrefix(prefix, visitor);
+    else
+      net_index_.visitSuffix(suffix, visitor);
+    std::sort(nets->begin() + first, nets->end(),
+	      [this](const Net *net1, const Net *net2) {
+		return db_network_->staToDb(net1)->getId()
+		  < db_network_->staToDb(net2)->getId();
+	      });
+  }
+  else {
+    NetIterator *net_iter = netIterator(topInstance());
+    while (net_iter->hasNext()) {
+      Net *net = net_iter->next();
+      if (pattern->match(staToSdc(name(net))))
+	nets->push_back(net);
+    }
+    delete net_iter;
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
+void
+dbSdcNetwork::ensureInstanceIndex() const
+{
+  if (!instance_index_.isBuilt()) {
+    InstanceChildIterator *child_iter = childIterator(topInstance());
+    while (child_iter->hasNext()) {
+      Instance *child = child_iter->next();
+      instance_index_.insert(staToSdc(name(child)), child);
+    }
+    delete child_iter;
+    instance_index_.setBuilt();
   }
-  delete net_iter;
 }
 
+void
+dbSdcNetwork::ensureNetIndex() const
+{
+  if (!net_index_.isBuilt()) {
+    NetIterator *net_iter = netIterator(topInstance());
+    while (net_iter->hasNext()) {
+      Net *net = net_iter->next();
+      net_index_.insert(staToSdc(name(net)), net);
+    }
+    delete net_iter;
+    net_index_.setBuilt();
+  }
+}
+
+void
+dbSdcNetwork::clearNameIndex()
+{
+  instance_index_.clear();
+  net_index_.clear();
+}
+
+void
+dbSdcNetwork::instanceCreated(Instance *inst)
+{
+  if (instance_index_.isBuilt())
+    instance_index_.insert(staToSdc(name(inst)), inst);
+}
+
+void
+dbSdcNetwork::instanceDeleted(Instance *inst)
+{
+  if (instance_index_.isBuilt())
+    instance_index_.erase(staToSdc(name(inst)), inst);
+}
+
+void
+dbSdcNetwork::netCreated(Net *net)
+{
+  if (net_index_.isBuilt())
+    net_index_.insert(staToSdc(name(net)), net);
+}
+
+void
+dbSdcNetwork::netDeleted(Net *net)
+{
+  if (net_index_.isBuilt())
+    net_index_.erase(staToSdc(name(net)), net);
+}
+
+////////////////////////////////////////////////////////////////
+
 void
 dbSdcNetwork::findPinsMatching(const Instance *instance,
 			       const PatternMatch *pattern,
@@ -251,4 +371,24 @@ escapeBrackets(const char *token,
   return escapeChars(token, '[', ']', network->pathEscape());
 }
 
+// Find the literal text before the first and after the last wildcard of
+// a glob pattern. Returns false if the pattern cannot use a name index.
+static bool
+patternLiterals(const PatternMatch *pattern,
+		// Return values.
+		string &prefix,
+		string &suffix)
+{
+  if (pattern->isRegexp() || pattern->nocase())
+    return false;
+  const string pattern_str = pattern->pattern();
+  size_t first_wild = pattern_str.find_first_of("*?");
+  if (first_wild == string::npos)
+    return false;
+  size_t last_wild = pattern_str.find_last_of("*?");
+  prefix = pattern_str.substr(0, first_wild);
+  suffix = pattern_str.substr(last_wild + 1);
+  return !prefix.empty() || !suffix.empty();
+}
+
 } // namespace
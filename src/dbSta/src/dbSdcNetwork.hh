@@ -37,13 +37,16 @@
 #define DB_SDC_NETWORK_H
 
 #include "sta/SdcNetwork.hh"
+#include "dbNameIndex.hh"
 
 namespace sta {
 
+class dbNetwork;
+
 class dbSdcNetwork : public SdcNetwork
 {
 public:
-  dbSdcNetwork(Network *network);
+  dbSdcNetwork(dbNetwork *network);
   virtual Instance *findInstance(const char *path_name) const;
   virtual void findInstancesMatching(const Instance *contex,
 				     const PatternMatch *pattern,
@@ -55,6 +58,16 @@ public:
 				const PatternMatch *pattern,
 				PinSeq *pins) const;
 
+  // Wildcard lookups with a literal prefix or suffix use name indices
+  // that are built on first use. dbStaCbk reports instance and net
+  // edits to keep them current. A rename is a delete under the old name
+  // followed by a create under the new one.
+  void clearNameIndex();
+  void instanceCreated(Instance *inst);
+  void instanceDeleted(Instance *inst);
+  void netCreated(Net *net);
+  void netDeleted(Net *net);
+
 protected:
   void findInstancesMatching1(const PatternMatch *pattern,
 			      InstanceSeq *insts) const;
@@ -64,6 +77,12 @@ protected:
 			const PatternMatch *port_pattern,
 			PinSeq *pins) const;
   Pin *findPin(const char *path_name) const;
+  void ensureInstanceIndex() const;
+  void ensureNetIndex() const;
+
+  dbNetwork *db_network_;
+  mutable dbNameIndex<Instance> instance_index_;
+  mutable dbNameIndex<Net> net_index_;
 
   using SdcNetwork::findPin;
 };
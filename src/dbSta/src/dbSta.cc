@@ -167,11 +167,20 @@ public:
            Logger *logger);
   void setNetwork(dbNetwork *network);
   virtual void inDbInstCreate(dbInst *inst) override;
+  virtual void inDbInstCreate(dbInst *inst,
+                              odb::dbRegion *region) override;
   virtual void inDbInstDestroy(dbInst *inst) override;
   virtual void inDbInstSwapMasterBefore(dbInst *inst,
                                         dbMaster *master) override;
   virtual void inDbInstSwapMasterAfter(dbInst *inst) override;
+  virtual void inDbInstRenameBefore(dbInst *inst,
+                                    const char *new_name) override;
+  virtual void inDbInstRenameAfter(dbInst *inst) override;
+  virtual void inDbNetCreate(dbNet *net) override;
   virtual void inDbNetDestroy(dbNet *net) override;
+  virtual void inDbNetRenameBefore(dbNet *net,
+                                   const char *new_name) override;
+  virtual void inDbNetRenameAfter(dbNet *net) override;
   virtual void inDbITermPostConnect(dbITerm *iterm) override;
   virtual void inDbITermPreDisconnect(dbITerm *iterm) override;
   virtual void inDbITermDestroy(dbITerm *iterm) override;
@@ -292,7 +301,8 @@ dbSta::makeNetwork()
 void
 dbSta::makeSdcNetwork()
 {
-  sdc_network_ = new dbSdcNetwork(network_);
+  db_sdc_network_ = new dbSdcNetwork(db_network_);
+  sdc_network_ = db_sdc_network_;
 }
 
 void
@@ -308,6 +318,7 @@ void
 dbSta::postReadDef(dbBlock* block)
 {
   db_network_->readDefAfter(block);
+  db_sdc_network_->clearNameIndex();
   db_cbk_->addOwner(block);
   db_cbk_->setNetwork(db_network_);
 }
@@ -316,6 +327,7 @@ void
 dbSta::postReadDb(dbDatabase* db)
 {
   db_network_->readDbAfter(db);
+  db_sdc_network_->clearNameIndex();
   odb::dbChip *chip = db_->getChip();
   if (chip) {
     odb::dbBlock *block = chip->getBlock();
@@ -612,15 +624,28 @@ dbStaCbk::setNetwork(dbNetwork *network)
 void
 dbStaCbk::inDbInstCreate(dbInst* inst)
 {
-  sta_->makeInstanceAfter(network_->dbToSta(inst));
+  Instance *sta_inst = network_->dbToSta(inst);
+  sta_->makeInstanceAfter(sta_inst);
+  sta_->getDbSdcNetwork()->instanceCreated(sta_inst);
+}
+
+// Only keeps the name index current. Sta has never been notified of
+// instances created in a region.
+void
+dbStaCbk::inDbInstCreate(dbInst* inst,
+                         odb::dbRegion *)
+{
+  sta_->getDbSdcNetwork()->instanceCreated(network_->dbToSta(inst));
 }
 
 void
 dbStaCbk::inDbInstDestroy(dbInst *inst)
 {
+  Instance *sta_inst = network_->dbToSta(inst);
   // This is called after the iterms have been destroyed
   // so it side-steps Sta::deleteInstanceAfter.
-  sta_->deleteLeafInstanceBefore(network_->dbToSta(inst));
+  sta_->deleteLeafInstanceBefore(sta_inst);
+  sta_->getDbSdcNetwork()->instanceDeleted(sta_inst);
 }
 
 void
@@ -644,12 +669,45 @@ dbStaCbk::inDbInstSwapMasterAfter(dbInst *inst)
   sta_->replaceEquivCellAfter(network_->dbToSta(inst));
 }
 
+void
+dbStaCbk::inDbInstRenameBefore(dbInst *inst,
+                               const char *)
+{
+  sta_->getDbSdcNetwork()->instanceDeleted(network_->dbToSta(inst));
+}
+
+void
+dbStaCbk::inDbInstRenameAfter(dbInst *inst)
+{
+  sta_->getDbSdcNetwork()->instanceCreated(network_->dbToSta(inst));
+}
+
+void
+dbStaCbk::inDbNetCreate(dbNet *db_net)
+{
+  sta_->getDbSdcNetwork()->netCreated(network_->dbToSta(db_net));
+}
+
 void
 dbStaCbk::inDbNetDestroy(dbNet *db_net)
 {
   Net *net = network_->dbToSta(db_net);
   sta_->deleteNetBefore(net);
   network_->deleteNetBefore(net);
+  sta_->getDbSdcNetwork()->netDeleted(net);
+}
+
+void
+dbStaCbk::inDbNetRenameBefore(dbNet *db_net,
+                              const char *)
+{
+  sta_->getDbSdcNetwork()->netDeleted(network_->dbToSta(db_net));
+}
+
+void
+dbStaCbk::inDbNetRenameAfter(dbNet *db_net)
+{
+  sta_->getDbSdcNetwork()->netCreated(network_->dbToSta(db_net));
 }
 
 void
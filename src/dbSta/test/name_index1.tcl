@@ -0,0 +1,44 @@
+# wildcard lookups through the name index after instance and net edits
+source "helpers.tcl"
+read_liberty Nangate45/Nangate45_typ.lib
+read_lef Nangate45/Nangate45.lef
+read_def reg3.def
+
+proc report_names { objects } {
+  set names {}
+  foreach object $objects {
+    lappend names [get_full_name $object]
+  }
+  puts [lsort $names]
+}
+
+# builds the indices
+report_names [get_cells r*]
+report_names [get_nets *q]
+
+# delete, create again under the same name, query, then delete again
+make_instance r4 BUF_X1
+report_names [get_cells r*]
+delete_instance r4
+make_instance r4 BUF_X1
+report_names [get_cells r*]
+report_names [get_cells -quiet *4]
+delete_instance r4
+report_names [get_cells r*]
+report_names [get_cells -quiet *4]
+
+make_net n1q
+delete_net n1q
+make_net n1q
+report_names [get_nets *q]
+delete_net n1q
+report_names [get_nets *q]
+
+# renames
+set block [ord::get_db_block]
+[$block findInst r3] rename x3
+report_names [get_cells r*]
+report_names [get_cells x*]
+[$block findNet r2q] rename x2q
+report_names [get_nets r*]
+report_names [get_nets *2q]
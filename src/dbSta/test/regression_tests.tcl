@@ -4,6 +4,7 @@ record_tests {
   sdc_names1
   sdc_names2
   sdc_get1
+  name_index1
   sta1
   sta2
   sta3
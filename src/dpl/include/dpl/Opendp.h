@@ -80,11 +80,9 @@ using odb::dbSite;
 using odb::Point;
 using odb::Rect;
 
-struct Pixel;
 struct Group;
 class Graphics;
 
-using Grid = Pixel *;
 using dbMasterSeq = vector<dbMaster *>;
 // gap -> sequence of masters to fill the gap
 using GapFillers = vector<dbMasterSeq>;
@@ -132,13 +130,62 @@ struct Group
   double util;
 };
 
-struct Pixel
+// Site attributes that only change while the grid is initialized.
+struct SiteRun
 {
-  Cell *cell;
+  int x_begin;
   Group *group_;
-  double util;
   bool is_valid;  // false for dummy cells
-  bool is_hopeless; // too far from sites for diamond search
+};
+
+// Sites [x_begin, x_end) of a row occupied by a cell.
+struct CellSpan
+{
+  int x_end;
+  Cell *cell;
+};
+
+// Occupancy of one row of sites. Site attributes are run-length encoded
+// and cells are kept as sorted spans, so memory is proportional to the
+// number of cells and fragments instead of the number of sites.
+class GridRow
+{
+public:
+  void init(int site_count);
+  int siteCount() const { return site_count_; }
+  const SiteRun &run(int x) const;
+  const vector<SiteRun> &runs() const { return runs_; }
+  // End of the run containing x.
+  int runEnd(int x) const;
+  void setRun(int x_begin, int x_end, Group *group, bool is_valid);
+  // Largest valid site < x, or -1.
+  int validBefore(int x) const;
+  // Smallest valid site >= x, or siteCount().
+  int validFrom(int x) const;
+  // End of the valid sites starting at x.
+  int validEnd(int x) const;
+
+  Cell *cell(int x) const;
+  const map<int, CellSpan> &cells() const { return cells_; }
+  // First cell span that ends after x.
+  map<int, CellSpan>::const_iterator findCell(int x) const;
+  bool hasCell(int x_begin, int x_end) const;
+  // Start of the first cell span at or after x, or siteCount().
+  int nextCell(int x) const;
+  // Replace the cells of sites [x_begin, x_end). nullptr erases them.
+  void setCell(int x_begin, int x_end, Cell *cell);
+
+  // Sites close enough to a row to start a diamond search from.
+  vector<pair<int, int>> reachable;
+
+private:
+  vector<SiteRun>::const_iterator findRun(int x) const;
+  void splitRun(int x);
+  void splitCell(int x);
+
+  int site_count_;
+  vector<SiteRun> runs_;  // sorted by x_begin, covering the row
+  map<int, CellSpan> cells_;  // x_begin -> span
 };
 
 // For optimize mirroring.
@@ -157,12 +204,12 @@ typedef vector<NetBox> NetBoxes;
 ////////////////////////////////////////////////////////////////
 
 // Return value for grid searches.
-class PixelPt
+class GridPt
 {
 public:
-  PixelPt();
-  PixelPt(Pixel *pixel, int grid_x, int grid_y);
-  Pixel *pixel;
+  GridPt();
+  GridPt(int grid_x, int grid_y);
+  bool found;
   Point pt; // grid locataion
 };
 
@@ -251,10 +298,16 @@ private:
   bool checkOverlap(const Cell *cell, const Rect *rect) const;
   static bool isInside(const Rect &cell, const Rect &box);
   bool isInside(const Cell *cell, const Rect *rect) const;
-  PixelPt diamondSearch(const Cell *cell,
+  GridPt diamondSearch(const Cell *cell,
                         // grid indices
                         int x,
                         int y) const;
+  GridPt diamondSearch(const Cell *cell,
+                       // grid indices
+                       int x,
+                       int y,
+                       int row_begin,
+                       int row_end) const;
   void diamondSearchSide(const Cell *cell,
                          int x,
                          int y,
@@ -265,17 +318,22 @@ private:
                          int x_offset,
                          int y_offset,
                          // Return values
-                         PixelPt &best_pt,
+                         GridPt &best_pt,
                          int &best_dist) const;
-  PixelPt binSearch(int x,
+  GridPt binSearch(int x,
                     const Cell *cell,
                     int bin_x,
                     int bin_y) const;
-  bool checkPixels(const Cell *cell,
+  bool checkSites(const Cell *cell,
                    int x,
                    int y,
                    int x_end,
                    int y_end) const;
+  int rowBandCount() const;
+  int rowBandBegin(int band,
+                   int band_count) const;
+  void placeRowBands(const vector<Cell *> &cells,
+                     int band_count);
   void shiftMove(Cell *cell);
   bool mapMove(Cell *cell);
   bool mapMove(Cell *cell,
@@ -312,22 +370,30 @@ private:
   int refine();
   bool cellFitsInCore(Cell *cell);
   void setFixedGridCells();
-  void visitCellPixels(Cell &cell,
-                       bool padded,
-                       const std::function <void (Pixel *pixel)>& visitor) const;
+  // Visit the grid rectangles [x_begin, x_end) x [y_begin, y_end)
+  // covered by a cell, clipped to the grid.
+  void visitCellSites(Cell &cell,
+                      bool padded,
+                      const std::function<void(int x_begin,
+                                               int x_end,
+                                               int y_begin,
+                                               int y_end)> &visitor) const;
   void setGridCell(Cell &cell,
-                   Pixel *pixel);
+                   int x_begin,
+                   int x_end,
+                   int y_begin,
+                   int y_end);
   void groupAssignCellRegions();
-  void groupInitPixels();
-  void groupInitPixels2();
-  void erasePixel(Cell *cell);
-  void paintPixel(Cell *cell, int grid_x, int grid_y);
+  void groupInitSites();
+  void groupInitSites2();
+  void eraseSites(Cell *cell);
+  void paintSites(Cell *cell, int grid_x, int grid_y);
 
   // checkPlacement
   static bool isPlaced(const Cell *cell);
   bool checkPowerLine(const Cell &cell) const;
   bool checkInRows(const Cell &cell) const;
-  Cell *checkOverlap(Cell &cell) const;
+  Cell *checkOverlap(Cell &cell);
   bool overlap(const Cell *cell1, const Cell *cell2) const;
   bool isOverlapPadded(const Cell *cell1, const Cell *cell2) const;
   bool isCrWtBlClass(const Cell *cell) const;
@@ -341,7 +407,7 @@ private:
                       const char *msg,
                       bool verbose,
                       const std::function<void(Cell *cell)> &report_failure) const;
-  void reportOverlapFailure(Cell *cell) const;
+  void reportOverlapFailure(Cell *cell);
 
   void rectDist(const Cell *cell,
                 const Rect *rect,
@@ -354,8 +420,12 @@ private:
   bool havePadding() const;
 
   void deleteGrid();
-  Pixel *gridPixel(int x,
-                   int y) const;
+  bool inGrid(int x, int y) const;
+  // Valid and inside the grid.
+  bool gridIsValid(int x, int y) const;
+  Cell *gridCell(int x, int y) const;
+  // Too far from sites for diamond search.
+  bool gridIsHopeless(int x, int y) const;
   // Cell initial location wrt core origin.
   int gridX(int x) const;
   int gridY(int y) const;
@@ -439,8 +509,8 @@ private:
   int max_displacement_y_;           // sites
   vector<dbInst*> placement_failures_;
 
-  // 2D pixel grid
-  Grid *grid_;
+  // Site occupancy, indexed by grid row.
+  vector<GridRow> grid_;
   Cell dummy_cell_;
 
   // Filler placement.
@@ -127,7 +127,7 @@ Opendp::reportFailures(const vector<Cell *> &failures,
 }
 
 void
-Opendp::reportOverlapFailure(Cell *cell) const
+Opendp::reportOverlapFailure(Cell *cell)
 {
   const Cell *overlap = checkOverlap(*cell);
   logger_->report(" {} overlaps {}", cell->name(), overlap->name());
@@ -165,10 +165,8 @@ Opendp::checkInRows(const Cell &cell) const
   int y_ll = gridY(&cell);
   int y_ur = gridEndY(&cell);
   for (int y = y_ll; y < y_ur; y++) {
-    for (int x = x_ll; x < x_ur; x++) {
-      Pixel *pixel = gridPixel(x, y);
-      if (pixel == nullptr  // outside core
-          || !pixel->is_valid)
+    for (int x = x_ll; x < x_ur; x = grid_[y].runEnd(x)) {
+      if (!gridIsValid(x, y))  // outside core or rows
         return false;
     }
   }
@@ -196,19 +194,41 @@ Opendp::checkInRows(const Cell &cell) const
 
 // Return the cell this cell overlaps.
 Cell *
-Opendp::checkOverlap(Cell &cell) const
+Opendp::checkOverlap(Cell &cell)
 {
   Cell *overlap_cell = nullptr;
-  visitCellPixels(cell, true,
-                  [&] (Pixel *pixel) {
-                    Cell *pixel_cell = pixel->cell;
-                    if (pixel_cell) {
-                      if (pixel_cell != &cell && overlap(&cell, pixel_cell))
-                        overlap_cell = pixel_cell;
-                    }
-                    else
-                      pixel->cell = &cell;
-                  } );
+  visitCellSites(cell, true,
+                 [&] (int x_begin, int x_end, int y_begin, int y_end) {
+                   // Report the overlapping site with the largest x, then y.
+                   int overlap_x = -1;
+                   for (int y = y_begin; y < y_end; y++) {
+                     GridRow &grid_row = grid_[y];
+                     for (auto span = grid_row.findCell(x_begin);
+                          span != grid_row.cells().end()
+                            && span->first < x_end;
+                          span++) {
+                       Cell *site_cell = span->second.cell;
+                       int x_last = min(x_end, span->second.x_end) - 1;
+                       if (site_cell != &cell && x_last >= overlap_x
+                           && overlap(&cell, site_cell)) {
+                         overlap_cell = site_cell;
+                         overlap_x = x_last;
+                       }
+                     }
+                     // Fill the empty sites.
+                     int x = x_begin;
+                     while (x < x_end) {
+                       int empty_end = min(x_end, grid_row.nextCell(x));
+                       if (x < empty_end) {
+                         grid_row.setCell(x, empty_end, &cell);
+                         x = empty_end;
+                       }
+                       else {
+                         x = grid_row.findCell(x)->second.x_end;
+                       }
+                     }
+                   }
+                 } );
   return overlap_cell;
 }
 
@@ -77,8 +77,10 @@ void
 Opendp::setGridCells()
 {
   for (Cell &cell : cells_)
-    visitCellPixels(cell, false,
-                    [&] (Pixel *pixel) { setGridCell(cell, pixel); } );
+    visitCellSites(cell, false,
+                   [&] (int x_begin, int x_end, int y_begin, int y_end) {
+                     setGridCell(cell, x_begin, x_end, y_begin, y_end);
+                   } );
 }
 
 void
@@ -87,17 +89,12 @@ Opendp::placeRowFillers(int row,
                         dbMasterSeq *filler_masters)
 {
   dbOrientType orient = rowOrient(row);
-  int j = 0;
+  const GridRow &grid_row = grid_[row];
+  int j = grid_row.validFrom(0);
   while (j < row_site_count_) {
-    Pixel *pixel = gridPixel(j, row);
-    if (pixel->cell == nullptr
-        && pixel->is_valid) {
-      int k = j;
-      while (k < row_site_count_
-             && gridPixel(k, row)->cell == nullptr
-             && gridPixel(k, row)->is_valid) {
-        k++;
-      }
+    const int cell_x = grid_row.nextCell(j);
+    if (cell_x > j) {
+      int k = min(cell_x, grid_row.validEnd(j));
       int gap = k - j;
       // printf("filling row %d gap %d %d:%d\n", row, gap, j, k - 1);
       dbMasterSeq &fillers = gapFillers(gap, filler_masters);
@@ -130,8 +127,9 @@ Opendp::placeRowFillers(int row,
       }
     }
     else {
-      j++;
+      j = grid_row.findCell(j)->second.x_end;
     }
+    j = grid_row.validFrom(j);
   }
 }
 
@@ -144,7 +142,7 @@ Opendp::gridInstName(int row,
   else if (col > row_site_count_)
     return "core_right";
   else {
-    const Cell *cell = gridPixel(col, row)->cell;
+    const Cell *cell = gridCell(col, row);
     if (cell)
       return cell->db_inst_->getConstName();
   }
@@ -39,6 +39,7 @@
 
 #include "dpl/Opendp.h"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
@@ -56,28 +57,183 @@ using odb::dbBox;
 using odb::dbTransform;
 
 void
-Opendp::initGrid()
+GridRow::init(int site_count)
+{
+  site_count_ = site_count;
+  runs_.assign(1, {0, nullptr, false});
+  cells_.clear();
+  reachable.clear();
+}
+
+vector<SiteRun>::const_iterator
+GridRow::findRun(int x) const
+{
+  auto run = std::upper_bound(
+      runs_.begin(), runs_.end(), x, [](int x, const SiteRun &run) {
+        return x < run.x_begin;
+      });
+  return run - 1;
+}
+
+const SiteRun &
+GridRow::run(int x) const
+{
+  return *findRun(x);
+}
+
+int
+GridRow::runEnd(int x) const
+{
+  auto run = findRun(x) + 1;
+  return run == runs_.end() ? site_count_ : run->x_begin;
+}
+
+// Make x the start of a run.
+void
+GridRow::splitRun(int x)
 {
-  // Make pixel grid
-  if (grid_ == nullptr) {
-    grid_ = new Pixel *[row_count_];
-    for (int y = 0; y < row_count_; y++)
-      grid_[y] = new Pixel[row_site_count_];
+  if (x < site_count_) {
+    auto run = findRun(x);
+    if (run->x_begin != x) {
+      SiteRun split = *run;
+      split.x_begin = x;
+      runs_.insert(run + 1, split);
+    }
   }
+}
 
-  // Init pixels.
-  for (int y = 0; y < row_count_; y++) {
-    for (int x = 0; x < row_site_count_; x++) {
-      Pixel &pixel = grid_[y][x];
-      pixel.cell = nullptr;
-      pixel.group_ = nullptr;
-      pixel.util = 0.0;
-      pixel.is_valid = false;
-      pixel.is_hopeless = true;
+void
+GridRow::setRun(int x_begin, int x_end, Group *group, bool is_valid)
+{
+  x_begin = std::max(x_begin, 0);
+  x_end = std::min(x_end, site_count_);
+  if (x_begin >= x_end)
+    return;
+  splitRun(x_begin);
+  splitRun(x_end);
+  auto first = runs_.begin() + (findRun(x_begin) - runs_.begin());
+  auto last = x_end < site_count_
+                  ? runs_.begin() + (findRun(x_end) - runs_.begin())
+                  : runs_.end();
+  *first = {x_begin, group, is_valid};
+  runs_.erase(first + 1, last);
+  // Merge with equal neighbors.
+  auto same = [](const SiteRun &run1, const SiteRun &run2) {
+    return run1.group_ == run2.group_ && run1.is_valid == run2.is_valid;
+  };
+  const size_t index = first - runs_.begin();
+  if (index + 1 < runs_.size() && same(runs_[index], runs_[index + 1]))
+    runs_.erase(runs_.begin() + index + 1);
+  if (index > 0 && same(runs_[index - 1], runs_[index]))
+    runs_.erase(runs_.begin() + index);
+}
+
+int
+GridRow::validBefore(int x) const
+{
+  if (x <= 0)
+    return -1;
+  for (auto run = findRun(x - 1);; run--) {
+    if (run->is_valid)
+      return std::min(x - 1, runEnd(run->x_begin) - 1);
+    if (run == runs_.begin())
+      return -1;
+  }
+}
+
+int
+GridRow::validFrom(int x) const
+{
+  if (x >= site_count_)
+    return site_count_;
+  for (auto run = findRun(x); run != runs_.end(); run++) {
+    if (run->is_valid)
+      return std::max(x, run->x_begin);
+  }
+  return site_count_;
+}
+
+int
+GridRow::validEnd(int x) const
+{
+  auto run = findRun(x);
+  while (run != runs_.end() && run->is_valid)
+    run++;
+  return run == runs_.end() ? site_count_ : run->x_begin;
+}
+
+map<int, CellSpan>::const_iterator
+GridRow::findCell(int x) const
+{
+  auto span = cells_.upper_bound(x);
+  if (span != cells_.begin() && x < std::prev(span)->second.x_end)
+    span--;
+  return span;
+}
+
+Cell *
+GridRow::cell(int x) const
+{
+  auto span = findCell(x);
+  if (span != cells_.end() && span->first <= x)
+    return span->second.cell;
+  return nullptr;
+}
+
+bool
+GridRow::hasCell(int x_begin, int x_end) const
+{
+  return nextCell(x_begin) < x_end;
+}
+
+int
+GridRow::nextCell(int x) const
+{
+  auto span = findCell(x);
+  if (span == cells_.end())
+    return site_count_;
+  return std::max(x, span->first);
+}
+
+// Make x the start of a span if a span covers it.
+void
+GridRow::splitCell(int x)
+{
+  auto span = cells_.upper_bound(x);
+  if (span != cells_.begin()) {
+    span--;
+    if (span->first < x && x < span->second.x_end) {
+      cells_[x] = {span->second.x_end, span->second.cell};
+      span->second.x_end = x;
     }
   }
+}
+
+void
+GridRow::setCell(int x_begin, int x_end, Cell *cell)
+{
+  if (x_begin >= x_end)
+    return;
+  splitCell(x_begin);
+  splitCell(x_end);
+  cells_.erase(cells_.lower_bound(x_begin), cells_.lower_bound(x_end));
+  if (cell)
+    cells_[x_begin] = {x_end, cell};
+}
+
+////////////////////////////////////////////////////////////////
+
+void
+Opendp::initGrid()
+{
+  grid_.resize(row_count_);
+  for (GridRow &grid_row : grid_)
+    grid_row.init(row_site_count_);
 
   // Fragmented row support; mark valid sites.
+  // reach_begin/end[y] are the rows whose search reach starts/ends at y.
+  vector<vector<pair<int, int>>> reach_begin(row_count_ + 1);
+  vector<vector<pair<int, int>>> reach_end(row_count_ + 1);
   for (auto db_row : block_->getRows()) {
     int orig_x, orig_y;
     db_row->getOrigin(orig_x, orig_y);
@@ -86,9 +242,7 @@ Opendp::initGrid()
     const int x_end = x_start + db_row->getSiteCount();
     const int y_row = (orig_y - core_.yMin()) / row_height_;
 
-    for (int x = x_start; x < x_end; x++) {
-      grid_[y_row][x].is_valid = true;
-    }
+    grid_[y_row].setRun(x_start, x_end, nullptr, true);
 
     // The safety margin is to avoid having only a very few sites
     // within the diamond search that may still lead to failures.
@@ -98,10 +252,28 @@ Opendp::initGrid()
                             x_end + max_displacement_x_ - safety);
     const int yl = std::max(0, y_row - max_displacement_y_ + safety);
     const int yh = std::min(row_count_, y_row + max_displacement_y_ - safety);
-    for (int y = yl; y < yh; y++) {
-      for (int x = xl; x < xh; x++) {
-        grid_[y][x].is_hopeless = false;
-      }
+    if (xl < xh && yl < yh) {
+      reach_begin[yl].emplace_back(xl, xh);
+      reach_end[yh].emplace_back(xl, xh);
+    }
+  }
+
+  // Sweep the rows keeping the x ranges that reach each row.
+  map<pair<int, int>, int> active;
+  for (int y = 0; y < row_count_; y++) {
+    for (auto &range : reach_end[y]) {
+      auto it = active.find(range);
+      if (--it->second == 0)
+        active.erase(it);
+    }
+    for (auto &range : reach_begin[y])
+      active[range]++;
+    vector<pair<int, int>> &reachable = grid_[y].reachable;
+    for (auto &[range, count] : active) {
+      if (!reachable.empty() && range.first <= reachable.back().second)
+        reachable.back().second = max(reachable.back().second, range.second);
+      else
+        reachable.push_back(range);
     }
   }
 }
@@ -109,33 +281,66 @@ Opendp::initGrid()
 void
 Opendp::deleteGrid()
 {
-  if (grid_) {
-    for (int i = 0; i < row_count_; i++) {
-      delete [] grid_[i];
-    }
-    delete [] grid_;
-  }
-  grid_ = nullptr;
+  grid_.clear();
+}
+
+bool
+Opendp::inGrid(int grid_x,
+               int grid_y) const
+{
+  return grid_x >= 0 && grid_x < row_site_count_
+    && grid_y >= 0 && grid_y < row_count_;
+}
+
+bool
+Opendp::gridIsValid(int grid_x,
+                    int grid_y) const
+{
+  return inGrid(grid_x, grid_y) && grid_[grid_y].run(grid_x).is_valid;
+}
+
+Cell *
+Opendp::gridCell(int grid_x,
+                 int grid_y) const
+{
+  if (inGrid(grid_x, grid_y))
+    return grid_[grid_y].cell(grid_x);
+  return nullptr;
 }
 
-Pixel *
-Opendp::gridPixel(int grid_x,
-                  int grid_y) const
+bool
+Opendp::gridIsHopeless(int grid_x,
+                       int grid_y) const
 {
-  if (grid_x >= 0 && grid_x < row_site_count_
-      && grid_y >= 0 && grid_y < row_count_)
-    return &grid_[grid_y][grid_x];
-  else
-    return nullptr;
+  if (!inGrid(grid_x, grid_y))
+    return false;
+  const vector<pair<int, int>> &reachable = grid_[grid_y].reachable;
+  auto range = std::upper_bound(
+      reachable.begin(),
+      reachable.end(),
+      grid_x,
+      [](int x, const pair<int, int> &range) { return x < range.first; });
+  return range == reachable.begin() || grid_x >= std::prev(range)->second;
 }
 
 ////////////////////////////////////////////////////////////////
 
 void
-Opendp::visitCellPixels(Cell &cell,
-                        bool padded,
-                        const std::function <void (Pixel *pixel)>& visitor) const
+Opendp::visitCellSites(Cell &cell,
+                       bool padded,
+                       const std::function<void(int x_begin,
+                                                int x_end,
+                                                int y_begin,
+                                                int y_end)> &visitor) const
 {
+  auto visit = [&](int x_start, int x_end, int y_start, int y_end) {
+    x_start = max(x_start, 0);
+    x_end = min(x_end, row_site_count_);
+    y_start = max(y_start, 0);
+    y_end = min(y_end, row_count_);
+    if (x_start < x_end && y_start < y_end)
+      visitor(x_start, x_end, y_start, y_end);
+  };
   dbInst *inst = cell.db_inst_;
   dbMaster *master = inst->getMaster();
   auto obstructions = master->getObstructions();
@@ -149,31 +354,17 @@ Opendp::visitCellPixels(Cell &cell,
       dbTransform transform;
       inst->getTransform(transform);
       transform.apply(rect);
-      int x_start = gridX(rect.xMin() - core_.xMin());
-      int x_end = gridEndX(rect.xMax() - core_.xMin());
-      int y_start = gridY(rect.yMin() - core_.yMin());
-      int y_end = gridEndY(rect.yMax() - core_.yMin());
-      for (int x = x_start; x < x_end; x++) {
-        for (int y = y_start; y < y_end; y++) {
-          Pixel *pixel = gridPixel(x, y);
-          if (pixel)
-            visitor(pixel);
-        }
-      }
+      visit(gridX(rect.xMin() - core_.xMin()),
+            gridEndX(rect.xMax() - core_.xMin()),
+            gridY(rect.yMin() - core_.yMin()),
+            gridEndY(rect.yMax() - core_.yMin()));
     }
   }
   if (!have_obstructions) {
-    int x_start = padded ? gridPaddedX(&cell) : gridX(&cell);
-    int x_end = padded ? gridPaddedEndX(&cell) : gridEndX(&cell);
-    int y_start = gridY(&cell);
-    int y_end = gridEndY(&cell);
-    for (int x = x_start; x < x_end; x++) {
-      for (int y = y_start; y < y_end; y++) {
-        Pixel *pixel = gridPixel(x, y);
-        if (pixel)
-          visitor(pixel);
-      }
-    }
+    visit(padded ? gridPaddedX(&cell) : gridX(&cell),
+          padded ? gridPaddedEndX(&cell) : gridEndX(&cell),
+          gridY(&cell),
+          gridEndY(&cell));
   }
 }
 
@@ -182,17 +373,23 @@ Opendp::setFixedGridCells()
 {
   for (Cell &cell : cells_) {
     if (isFixed(&cell))
-      visitCellPixels(cell, true,
-                      [&] (Pixel *pixel) { setGridCell(cell, pixel); } );
+      visitCellSites(cell,
+                     true,
+                     [&](int x_begin, int x_end, int y_begin, int y_end) {
+                       setGridCell(cell, x_begin, x_end, y_begin, y_end);
+                     });
   }
 }
 
 void
 Opendp::setGridCell(Cell &cell,
-                    Pixel *pixel)
+                    int x_begin,
+                    int x_end,
+                    int y_begin,
+                    int y_end)
 {
-  pixel->cell = &cell;
-  pixel->util = 1.0;
+  for (int y = y_begin; y < y_end; y++)
+    grid_[y].setCell(x_begin, x_end, &cell);
 }
 
 void
@@ -200,11 +397,10 @@ Opendp::groupAssignCellRegions()
 {
   for (Group &group : groups_) {
     int64_t site_count = 0;
-    for (int x = 0; x < row_site_count_; x++) {
-      for (int y = 0; y < row_count_; y++) {
-        Pixel *pixel = gridPixel(x, y);
-        if (pixel->is_valid && pixel->group_ == &group) {
-          site_count++;
+    for (const GridRow &grid_row : grid_) {
+      for (const SiteRun &run : grid_row.runs()) {
+        if (run.is_valid && run.group_ == &group) {
+          site_count += grid_row.runEnd(run.x_begin) - run.x_begin;
         }
       }
     }
@@ -227,25 +423,37 @@ Opendp::groupAssignCellRegions()
   }
 }
 
+// Sites partially covered by a group region are blocked with the dummy cell.
 void
-Opendp::groupInitPixels2()
-{
-  for (int x = 0; x < row_site_count_; x++) {
-    for (int y = 0; y < row_count_; y++) {
-      Rect sub;
-      sub.init(x * site_width_,
-               y * row_height_,
-               (x + 1) * site_width_,
-               (y + 1) * row_height_);
-      Pixel *pixel = gridPixel(x, y);
-      for (Group &group : groups_) {
-        for (Rect &rect : group.regions) {
-          if (!isInside(sub, rect) && checkOverlap(sub, rect)) {
-            pixel->util = 0.0;
-            pixel->cell = &dummy_cell_;
-            pixel->is_valid = false;
+Opendp::groupInitSites2()
+{
+  for (Group &group : groups_) {
+    for (Rect &rect : group.regions) {
+      // Sites overlapping the rect.
+      const int x_begin = max(0, divFloor(rect.xMin(), site_width_));
+      const int x_end = min(row_site_count_, divCeil(rect.xMax(), site_width_));
+      const int y_begin = max(0, divFloor(rect.yMin(), row_height_));
+      const int y_end = min(row_count_, divCeil(rect.yMax(), row_height_));
+      for (int y = y_begin; y < y_end; y++) {
+        GridRow &grid_row = grid_[y];
+        auto block = [&](int x_begin, int x_end) {
+          grid_row.setCell(x_begin, x_end, &dummy_cell_);
+          grid_row.setRun(x_begin, x_end, grid_row.run(x_begin).group_, false);
+        };
+        if (y * row_height_ < rect.yMin()
+            || (y + 1) * row_height_ > rect.yMax()) {
+          for (int x = x_begin; x < x_end;) {
+            const int run_end = min(x_end, grid_row.runEnd(x));
+            block(x, run_end);
+            x = run_end;
           }
         }
+        else if (x_begin < x_end) {
+          if (x_begin * site_width_ < rect.xMin())
+            block(x_begin, x_begin + 1);
+          if (x_end * site_width_ > rect.xMax())
+            block(x_end - 1, x_end);
+        }
       }
     }
   }
@@ -267,79 +475,109 @@ Opendp::checkOverlap(const Rect &cell, const Rect &box)
   return box.xMin() < cell.xMax() && box.xMax() > cell.xMin() && box.yMin() < cell.yMax() && box.yMax() > cell.yMin();
 }
 
+// Assign the sites inside group regions to the group. The site
+// utilization is only needed here so it is kept one row at a time.
 void
-Opendp::groupInitPixels()
+Opendp::groupInitSites()
 {
-  for (int x = 0; x < row_site_count_; x++) {
-    for (int y = 0; y < row_count_; y++) {
-      Pixel *pixel = gridPixel(x, y);
-      pixel->util = 0.0;
-    }
-  }
-
+  struct RegionSites
+  {
+    Group *group;
+    int row_start, row_end, col_start, col_end;
+    int x_min, x_max;
+  };
+  vector<RegionSites> region_sites;
+  vector<vector<int>> row_regions(row_count_);
   for (Group &group : groups_) {
     for (Rect &rect : group.regions) {
-      int row_start = divCeil(rect.yMin(), row_height_);
-      int row_end = divFloor(rect.yMax(), row_height_);
-
-      for (int k = row_start; k < row_end; k++) {
-        int col_start = divCeil(rect.xMin(), site_width_);
-        int col_end = divFloor(rect.xMax(), site_width_);
+      RegionSites sites{&group,
+                        max(0, divCeil(rect.yMin(), row_height_)),
+                        min(row_count_, divFloor(rect.yMax(), row_height_)),
+                        max(0, divCeil(rect.xMin(), site_width_)),
+                        min(row_site_count_, divFloor(rect.xMax(), site_width_)),
+                        rect.xMin(),
+                        rect.xMax()};
+      for (int k = sites.row_start; k < sites.row_end; k++)
+        row_regions[k].push_back(region_sites.size());
+      region_sites.push_back(sites);
+    }
+  }
 
+  vector<double> util(row_site_count_, 0.0);
+  for (int k = 0; k < row_count_; k++) {
+    GridRow &grid_row = grid_[k];
+    const vector<int> &regions = row_regions[k];
+    for (int r : regions) {
+      // The edge adjustments below can touch one site past the columns.
+      const RegionSites &sites = region_sites[r];
+      const int zero_begin = max(0, min(sites.col_start, sites.col_end - 1));
+      const int zero_end
+          = min(row_site_count_, max(sites.col_end, sites.col_start + 1));
+      if (zero_begin < zero_end)
+        std::fill(util.begin() + zero_begin, util.begin() + zero_end, 0.0);
+    }
+    // Regions are in group order.
+    for (size_t i = 0; i < regions.size();) {
+      Group *group = region_sites[regions[i]].group;
+      size_t group_end = i;
+      while (group_end < regions.size()
+             && region_sites[regions[group_end]].group == group)
+        group_end++;
+
+      for (size_t j = i; j < group_end; j++) {
+        const RegionSites &sites = region_sites[regions[j]];
+        const int col_start = sites.col_start;
+        const int col_end = sites.col_end;
         for (int l = col_start; l < col_end; l++) {
-          Pixel *pixel = gridPixel(l, k);
-          pixel->util += 1.0;
+          util[l] += 1.0;
         }
-        if (rect.xMin() % site_width_ != 0) {
-          Pixel *pixel = gridPixel(col_start, k);
-          pixel->util -= (rect.xMin() % site_width_) / static_cast<double>(site_width_);
+        if (sites.x_min % site_width_ != 0 && col_start < row_site_count_) {
+          util[col_start] -= (sites.x_min % site_width_)
+            / static_cast<double>(site_width_);
         }
-        if (rect.xMax() % site_width_ != 0) {
-          Pixel *pixel = gridPixel(col_end - 1, k);
-          pixel->util -= ((site_width_ - rect.xMax()) % site_width_)
+        if (sites.x_max % site_width_ != 0 && col_end > 0) {
+          util[col_end - 1] -= ((site_width_ - sites.x_max) % site_width_)
             / static_cast<double>(site_width_);
         }
       }
-    }
-    for (Rect &rect : group.regions) {
-      int row_start = divCeil(rect.yMin(), row_height_);
-      int row_end = divFloor(rect.yMax(), row_height_);
-
-      for (int k = row_start; k < row_end; k++) {
-        int col_start = divCeil(rect.xMin(), site_width_);
-        int col_end = divFloor(rect.xMax(), site_width_);
 
-        // Assign group to each pixel.
-        for (int l = col_start; l < col_end; l++) {
-          Pixel *pixel = gridPixel(l, k);
-          if (pixel->util == 1.0) {
-            pixel->group_ = &group;
-            pixel->is_valid = true;
-            pixel->util = 1.0;
+      for (size_t j = i; j < group_end; j++) {
+        const RegionSites &sites = region_sites[regions[j]];
+        // Assign group to each site.
+        for (int l = sites.col_start; l < sites.col_end;) {
+          int l_end = l + 1;
+          if (util[l] == 1.0) {
+            while (l_end < sites.col_end && util[l_end] == 1.0)
+              l_end++;
+            grid_row.setRun(l, l_end, group, true);
           }
-          else if (pixel->util > 0.0 && pixel->util < 1.0) {
-            pixel->cell = &dummy_cell_;
-            pixel->util = 0.0;
-            pixel->is_valid = false;
+          else if (util[l] > 0.0 && util[l] < 1.0) {
+            while (l_end < sites.col_end && util[l_end] > 0.0
+                   && util[l_end] < 1.0)
+              l_end++;
+            grid_row.setCell(l, l_end, &dummy_cell_);
+            for (int x = l; x < l_end; x++) {
+              util[x] = 0.0;
+              grid_row.setRun(x, x + 1, grid_row.run(x).group_, false);
+            }
           }
+          l = l_end;
         }
       }
+      i = group_end;
     }
   }
 }
 
 void
-Opendp::erasePixel(Cell *cell)
+Opendp::eraseSites(Cell *cell)
 {
   if (!(isFixed(cell) || !cell->is_placed_)) {
-    int x_end = gridPaddedEndX(cell);
-    int y_end = gridEndY(cell);
-    for (int x = gridPaddedX(cell); x < x_end; x++) {
-      for (int y = gridY(cell); y < y_end; y++) {
-        Pixel *pixel = gridPixel(x, y);
-        pixel->cell = nullptr;
-        pixel->util = 0;
-      }
+    int x_begin = max(0, gridPaddedX(cell));
+    int x_end = min(row_site_count_, gridPaddedEndX(cell));
+    int y_end = min(row_count_, gridEndY(cell));
+    for (int y = max(0, gridY(cell)); y < y_end; y++) {
+      grid_[y].setCell(x_begin, x_end, nullptr);
     }
     cell->is_placed_ = false;
     cell->hold_ = false;
@@ -347,7 +585,7 @@ Opendp::erasePixel(Cell *cell)
 }
 
 void
-Opendp::paintPixel(Cell *cell, int grid_x, int grid_y)
+Opendp::paintSites(Cell *cell, int grid_x, int grid_y)
 {
   assert(!cell->is_placed_);
   int x_end = grid_x + gridPaddedWidth(cell);
@@ -360,17 +598,12 @@ Opendp::paintPixel(Cell *cell, int grid_x, int grid_y)
   debugPrint(logger_, DPL, "place", 1, " paint {} ({}-{}, {}-{})",
              cell->name(), grid_x, x_end - 1, grid_y, y_end - 1);
 
-  for (int x = grid_x; x < x_end; x++) {
-    for (int y = grid_y; y < y_end; y++) {
-      Pixel *pixel = gridPixel(x, y);
-      if (pixel->cell) {
-        logger_->error(DPL, 13, "Cannot paint grid because it is already occupied.");
-      }
-      else {
-        pixel->cell = cell;
-        pixel->util = 1.0;
-      }
+  for (int y = grid_y; y < y_end; y++) {
+    GridRow &grid_row = grid_[y];
+    if (grid_row.hasCell(grid_x, x_end)) {
+      logger_->error(DPL, 13, "Cannot paint grid because it is already occupied.");
     }
+    grid_row.setCell(grid_x, x_end, cell);
   }
   // This is most likely broken. -cherry
   if (have_multi_row_cells_) {
@@ -388,4 +621,27 @@ Opendp::paintPixel(Cell *cell, int grid_x, int grid_y)
   }
 }
 
+void
+Opendp::reportGrid()
+{
+  for (int y = 0; y < row_count_; y++) {
+    const GridRow &grid_row = grid_[y];
+    string sites;
+    for (const SiteRun &run : grid_row.runs()) {
+      sites += fmt::format(" {}-{}{}{}",
+                           run.x_begin,
+                           grid_row.runEnd(run.x_begin) - 1,
+                           run.is_valid ? "" : " invalid",
+                           run.group_ ? " " + run.group_->name : "");
+    }
+    logger_->report("row {} sites{}", y, sites);
+    for (auto &[x_begin, span] : grid_row.cells()) {
+      logger_->report("  {}-{} {}",
+                      x_begin,
+                      span.x_end - 1,
+                      span.cell == &dummy_cell_ ? "dummy" : span.cell->name());
+    }
+  }
+}
+
 }  // namespace opendp
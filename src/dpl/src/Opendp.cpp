@@ -46,6 +46,7 @@
 
 #include "Graphics.h"
 #include "utl/Logger.h"
+#include "utl/Tracer.h"
 
 namespace dpl {
 
@@ -127,8 +128,7 @@ Opendp::Opendp() :
   pad_left_(0),
   pad_right_(0),
   max_displacement_x_(0),
-  max_displacement_y_(0),
-  grid_(nullptr)
+  max_displacement_y_(0)
 {
   dummy_cell_.is_placed_ = true;
 }
@@ -201,6 +201,7 @@ void
 Opendp::detailedPlacement(int max_displacement_x,
                           int max_displacement_y)
 {
+  utl::TraceScope trace(DPL, "detailed_placement");
   importDb();
 
   if (max_displacement_x == 0 || max_displacement_y == 0) {
@@ -46,6 +46,7 @@
 
 #include "Graphics.h"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 
 //#define ODP_DEBUG
 
@@ -76,9 +77,9 @@ Opendp::detailedPlacement()
   // Paint fixed cells.
   setFixedGridCells();
   // group mapping & x_axis dummycell insertion
-  groupInitPixels2();
+  groupInitSites2();
   // y axis dummycell insertion
-  groupInitPixels();
+  groupInitSites();
 
   if (!groups_.empty()) {
     placeGroups();
@@ -299,9 +300,20 @@ Opendp::place()
       }
     }
   }
+  vector<Cell *> single_row_cells;
+  single_row_cells.reserve(sorted_cells.size());
   for (Cell *cell : sorted_cells) {
     if (!isMultiRow(cell)
         && cellFitsInCore(cell)) {
+      single_row_cells.push_back(cell);
+    }
+  }
+  const int band_count = rowBandCount();
+  if (band_count > 1) {
+    placeRowBands(single_row_cells, band_count);
+  }
+  else {
+    for (Cell *cell : single_row_cells) {
       if (!mapMove(cell)) {
         shiftMove(cell);
       }
@@ -311,6 +323,110 @@ Opendp::place()
   // anneal();
 }
 
+// Number of row bands single-row cells are legalized in concurrently.
+int
+Opendp::rowBandCount() const
+{
+  // Graphics callbacks are not thread safe.
+  if (graphics_) {
+    return 1;
+  }
+  // magic number alert
+  const int min_band_rows = 10;
+  const int threads = utl::ThreadPool::get().threadCount();
+  return max(1, min(threads, row_count_ / min_band_rows));
+}
+
+int
+Opendp::rowBandBegin(int band,
+                     int band_count) const
+{
+  return divCeil(band * row_count_, band_count);
+}
+
+// Legalize cells in bands of rows concurrently, with the same result as
+// placing them one at a time in sorted order.
+//
+// Each round takes the next window of cells and places them band by band,
+// in sorted order within a band. The diamond search gives up on a cell as
+// soon as it would look at rows outside of its band, so the bands never
+// touch each other's rows. As long as every cell is found a site this way,
+// each one sees the rows of its band just as the serial order leaves them.
+// The first cell that fails in any band ends the round. The cells after it
+// are erased again, it is placed by the serial mapMove/shiftMove, and the
+// next round starts after it.
+void
+Opendp::placeRowBands(const vector<Cell *> &cells,
+                      int band_count)
+{
+  struct Speculative
+  {
+    Cell *cell;
+    Point grid_pt;
+    int x, y;
+    dbOrientType orient;
+  };
+  // magic number alert
+  const size_t window = band_count * 64;
+  size_t placed_in_bands = 0;
+  size_t next = 0;
+  while (next < cells.size()) {
+    const size_t end = min(cells.size(), next + window);
+    vector<Speculative> spec;
+    vector<vector<size_t>> band_cells(band_count);
+    for (size_t i = next; i < end; i++) {
+      Cell *cell = cells[i];
+      // legalGridPt looks at neighboring rows so it is evaluated up front.
+      Point grid_pt = legalGridPt(cell, true);
+      int band = grid_pt.getY() * band_count / row_count_;
+      band_cells[band].push_back(spec.size());
+      spec.push_back({cell, grid_pt, cell->x_, cell->y_, cell->orient_});
+    }
+
+    // Window index of the first cell each band could not place.
+    vector<size_t> band_fail(band_count, spec.size());
+    utl::ThreadPool::get().parallelFor(0, band_count, [&](int band) {
+      const int row_begin = rowBandBegin(band, band_count);
+      const int row_end = rowBandBegin(band + 1, band_count);
+      for (size_t i : band_cells[band]) {
+        const Speculative &s = spec[i];
+        GridPt pt = diamondSearch(s.cell, s.grid_pt.getX(), s.grid_pt.getY(),
+                                  row_begin, row_end);
+        if (!pt.found) {
+          band_fail[band] = i;
+          break;
+        }
+        paintSites(s.cell, pt.pt.getX(), pt.pt.getY());
+      }
+    });
+
+    const size_t fail = *std::min_element(band_fail.begin(), band_fail.end());
+    for (size_t i = fail + 1; i < spec.size(); i++) {
+      Speculative &s = spec[i];
+      if (s.cell->is_placed_) {
+        eraseSites(s.cell);
+        s.cell->x_ = s.x;
+        s.cell->y_ = s.y;
+        s.cell->orient_ = s.orient;
+      }
+    }
+    placed_in_bands += fail;
+    if (fail < spec.size()) {
+      Cell *cell = spec[fail].cell;
+      if (!mapMove(cell)) {
+        shiftMove(cell);
+      }
+      next += fail + 1;
+    }
+    else {
+      next = end;
+    }
+  }
+  debugPrint(logger_, DPL, "place", 1,
+             "Placed {} of {} instances in {} row bands.",
+             placed_in_bands, cells.size(), band_count);
+}
+
 bool
 Opendp::cellFitsInCore(Cell *cell)
 {
@@ -372,7 +488,7 @@ Opendp::placeGroups2()
     if (!single_pass || !multi_pass) {
       // Erase group cells
       for (Cell *cell : group.cells_) {
-        erasePixel(cell);
+        eraseSites(cell);
       }
 
       // Determine brick placement by utilization.
@@ -571,9 +687,9 @@ Opendp::mapMove(Cell *cell,
 {
   int grid_x = grid_pt.getX();
   int grid_y = grid_pt.getY();
-  PixelPt pixel_pt = diamondSearch(cell, grid_x, grid_y);
-  if (pixel_pt.pixel) {
-    paintPixel(cell, pixel_pt.pt.getX(), pixel_pt.pt.getY());
+  GridPt grid_pt1 = diamondSearch(cell, grid_x, grid_y);
+  if (grid_pt1.found) {
+    paintSites(cell, grid_pt1.pt.getX(), grid_pt1.pt.getY());
     if (graphics_) {
       graphics_->placeInstance(cell->db_inst_);
     }
@@ -592,21 +708,24 @@ Opendp::shiftMove(Cell *cell)
   int boundary_margin = 3;
   int margin_width = gridPaddedWidth(cell) * boundary_margin;
   set<Cell *> region_cells;
-  for (int x = grid_x - margin_width; x < grid_x + margin_width; x++) {
-    for (int y = grid_y - boundary_margin; y < grid_y + boundary_margin; y++) {
-      Pixel *pixel = gridPixel(x, y);
-      if (pixel) {
-        Cell *cell = pixel->cell;
-        if (cell && !isFixed(cell))
-          region_cells.insert(cell);
-      }
+  const int x_begin = max(0, grid_x - margin_width);
+  const int x_end = min(row_site_count_, grid_x + margin_width);
+  const int y_end = min(row_count_, grid_y + boundary_margin);
+  for (int y = max(0, grid_y - boundary_margin); y < y_end; y++) {
+    const GridRow &grid_row = grid_[y];
+    for (auto span = grid_row.findCell(x_begin);
+         span != grid_row.cells().end() && span->first < x_end;
+         span++) {
+      Cell *cell = span->second.cell;
+      if (!isFixed(cell))
+        region_cells.insert(cell);
     }
   }
 
   // erase region cells
   for (Cell *around_cell : region_cells) {
     if (cell->inGroup() == around_cell->inGroup()) {
-      erasePixel(around_cell);
+      eraseSites(around_cell);
     }
   }
 
@@ -641,10 +760,10 @@ Opendp::swapCells(Cell *cell1, Cell *cell2)
       int grid_x2 = gridPaddedX(cell1);
       int grid_y2 = gridY(cell1);
 
-      erasePixel(cell1);
-      erasePixel(cell2);
-      paintPixel(cell1, grid_x1, grid_y1);
-      paintPixel(cell2, grid_x2, grid_y2);
+      eraseSites(cell1);
+      eraseSites(cell2);
+      paintSites(cell1, grid_x1, grid_y1);
+      paintSites(cell2, grid_x2, grid_y2);
       return true;
     }
   }
@@ -657,19 +776,19 @@ Opendp::refineMove(Cell *cell)
   Point grid_pt = legalGridPt(cell, true);
   int grid_x = grid_pt.getX();
   int grid_y = grid_pt.getY();
-  PixelPt pixel_pt = diamondSearch(cell, grid_x, grid_y);
-  if (pixel_pt.pixel) {
-    if (abs(grid_x - pixel_pt.pt.getX()) > max_displacement_x_
-        || abs(grid_y - pixel_pt.pt.getY()) > max_displacement_y_)
+  GridPt grid_pt1 = diamondSearch(cell, grid_x, grid_y);
+  if (grid_pt1.found) {
+    if (abs(grid_x - grid_pt1.pt.getX()) > max_displacement_x_
+        || abs(grid_y - grid_pt1.pt.getY()) > max_displacement_y_)
       return false;
 
     int dist_change = distChange(cell,
-                                 pixel_pt.pt.getX() * site_width_,
-                                 pixel_pt.pt.getY() * row_height_);
+                                 grid_pt1.pt.getX() * site_width_,
+                                 grid_pt1.pt.getY() * row_height_);
 
     if (dist_change < 0) {
-      erasePixel(cell);
-      paintPixel(cell, pixel_pt.pt.getX(), pixel_pt.pt.getY());
+      eraseSites(cell);
+      paintSites(cell, grid_pt1.pt.getX(), grid_pt1.pt.getY());
       return true;
     }
   }
@@ -689,11 +808,24 @@ Opendp::distChange(const Cell *cell, int x, int y) const
 
 ////////////////////////////////////////////////////////////////
 
-PixelPt
+GridPt
 Opendp::diamondSearch(const Cell *cell,
                       // grid
                       int x,
                       int y) const
+{
+  return diamondSearch(cell, x, y, 0, row_count_);
+}
+
+// Only rows [row_begin, row_end) are searched. The search fails rather
+// than find a worse location if it would reach outside of them.
+GridPt
+Opendp::diamondSearch(const Cell *cell,
+                      // grid
+                      int x,
+                      int y,
+                      int row_begin,
+                      int row_end) const
 {
   // Diamond search limits.
   int x_min = x - max_displacement_x_;
@@ -731,12 +863,17 @@ Opendp::diamondSearch(const Cell *cell,
              y_min, y_max - 1);
 
   // Check the bin at the initial position first.
-  PixelPt avail_pt = binSearch(x, cell, x, y);
-  if (avail_pt.pixel)
+  GridPt avail_pt = binSearch(x, cell, x, y);
+  if (avail_pt.found)
     return avail_pt;
 
   for (int i = 1; i < std::max(max_displacement_y_, max_displacement_x_); i++) {
-    PixelPt best_pt;
+    const int reach = min(i, max_displacement_y_ - 1);
+    if (max(y_min, y - reach) < row_begin
+        || min(y_max - 1, y + reach) >= row_end) {
+      return GridPt();
+    }
+    GridPt best_pt;
     int best_dist = 0;
     // left side
     for (int j = 1; j < i * 2; j++) {
@@ -763,10 +900,10 @@ Opendp::diamondSearch(const Cell *cell,
                           best_pt, best_dist);
       }
     }
-    if (best_pt.pixel)
+    if (best_pt.found)
       return best_pt;
   }
-  return PixelPt();
+  return GridPt();
 }
 
 void
@@ -780,16 +917,16 @@ Opendp::diamondSearchSide(const Cell *cell,
                           int x_offset,
                           int y_offset,
                           // Return values
-                          PixelPt &best_pt,
+                          GridPt &best_pt,
                           int &best_dist) const
 {
   int bin_x = min(x_max, max(x_min, x + x_offset * bin_search_width_));
   int bin_y = min(y_max, max(y_min, y + y_offset));
-  PixelPt avail_pt = binSearch(x, cell, bin_x, bin_y);
-  if (avail_pt.pixel) {
+  GridPt avail_pt = binSearch(x, cell, bin_x, bin_y);
+  if (avail_pt.found) {
     int avail_dist = abs(x - avail_pt.pt.getX()) * site_width_
       + abs(y - avail_pt.pt.getY()) * row_height_;
-    if (best_pt.pixel == nullptr
+    if (!best_pt.found
         || avail_dist < best_dist) {
       best_pt = avail_pt;
       best_dist = avail_dist;
@@ -797,7 +934,7 @@ Opendp::diamondSearchSide(const Cell *cell,
   }
 }
 
-PixelPt
+GridPt
 Opendp::binSearch(int x,
                   const Cell *cell,
                   int bin_x,
@@ -823,43 +960,44 @@ Opendp::binSearch(int x,
   if (y_end > row_count_
       // Check top power for even row multi-deck cell.
       || (height % 2 == 0 && rowTopPower(bin_y) == topPower(cell))) {
-    return PixelPt();
+    return GridPt();
   }
 
   if (x > bin_x) {
     for (int i = bin_search_width_ - 1; i >= 0; i--) {
-      if (checkPixels(cell, bin_x + i, bin_y, x_end + i, y_end))
-        return PixelPt(gridPixel(bin_x + i, bin_y), bin_x + i, bin_y);
+      if (checkSites(cell, bin_x + i, bin_y, x_end + i, y_end))
+        return GridPt(bin_x + i, bin_y);
     }
   }
   else {
     for (int i = 0; i < bin_search_width_; i++) {
-      if (checkPixels(cell, bin_x + i, bin_y, x_end + i, y_end))
-        return PixelPt(gridPixel(bin_x + i, bin_y), bin_x + i, bin_y);
+      if (checkSites(cell, bin_x + i, bin_y, x_end + i, y_end))
+        return GridPt(bin_x + i, bin_y);
     }
   }
-  return PixelPt();
+  return GridPt();
 }
 
-// Check all pixels are empty.
+// Check all sites are empty.
 bool
-Opendp::checkPixels(const Cell *cell,
-                    int x,
-                    int y,
-                    int x_end,
-                    int y_end) const
+Opendp::checkSites(const Cell *cell,
+                   int x,
+                   int y,
+                   int x_end,
+                   int y_end) const
 {
   if (x_end > row_site_count_)
     return false;
-  else {
+  else if (x < x_end) {
+    if (x < 0 || (y < y_end && (y < 0 || y_end > row_count_)))
+      return false;
     for (int y1 = y; y1 < y_end; y1++) {
-      for (int x1 = x; x1 < x_end; x1++) {
-        Pixel *pixel = gridPixel(x1, y1);
-        if (pixel == nullptr
-            || pixel->cell
-            || !pixel->is_valid
-            || (cell->inGroup() && pixel->group_ != cell->group_)
-            || (!cell->inGroup() && pixel->group_)) {
+      const GridRow &grid_row = grid_[y1];
+      if (grid_row.hasCell(x, x_end))
+        return false;
+      for (int x1 = x; x1 < x_end; x1 = grid_row.runEnd(x1)) {
+        const SiteRun &run = grid_row.run(x1);
+        if (!run.is_valid || run.group_ != cell->group_) {
           return false;
         }
       }
@@ -947,28 +1085,24 @@ Opendp::moveHopeless(int& grid_x, int& grid_y) const
   int best_x = grid_x;
   int best_y = grid_y;
   int best_dist = std::numeric_limits<int>::max();
-  for (int x = grid_x - 1; x >= 0; --x) { // left
-    int dist = (grid_x - x) * site_width_;
-    if (grid_[grid_y][x].is_valid) {
+  const GridRow &grid_row = grid_[grid_y];
+  const int left = grid_row.validBefore(grid_x);
+  if (left >= 0) { // left
+    best_dist = (grid_x - left) * site_width_;
+    best_x = left;
+    best_y = grid_y;
+  }
+  const int right = grid_row.validFrom(grid_x + 1);
+  if (right < row_site_count_) { // right
+    int dist = (right - grid_x) * site_width_;
+    if (dist < best_dist) {
       best_dist = dist;
-      best_x = x;
+      best_x = right;
       best_y = grid_y;
-      break;
-    }
-  }
-  for (int x = grid_x + 1; x < row_site_count_; ++x) { // right
-    if (grid_[grid_y][x].is_valid) {
-      int dist = (x - grid_x) * site_width_;
-      if (dist < best_dist) {
-        best_dist = dist;
-        best_x = x;
-        best_y = grid_y;
-      }
-      break;
     }
   }
   for (int y = grid_y - 1; y >= 0; --y) { // below
-    if (grid_[y][grid_x].is_valid) {
+    if (grid_[y].run(grid_x).is_valid) {
       int dist = (grid_y - y) * row_height_;
       if (dist < best_dist) {
         best_dist = dist;
@@ -979,7 +1113,7 @@ Opendp::moveHopeless(int& grid_x, int& grid_y) const
     }
   }
   for (int y = grid_y + 1; y < row_count_; ++y) { // above
-    if (grid_[y][grid_x].is_valid) {
+    if (grid_[y].run(grid_x).is_valid) {
       int dist = (y - grid_y) * row_height_;
       if (dist < best_dist) {
         best_dist = dist;
@@ -1012,9 +1146,8 @@ Opendp::legalPt(const Cell *cell,
   int grid_x = gridX(legal_pt.getX());
   int grid_y = gridY(legal_pt.getY());
 
-  Pixel *pixel = gridPixel(grid_x, grid_y);
-  if (pixel) {
-    const Cell *block = pixel->cell;
+  if (inGrid(grid_x, grid_y)) {
+    const Cell *block = gridCell(grid_x, grid_y);
     // Move std cells off of macros.
     if (block && isBlock(block)) {
       const Rect block_bbox(block->x_,
@@ -1031,11 +1164,10 @@ Opendp::legalPt(const Cell *cell,
 
         grid_x = gridX(legal_pt.getX());
         grid_y = gridY(legal_pt.getY());
-        pixel = gridPixel(grid_x, grid_y);
       }
     }
 
-    if (pixel->is_hopeless) {
+    if (gridIsHopeless(grid_x, grid_y)) {
       moveHopeless(grid_x, grid_y);
       legal_pt = Point(grid_x * site_width_, grid_y * row_height_);
     }
@@ -1054,15 +1186,14 @@ Opendp::legalGridPt(const Cell *cell,
 
 ////////////////////////////////////////////////////////////////
 
-PixelPt::PixelPt() :
-  pixel(nullptr)
+GridPt::GridPt() :
+  found(false)
 {
 }
 
-PixelPt::PixelPt(Pixel *pixel1,
-                 int grid_x,
-                 int grid_y) :
-  pixel(pixel1),
+GridPt::GridPt(int grid_x,
+               int grid_y) :
+  found(true),
   pt(grid_x, grid_y)
 {
 }
@@ -0,0 +1,18 @@
+# aes legalized on several threads. The placement must be legal and the
+# same as aes, which runs on one thread.
+source "helpers.tcl"
+read_lef Nangate45/Nangate45.lef
+read_def aes_cipher_top_replace.def
+set_thread_count 4
+detailed_placement
+check_placement
+
+set def_file [make_result_file aes_threads.def]
+write_def $def_file
+
+if { [diff_files aes.defok $def_file] } {
+  puts "fail: 4 threads differ from 1 thread"
+  exit 1
+}
+puts "pass"
+exit 0
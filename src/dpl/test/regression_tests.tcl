@@ -56,3 +56,7 @@ record_tests {
   gcd
   ibex
 }
+
+record_pass_fail_tests {
+  aes_threads
+}
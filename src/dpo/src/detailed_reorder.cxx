@@ -43,6 +43,7 @@
 #include <stack>
 #include <utility>
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 #include "detailed_manager.h"
 #include "detailed_segment.h"
 #include "plotgnu.h"
@@ -61,7 +62,6 @@ DetailedReorderer::DetailedReorderer(Architecture* arch, Network* network,
       m_rt(rt),
       m_mgrPtr(nullptr),
       m_skipNetsLargerThanThis(100),
-      m_traversal(0),
       m_windowSize(3) {}
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -143,66 +143,135 @@ void DetailedReorderer::run(DetailedMgr* mgrPtr,
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 void DetailedReorderer::reorder() {
-  m_traversal = 0;
-  m_edgeMask.resize(m_network->getNumEdges());
-  std::fill(m_edgeMask.begin(), m_edgeMask.end(), m_traversal);
+  utl::ThreadPool& pool = utl::ThreadPool::get();
+  if (pool.threadCount() <= 1) {
+    // Loop over each segment; find single height cells and reorder.
+    for (int s = 0; s < m_mgrPtr->getNumSegments(); s++) {
+      reorder(m_mgrPtr->getSegment(s));
+    }
+    return;
+  }
+
+  // Segments in the same wave do not share any net that is costed,
+  // so they can be reordered concurrently.  A segment comes in a later
+  // wave than every segment before it that it shares a net with, which
+  // gives the same result as visiting the segments one at a time.
+  std::vector<std::vector<int> > waves;
+  segmentWaves(waves);
+  for (size_t w = 0; w < waves.size(); w++) {
+    const std::vector<int>& segs = waves[w];
+    pool.parallelFor(0, (int)segs.size(), [&](int i) {
+      reorder(m_mgrPtr->getSegment(segs[i]));
+    });
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+void DetailedReorderer::segmentWaves(std::vector<std::vector<int> >& waves) {
+  // Two segments conflict if a net that is costed (see cost()) has
+  // single height cells in both.
+  int nsegs = m_mgrPtr->getNumSegments();
+  std::vector<std::vector<int> > segEdges(nsegs);
+  std::vector<std::vector<int> > edgeSegs(m_network->getNumEdges());
+  for (int s = 0; s < nsegs; s++) {
+    int segId = m_mgrPtr->getSegment(s)->getSegId();
+    for (Node* ndi : m_mgrPtr->m_cellsInSeg[segId]) {
+      if (!m_arch->isSingleHeightCell(ndi)) {
+        continue;
+      }
+      for (int pi = 0; pi < ndi->getNumPins(); pi++) {
+        Edge* edi = ndi->getPins()[pi]->getEdge();
+        int npins = edi->getNumPins();
+        if (npins <= 1 || npins >= m_skipNetsLargerThanThis) {
+          continue;
+        }
+        std::vector<int>& segs = edgeSegs[edi->getId()];
+        if (segs.empty() || segs.back() != s) {
+          segs.push_back(s);
+          segEdges[s].push_back(edi->getId());
+        }
+      }
+    }
+  }
 
+  // The segments on an edge are in increasing order, so the ones
+  // before s already have their wave.
+  waves.clear();
+  std::vector<int> segWave(nsegs, 0);
+  for (int s = 0; s < nsegs; s++) {
+    int w = 0;
+    for (int e : segEdges[s]) {
+      for (int t : edgeSegs[e]) {
+        if (t >= s) {
+          break;
+        }
+        w = std::max(w, segWave[t] + 1);
+      }
+    }
+    segWave[s] = w;
+    if (w == (int)waves.size()) {
+      waves.push_back(std::vector<int>());
+    }
+    waves[w].push_back(s);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+void DetailedReorderer::reorder(DetailedSeg* segPtr) {
   int rightLimit = 0.;
   int leftLimit = 0.;
   int rightPadding = 0.;
   int leftPadding = 0.;
 
-  // Loop over each segment; find single height cells and reorder.
-  for (int s = 0; s < m_mgrPtr->getNumSegments(); s++) {
-    DetailedSeg* segPtr = m_mgrPtr->getSegment(s);
-    int segId = segPtr->getSegId();
-    int rowId = segPtr->getRowId();
+  int segId = segPtr->getSegId();
+  int rowId = segPtr->getRowId();
 
-    std::vector<Node*>& nodes = m_mgrPtr->m_cellsInSeg[segId];
-    if (nodes.size() < 2) {
-      continue;
+  std::vector<Node*>& nodes = m_mgrPtr->m_cellsInSeg[segId];
+  if (nodes.size() < 2) {
+    return;
+  }
+  std::sort(nodes.begin(), nodes.end(), DetailedMgr::compareNodesX());
+
+  int j = 0;
+  int n = (int)nodes.size();
+  while (j < n) {
+    while (j < n && m_arch->isMultiHeightCell(nodes[j])) {
+      ++j;
+    }
+    int jstrt = j;
+    while (j < n && m_arch->isSingleHeightCell(nodes[j])) {
+      ++j;
     }
-    std::sort(nodes.begin(), nodes.end(), DetailedMgr::compareNodesX());
+    int jstop = j - 1;
+
+    // Single height cells in [jstrt,jstop].
+    for (int i = jstrt; i + m_windowSize <= jstop; ++i) {
+      int istrt = i;
+      int istop = std::min(jstop, istrt + m_windowSize - 1);
+      if (istop == jstop) {
+        istrt = std::max(jstrt, istop - m_windowSize + 1);
+      }
 
-    int j = 0;
-    int n = (int)nodes.size();
-    while (j < n) {
-      while (j < n && m_arch->isMultiHeightCell(nodes[j])) {
-        ++j;
+      Node* nextPtr = (istop != n - 1) ? nodes[istop + 1] : 0;
+      rightLimit = segPtr->getMaxX();
+      if (nextPtr != 0) {
+        m_arch->getCellPadding(nextPtr, leftPadding, rightPadding);
+        rightLimit = std::min(
+            (int)std::floor(nextPtr->getLeft() - leftPadding),
+            rightLimit);
       }
-      int jstrt = j;
-      while (j < n && m_arch->isSingleHeightCell(nodes[j])) {
-        ++j;
+      Node* prevPtr = (istrt != 0) ? nodes[istrt - 1] : 0;
+      leftLimit = segPtr->getMinX();
+      if (prevPtr != 0) {
+        m_arch->getCellPadding(prevPtr, leftPadding, rightPadding);
+        leftLimit = std::max(
+            (int)std::ceil(prevPtr->getRight() + rightPadding),
+            leftLimit);
       }
-      int jstop = j - 1;
-
-      // Single height cells in [jstrt,jstop].
-      for (int i = jstrt; i + m_windowSize <= jstop; ++i) {
-        int istrt = i;
-        int istop = std::min(jstop, istrt + m_windowSize - 1);
-        if (istop == jstop) {
-          istrt = std::max(jstrt, istop - m_windowSize + 1);
-        }
 
-        Node* nextPtr = (istop != n - 1) ? nodes[istop + 1] : 0;
-        rightLimit = segPtr->getMaxX();
-        if (nextPtr != 0) {
-          m_arch->getCellPadding(nextPtr, leftPadding, rightPadding);
-          rightLimit = std::min(
-              (int)std::floor(nextPtr->getLeft() - leftPadding),
-              rightLimit);
-        }
-        Node* prevPtr = (istrt != 0) ? nodes[istrt - 1] : 0;
-        leftLimit = segPtr->getMinX();
-        if (prevPtr != 0) {
-          m_arch->getCellPadding(prevPtr, leftPadding, rightPadding);
-          leftLimit = std::max(
-              (int)std::ceil(prevPtr->getRight() + rightPadding),
-              leftLimit);
-        }
-
-        reorder(nodes, istrt, istop, leftLimit, rightLimit, segId, rowId);
-      }
+      reorder(nodes, istrt, istop, leftLimit, rightLimit, segId, rowId);
     }
   }
 }
@@ -382,9 +451,11 @@ void DetailedReorderer::reorder(std::vector<Node*>& nodes, int jstrt, int jstop,
 ////////////////////////////////////////////////////////////////////////////////
 double DetailedReorderer::cost(std::vector<Node*>& nodes, int istrt,
                                int istop) {
-  // Compute hpwl for the specified sequence of cells.
+  // Compute hpwl for the specified sequence of cells.  The window is
+  // only a few cells, so the nets already seen are kept in a short list
+  // rather than a mask shared by all segments.
 
-  ++m_traversal;
+  std::vector<Edge*> seen;
 
   double cost = 0.;
   for (int i = istrt; i <= istop; i++) {
@@ -399,10 +470,10 @@ double DetailedReorderer::cost(std::vector<Node*>& nodes, int istrt,
       if (npins <= 1 || npins >= m_skipNetsLargerThanThis) {
         continue;
       }
-      if (m_edgeMask[edi->getId()] == m_traversal) {
+      if (std::find(seen.begin(), seen.end(), edi) != seen.end()) {
         continue;
       }
-      m_edgeMask[edi->getId()] = m_traversal;
+      seen.push_back(edi);
 
       double xmin = std::numeric_limits<double>::max();
       double xmax = -std::numeric_limits<double>::max();
@@ -54,9 +54,11 @@ class DetailedReorderer {
 
  protected:
   void reorder();
+  void reorder(DetailedSeg* segPtr);
   void reorder(std::vector<Node*>& nodes, int istrt, int istop,
                int leftLimit, int rightLimit, int segId, int rowId);
   double cost(std::vector<Node*>& nodes, int istrt, int istop);
+  void segmentWaves(std::vector<std::vector<int> >& waves);
 
   // Standard stuff.
   Architecture* m_arch;
@@ -68,8 +70,6 @@ class DetailedReorderer {
 
   // Other.
   int m_skipNetsLargerThanThis;
-  std::vector<int> m_edgeMask;
-  int m_traversal;
   int m_windowSize;
 };
 
@@ -3,3 +3,7 @@ record_tests {
     gcd
     ibex
 }
+
+record_pass_fail_tests {
+    aes_threads
+}
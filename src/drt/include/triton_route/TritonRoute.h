@@ -94,6 +94,8 @@ class TritonRoute
 
   int main();
   void pinAccess(std::vector<odb::dbInst*> target_insts = std::vector<odb::dbInst*>());
+  // Check the routed design for DRC violations without routing.
+  void checkDRC(const char* drc_file);
 
   int getNumDRVs() const;
 
@@ -137,7 +139,8 @@ class TritonRoute
   std::string shared_volume_;
 
   void initDesign();
-  void initGuide();
+  void readDesign(fr::frDesign* design);
+  bool initGuide();
   void prep();
   void gr();
   void ta();
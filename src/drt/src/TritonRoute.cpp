@@ -28,8 +28,12 @@
 
 #include "triton_route/TritonRoute.h"
 
+#include <omp.h>
+
 #include <fstream>
 #include <iostream>
+#include <set>
+#include <tuple>
 
 #include "DesignCallBack.h"
 #include "RoutingCallBack.h"
@@ -41,6 +45,7 @@
 #include "gc/FlexGC.h"
 #include "global.h"
 #include "gr/FlexGR.h"
+#include "grt/GlobalRouter.h"
 #include "gui/gui.h"
 #include "io/io.h"
 #include "ord/OpenRoad.hh"
@@ -50,9 +55,11 @@
 #include "sta/StaMain.hh"
 #include "stt/SteinerTreeBuilder.h"
 #include "ta/FlexTA.h"
+#include "utl/exception.h"
 using namespace std;
 using namespace fr;
 using namespace triton_route;
+using utl::ThreadException;
 
 namespace sta {
 // Tcl files encoded into strings.
@@ -201,24 +208,74 @@ void TritonRoute::init(Tcl_Interp* tcl_interp,
   FlexDRGraphics::init();
 }
 
-void TritonRoute::initGuide()
+static std::map<frNet*, std::vector<frRect>, frBlockObjectComp>
+getGlobalRouterGuides(grt::GlobalRouter* grouter,
+                      frDesign* design,
+                      odb::dbBlock* block,
+                      Logger* logger)
+{
+  if (VERBOSE > 0) {
+    logger->info(DRT, 610, "Reading guides from global route.");
+  }
+  std::map<frNet*, std::vector<frRect>, frBlockObjectComp> guides;
+  auto tech = design->getTech();
+  for (auto& net : design->getTopBlock()->getNets()) {
+    odb::dbNet* dbNet = block->findNet(net->getName().c_str());
+    if (dbNet == nullptr) {
+      continue;
+    }
+    for (auto& [box, layer] : grouter->getGuides(dbNet)) {
+      frLayer* routeLayer = tech->getLayer(layer->getName());
+      if (routeLayer == nullptr) {
+        logger->error(DRT, 611, "Cannot find layer {}.", layer->getName());
+      }
+      frRect rect;
+      rect.setBBox(box);
+      rect.setLayerNum(routeLayer->getLayerNum());
+      guides[net.get()].push_back(rect);
+    }
+  }
+  return guides;
+}
+
+// Returns false when there are no guides, neither from a file nor from
+// global_route, and they have to come from FlexGR.
+bool TritonRoute::initGuide()
 {
   if (DBPROCESSNODE == "GF14_13M_3Mx_2Cx_4Kx_2Hx_2Gx_LB")
     USENONPREFTRACKS = false;
   io::Parser parser(getDesign(), logger_);
+  bool hasGuides = true;
+  auto grouter = ord::OpenRoad::openRoad()->getGlobalRouter();
   if (!GUIDE_FILE.empty()) {
     parser.readGuide();
     parser.postProcessGuide(db_);
+  } else if (grouter != nullptr && grouter->haveRoutes()) {
+    parser.setGuides(getGlobalRouterGuides(
+        grouter, getDesign(), db_->getChip()->getBlock(), logger_));
+    parser.postProcessGuide(db_);
+  } else {
+    hasGuides = false;
   }
   parser.initRPin();
+  return hasGuides;
 }
+
 void TritonRoute::initDesign()
 {
   if (getDesign()->getTopBlock() != nullptr)
     return;
-  io::Parser parser(getDesign(), logger_);
+  readDesign(getDesign());
+  if (db_ != nullptr && db_->getChip() != nullptr
+      && db_->getChip()->getBlock() != nullptr)
+    db_callback_->addOwner(db_->getChip()->getBlock());
+}
+
+void TritonRoute::readDesign(frDesign* design)
+{
+  io::Parser parser(design, logger_);
   parser.readDb(db_);
-  auto tech = getDesign()->getTech();
+  auto tech = design->getTech();
   if (!BOTTOM_ROUTING_LAYER_NAME.empty()) {
     frLayer* layer = tech->getLayer(BOTTOM_ROUTING_LAYER_NAME);
     if (layer) {
@@ -267,9 +324,6 @@ void TritonRoute::initDesign()
     }
   }
   parser.postProcess();
-  if (db_ != nullptr && db_->getChip() != nullptr
-      && db_->getChip()->getBlock() != nullptr)
-    db_callback_->addOwner(db_->getChip()->getBlock());
 }
 
 void TritonRoute::prep()
@@ -282,6 +336,14 @@ void TritonRoute::gr()
 {
   FlexGR gr(getDesign(), logger_, stt_builder_);
   gr.main(db_);
+
+  std::map<frNet*, std::vector<frRect>, frBlockObjectComp> guides;
+  gr.getGuides(guides);
+  io::Parser parser(getDesign(), logger_);
+  ENABLE_VIA_GEN = true;
+  parser.setGuides(std::move(guides));
+  parser.initDefaultVias();
+  parser.postProcessGuide(db_);
 }
 
 void TritonRoute::ta()
@@ -315,18 +377,11 @@ int TritonRoute::main()
 {
   MAX_THREADS = ord::OpenRoad::openRoad()->getThreadCount();
   initDesign();
-  FlexPA pa(getDesign(), logger_);
+  FlexPA pa(getDesign(), logger_, db_);
   pa.setDebug(debug_.get(), db_);
   pa.main();
-  initGuide();
-  if (GUIDE_FILE == string("")) {
+  if (!initGuide()) {
     gr();
-    io::Parser parser(getDesign(), logger_);
-    GUIDE_FILE = OUTGUIDE_FILE;
-    ENABLE_VIA_GEN = true;
-    parser.readGuide();
-    parser.initDefaultVias();
-    parser.postProcessGuide(db_);
   }
   prep();
   ta();
@@ -343,7 +398,7 @@ void TritonRoute::pinAccess(std::vector<odb::dbInst*> target_insts)
   MAX_THREADS = ord::OpenRoad::openRoad()->getThreadCount();
   ENABLE_VIA_GEN = true;
   initDesign();
-  FlexPA pa(getDesign(), logger_);
+  FlexPA pa(getDesign(), logger_, db_);
   pa.setTargetInstances(target_insts);
   pa.setDebug(debug_.get(), db_);
   pa.main();
@@ -351,6 +406,111 @@ void TritonRoute::pinAccess(std::vector<odb::dbInst*> target_insts)
   writer.updateDb(db_, true);
 }
 
+void TritonRoute::checkDRC(const char* drc_file)
+{
+  MAX_THREADS = ord::OpenRoad::openRoad()->getThreadCount();
+  // Check a copy of the design read from odb so that edits made since the
+  // router last saw it (e.g. an ECO after routing) are what gets checked,
+  // while the router's own design is left as it is.
+  frDesign design(logger_);
+  readDesign(&design);
+  auto topBlock = design.getTopBlock();
+  auto regionQuery = design.getRegionQuery();
+
+  // Tile the die in squares of about the clip size of the detailed routing
+  // workers. The gcell patterns are only built along with the guides, so
+  // take the gcell size from odb, or failing that from the track pitch.
+  const int clipSize = 7;
+  frCoord gcellSize = 0;
+  auto gcellGrid = db_->getChip()->getBlock()->getGCellGrid();
+  if (gcellGrid != nullptr && gcellGrid->getNumGridPatternsX() > 0) {
+    int origin, count, step;
+    gcellGrid->getGridPatternX(0, origin, count, step);
+    gcellSize = step;
+  }
+  if (gcellSize <= 0 && BOTTOM_ROUTING_LAYER >= 0
+      && BOTTOM_ROUTING_LAYER <= design.getTech()->getTopLayerNum()) {
+    gcellSize
+        = 15 * design.getTech()->getLayer(BOTTOM_ROUTING_LAYER)->getPitch();
+  }
+  const Rect& dieBox = topBlock->getDieBox();
+  const frCoord tileSize
+      = gcellSize > 0 ? clipSize * gcellSize
+                      : (frCoord) std::max(dieBox.dx(), dieBox.dy()) + 1;
+  std::vector<Rect> tiles;
+  for (frCoord x = dieBox.xMin(); x < dieBox.xMax(); x += tileSize) {
+    for (frCoord y = dieBox.yMin(); y < dieBox.yMax(); y += tileSize) {
+      tiles.emplace_back(x,
+                         y,
+                         std::min(x + tileSize, dieBox.xMax()),
+                         std::min(y + tileSize, dieBox.yMax()));
+    }
+  }
+
+  // Each tile sees the design shapes within MTSAFEDIST of it so that
+  // violations against shapes in neighboring tiles are found.
+  std::vector<std::vector<std::unique_ptr<frMarker>>> tileMarkers(
+      tiles.size());
+  omp_set_num_threads(MAX_THREADS);
+  ThreadException exception;
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < (int) tiles.size(); i++) {
+    try {
+      const Rect& tile = tiles[i];
+      Rect extBox;
+      tile.bloat(MTSAFEDIST, extBox);
+      FlexGCWorker gcWorker(design.getTech(), logger_);
+      gcWorker.setExtBox(extBox);
+      gcWorker.setDrcBox(tile);
+      gcWorker.init(&design);
+      gcWorker.main();
+      for (auto& marker : gcWorker.getMarkers()) {
+        Rect markerBox;
+        marker->getBBox(markerBox);
+        if (tile.intersects(markerBox)) {
+          tileMarkers[i].push_back(std::make_unique<frMarker>(*marker));
+        }
+      }
+      gcWorker.end();
+    } catch (...) {
+      exception.capture();
+    }
+  }
+  exception.rethrow();
+
+  // Markers that touch a tile seam are found by every tile they touch.
+  std::set<std::tuple<Rect,
+                      frLayerNum,
+                      frConstraint*,
+                      std::set<frBlockObject*>>>
+      seenMarkers;
+  for (auto& markers : tileMarkers) {
+    for (auto& marker : markers) {
+      auto key = std::make_tuple(marker->getBBox(),
+                                 marker->getLayerNum(),
+                                 marker->getConstraint(),
+                                 marker->getSrcs());
+      if (!seenMarkers.insert(key).second) {
+        continue;
+      }
+      regionQuery->addMarker(marker.get());
+      topBlock->addMarker(std::move(marker));
+    }
+  }
+
+  num_drvs_ = topBlock->getNumMarkers();
+  logger_->info(DRT,
+                608,
+                "DRC check of {} tiles found {} violations.",
+                tiles.size(),
+                num_drvs_);
+
+  if (drc_file[0] != '\0') {
+    FlexDR dr(&design, logger_, db_);
+    dr.reportDRC(drc_file);
+  }
+}
+
 void TritonRoute::readParams(const string& fileName)
 {
   logger_->warn(utl::DRT, 252, "params file is deprecated. Use tcl arguments.");
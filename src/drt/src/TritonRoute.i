@@ -120,6 +120,12 @@ void detailed_route_cmd(const char* param_file)
   router->main();
 }
 
+void check_drc_cmd(const char* output_file)
+{
+  auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
+  router->checkDRC(output_file);
+}
+
 void report_constraints()
 {
   auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
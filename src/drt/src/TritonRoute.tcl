@@ -279,6 +279,21 @@ proc pin_access { args } {
   }
   drt::pin_access_cmd $db_process_node $bottom_routing_layer $top_routing_layer $verbose
 }
+sta::define_cmd_args "check_drc" {
+    [-output_file filename]
+}
+proc check_drc { args } {
+  sta::parse_key_args "check_drc" args \
+      keys {-output_file} \
+      flags {}
+  sta::check_argc_eq0 "check_drc" $args
+  if { [info exists keys(-output_file)] } {
+    set output_file $keys(-output_file)
+  } else {
+    set output_file ""
+  }
+  drt::check_drc_cmd $output_file
+}
 proc detailed_route_run_worker { args } {
   sta::check_argc_eq1 "detailed_route_run_worker" $args
   drt::run_worker_cmd $args
@@ -128,6 +128,8 @@ class FlexDR
     dist_port_ = port;
     dist_dir_ = dir;
   }
+  // utility
+  void reportDRC(const std::string& file_name);
 
  private:
   frDesign* design_;
@@ -205,9 +207,6 @@ class FlexDR
                     int ripupMode,
                     bool followGuide);
   void end(bool writeMetrics = false);
-
-  // utility
-  void reportDRC(const std::string& file_name);
 };
 
 class FlexDRWorker;
@@ -33,6 +33,8 @@
 #include <ittnotify.h>
 #endif
 
+#include "utl/Tracer.h"
+
 namespace fr {
 
 #ifdef HAS_VTUNE
@@ -43,7 +45,7 @@ class ProfileTask
 {
  public:
   ProfileTask(const char* name)
-    : done_(false)
+    : trace_(utl::DRT, name), done_(false)
   {
     domain_ = __itt_domain_create("TritonRoute");
     name_ = __itt_string_handle_create(name);
@@ -54,9 +56,10 @@ class ProfileTask
 
   // Useful if you don't want to have to introduce a scope
   // just to note a task.
-  void done() { done_ = true; __itt_task_end(domain_); }
+  void done() { done_ = true; trace_.end(); __itt_task_end(domain_); }
   
  private:
+  utl::TraceScope trace_;
   __itt_domain* domain_;
   __itt_string_handle* name_;
   bool done_;
@@ -64,12 +67,15 @@ class ProfileTask
 
 #else
 
-// No-op version
+// Only records a utl trace span.
 class ProfileTask
 {
  public:
-  ProfileTask(const char* name) {}
-  void done() {}
+  ProfileTask(const char* name) : trace_(utl::DRT, name) {}
+  void done() { trace_.end(); }
+
+ private:
+  utl::TraceScope trace_;
 };
 #endif
 
@@ -136,8 +136,6 @@ void FlexGR::main(odb::dbDatabase* db)
     updateDbCongestion(db, cmap_.get());
 
   writeToGuide();
-
-  writeGuideFile();
 }
 
 void FlexGR::searchRepairMacro(int iter,
@@ -2503,45 +2501,40 @@ void FlexGR::writeToGuide()
   }
 }
 
-void FlexGR::writeGuideFile()
+void FlexGR::getGuides(
+    map<frNet*, vector<frRect>, frBlockObjectComp>& guides) const
 {
-  if (OUTGUIDE_FILE == string("")) {
-    OUTGUIDE_FILE = string("./route.guide");
-  }
-  ofstream outputGuide(OUTGUIDE_FILE.c_str());
-  if (outputGuide.is_open()) {
-    for (auto& net : design_->getTopBlock()->getNets()) {
-      auto netName = net->getName();
-      outputGuide << netName << endl;
-      outputGuide << "(\n";
-      for (auto& guide : net->getGuides()) {
-        Point bp, ep;
-        guide->getPoints(bp, ep);
-        Point bpIdx, epIdx;
-        design_->getTopBlock()->getGCellIdx(bp, bpIdx);
-        design_->getTopBlock()->getGCellIdx(ep, epIdx);
-        Rect bbox, ebox;
-        design_->getTopBlock()->getGCellBox(bpIdx, bbox);
-        design_->getTopBlock()->getGCellBox(epIdx, ebox);
-        frLayerNum bNum = guide->getBeginLayerNum();
-        frLayerNum eNum = guide->getEndLayerNum();
-        // append unit guide in case of stacked via
-        if (bNum != eNum) {
-          for (auto lNum = min(bNum, eNum); lNum <= max(bNum, eNum);
-               lNum += 2) {
-            auto layerName = design_->getTech()->getLayer(lNum)->getName();
-            outputGuide << bbox.xMin() << " " << bbox.yMin() << " "
-                        << bbox.xMax() << " " << bbox.yMax() << " " << layerName
-                        << endl;
-          }
-        } else {
-          auto layerName = design_->getTech()->getLayer(bNum)->getName();
-          outputGuide << bbox.xMin() << " " << bbox.yMin() << " "
-                      << ebox.xMax() << " " << ebox.yMax() << " " << layerName
-                      << endl;
+  for (auto& net : design_->getTopBlock()->getNets()) {
+    vector<frRect> rects;
+    for (auto& guide : net->getGuides()) {
+      Point bp, ep;
+      guide->getPoints(bp, ep);
+      Point bpIdx, epIdx;
+      design_->getTopBlock()->getGCellIdx(bp, bpIdx);
+      design_->getTopBlock()->getGCellIdx(ep, epIdx);
+      Rect bbox, ebox;
+      design_->getTopBlock()->getGCellBox(bpIdx, bbox);
+      design_->getTopBlock()->getGCellBox(epIdx, ebox);
+      frLayerNum bNum = guide->getBeginLayerNum();
+      frLayerNum eNum = guide->getEndLayerNum();
+      frRect rect;
+      // append unit guide in case of stacked via
+      if (bNum != eNum) {
+        for (auto lNum = min(bNum, eNum); lNum <= max(bNum, eNum); lNum += 2) {
+          rect.setBBox(bbox);
+          rect.setLayerNum(lNum);
+          rects.push_back(rect);
         }
+      } else {
+        rect.setBBox(
+            Rect(bbox.xMin(), bbox.yMin(), ebox.xMax(), ebox.yMax()));
+        rect.setLayerNum(bNum);
+        rects.push_back(rect);
       }
-      outputGuide << ")\n";
+    }
+    // like readGuide, only nets that have guides get an entry
+    if (!rects.empty()) {
+      guides[net.get()] = std::move(rects);
     }
   }
 }
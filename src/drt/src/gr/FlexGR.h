@@ -70,6 +70,10 @@ class FlexGR
     }
   }
 
+  // guides of the routed nets, in the form io::Parser reads them
+  void getGuides(
+      std::map<frNet*, std::vector<frRect>, frBlockObjectComp>& guides) const;
+
   // others
   void main(odb::dbDatabase* db = nullptr);
 
@@ -230,7 +234,6 @@ class FlexGR
       std::vector<frNode*>& steinerNodes);
   // utility
   void writeToGuide();
-  void writeGuideFile();
   void getBatchInfo(int& batchStepX, int& batchStepY);
 };
 
@@ -38,6 +38,7 @@
 #include "global.h"
 #include "odb/db.h"
 #include "odb/dbWireCodec.h"
+#include "pa/FlexPA.h"
 #include "utl/Logger.h"
 
 using namespace std;
@@ -2164,6 +2165,24 @@ void io::Parser::readDb(odb::dbDatabase* db)
   }
 }
 
+void io::Parser::checkGuideLayer(const string& netName, frLayerNum layerNum)
+{
+  if ((layerNum < BOTTOM_ROUTING_LAYER && layerNum != VIA_ACCESS_LAYERNUM)
+      || layerNum > TOP_ROUTING_LAYER)
+    logger->error(DRT,
+                  155,
+                  "Guide in net {} uses layer {} ({})"
+                  " that is outside the allowed routing range "
+                  "[{} ({}), ({})].",
+                  netName,
+                  tech->getLayer(layerNum)->getName(),
+                  layerNum,
+                  tech->getLayer(BOTTOM_ROUTING_LAYER)->getName(),
+                  BOTTOM_ROUTING_LAYER,
+                  tech->getLayer(TOP_ROUTING_LAYER)->getName(),
+                  TOP_ROUTING_LAYER);
+}
+
 void io::Parser::readGuide()
 {
   ProfileTask profile("IO:readGuide");
@@ -2216,21 +2235,7 @@ void io::Parser::readGuide()
           logger->error(DRT, 154, "Cannot find layer {}.", vLine[4]);
         }
         layerNum = tech->name2layer[vLine[4]]->getLayerNum();
-
-        if ((layerNum < BOTTOM_ROUTING_LAYER && layerNum != VIA_ACCESS_LAYERNUM)
-            || layerNum > TOP_ROUTING_LAYER)
-          logger->error(DRT,
-                        155,
-                        "Guide in net {} uses layer {} ({})"
-                        " that is outside the allowed routing range "
-                        "[{} ({}), ({})].",
-                        netName,
-                        vLine[4],
-                        layerNum,
-                        tech->getLayer(BOTTOM_ROUTING_LAYER)->getName(),
-                        BOTTOM_ROUTING_LAYER,
-                        tech->getLayer(TOP_ROUTING_LAYER)->getName(),
-                        TOP_ROUTING_LAYER);
+        checkGuideLayer(netName, layerNum);
 
         box.init(
             stoi(vLine[0]), stoi(vLine[1]), stoi(vLine[2]), stoi(vLine[3]));
@@ -2265,6 +2270,29 @@ void io::Parser::readGuide()
   }
 }
 
+// Take guides produced in memory by a global router instead of reading
+// them back from GUIDE_FILE.
+void io::Parser::setGuides(
+    map<frNet*, vector<frRect>, frBlockObjectComp> guides)
+{
+  ProfileTask profile("IO:setGuides");
+
+  int numGuides = 0;
+  for (auto& [net, rects] : guides) {
+    for (auto& rect : rects) {
+      checkGuideLayer(net->getName(), rect.getLayerNum());
+    }
+    numGuides += rects.size();
+  }
+  tmpGuides = std::move(guides);
+
+  if (VERBOSE > 0) {
+    logger->report("");
+    logger->report("Number of guides:     {}", numGuides);
+    logger->report("");
+  }
+}
+
 void io::Writer::fillConnFigs_net(frNet* net, bool isTA)
 {
   auto netName = net->getName();
@@ -2880,6 +2908,75 @@ void io::Writer::updateDbAccessPoints(odb::dbBlock* block, odb::dbTech* tech)
       }
     }
   }
+  updateDbPinAccessClasses(block);
+}
+
+// Record the placement and master geometry each (master, pin access index)
+// was computed for, and the tech, so that FlexPA can reuse the access points
+// while they are still valid.  A class
+// whose instances no longer agree on the track offset is left unrecorded.
+void io::Writer::updateDbPinAccessClasses(odb::dbBlock* block)
+{
+  auto props = odb::dbProperty::getProperties(block);
+  for (auto itr = props.begin(); itr != props.end();) {
+    if ((*itr)->getName().compare(0, 7, "drt_pa:") == 0) {
+      itr = odb::dbProperty::destroy(itr);
+    } else {
+      ++itr;
+    }
+  }
+
+  std::map<std::pair<frMaster*, int>, std::pair<frInst*, bool>> classes;
+  for (auto& inst : design->getTopBlock()->getInsts()) {
+    frMaster* master = inst->getMaster();
+    frMPin* pin = nullptr;
+    for (auto& term : master->getTerms()) {
+      if (!term->getPins().empty()) {
+        pin = term->getPins()[0].get();
+        break;
+      }
+    }
+    int paIdx = inst->getPinAccessIdx();
+    if (pin == nullptr || paIdx >= pin->getNumPinAccess()) {
+      continue;
+    }
+    auto [it, inserted] = classes.insert(
+        std::make_pair(std::make_pair(master, paIdx),
+                       std::make_pair(inst.get(), true)));
+    if (!inserted && it->second.second) {
+      Rect box1, box2;
+      inst->getBoundaryBBox(box1);
+      it->second.first->getBoundaryBBox(box2);
+      if (inst->getOrient() != it->second.first->getOrient()
+          || !FlexPA::isSameTrackOffset(design, box1, box2)) {
+        it->second.second = false;
+      }
+    }
+  }
+
+  for (auto& [key, value] : classes) {
+    auto& [inst, valid] = value;
+    if (!valid) {
+      continue;
+    }
+    Rect box;
+    inst->getBoundaryBBox(box);
+    std::stringstream ss;
+    ss << inst->getOrient().getString() << " " << box.xMin() << " "
+       << box.yMin() << " " << box.xMax() << " " << box.yMax() << " "
+       << FlexPA::getMasterSignature(key.first);
+    odb::dbStringProperty::create(
+        block,
+        FlexPA::getPinAccessClassPropName(key.first->getName(), key.second)
+            .c_str(),
+        ss.str().c_str());
+  }
+  odb::dbStringProperty::create(
+      block, "drt_pa:tracks", FlexPA::getTrackSignature(design).c_str());
+  odb::dbStringProperty::create(
+      block,
+      "drt_pa:tech",
+      FlexPA::getTechSignature(block->getDb()->getTech(), logger).c_str());
 }
 
 void io::Writer::updateDb(odb::dbDatabase* db, bool pin_access)
@@ -79,6 +79,8 @@ class Parser
   // others
   void readDb(odb::dbDatabase* db);
   void readGuide();
+  void setGuides(
+      std::map<frNet*, std::vector<frRect>, frBlockObjectComp> guides);
   void postProcess();
   void postProcessGuide(odb::dbDatabase* db);
   void initDefaultVias();
@@ -96,6 +98,11 @@ class Parser
   {
     return prefTrackPatterns;
   }
+  const std::map<frNet*, std::vector<frRect>, frBlockObjectComp>& getGuides()
+      const
+  {
+    return tmpGuides;
+  }
 
  private:
   void readDesign(odb::dbDatabase*);
@@ -126,6 +133,7 @@ class Parser
   void setCutLayerProperties(odb::dbTechLayer* layer, frLayer* tmpLayer);
 
   void setNDRs(odb::dbDatabase* db);
+  void checkGuideLayer(const std::string& netName, frLayerNum layerNum);
   void createNDR(odb::dbTechNonDefaultRule* ndr);
 
   frDesign* design;
@@ -296,6 +304,7 @@ class Writer
   void updateDbConn(odb::dbBlock* block, odb::dbTech* tech);
   void updateDbVias(odb::dbBlock* block, odb::dbTech* tech);
   void updateDbAccessPoints(odb::dbBlock* block, odb::dbTech* tech);
+  void updateDbPinAccessClasses(odb::dbBlock* block);
 };
 }  // namespace io
 }  // namespace fr
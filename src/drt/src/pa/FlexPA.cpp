@@ -40,9 +40,10 @@
 using namespace std;
 using namespace fr;
 
-FlexPA::FlexPA(frDesign* in, Logger* logger)
+FlexPA::FlexPA(frDesign* in, Logger* logger, odb::dbDatabase* db)
     : design_(in),
       logger_(logger),
+      db_(db),
       stdCellPinGenApCnt_(0),
       stdCellPinValidPlanarApCnt_(0),
       stdCellPinValidViaApCnt_(0),
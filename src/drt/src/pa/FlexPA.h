@@ -36,6 +36,8 @@ namespace gtl = boost::polygon;
 
 namespace odb {
 class dbDatabase;
+class dbInst;
+class dbTech;
 }
 
 namespace fr {
@@ -57,7 +59,7 @@ class FlexPA
   };
 
   // constructor
-  FlexPA(frDesign* in, Logger* logger);
+  FlexPA(frDesign* in, Logger* logger, odb::dbDatabase* db);
   ~FlexPA();
   // getters
   frDesign* getDesign() const { return design_; }
@@ -70,9 +72,24 @@ class FlexPA
     target_insts_ = insts;
   }
 
+  // The access points of a unique instance only depend on its master,
+  // orientation and offset to the tracks, and on the tech rules.  io::Writer
+  // records one placement and master signature per (master, pin access
+  // index) in the block properties so that a later run can reuse the
+  // persisted dbAccessPoints of unchanged classes.
+  static std::string getPinAccessClassPropName(const frString& master_name,
+                                               int pin_access_idx);
+  static std::string getTrackSignature(frDesign* design);
+  static std::string getMasterSignature(frMaster* master);
+  static std::string getTechSignature(odb::dbTech* tech, Logger* logger);
+  static bool isSameTrackOffset(frDesign* design,
+                                const Rect& box1,
+                                const Rect& box2);
+
  private:
   frDesign* design_;
   Logger* logger_;
+  odb::dbDatabase* db_;
   std::unique_ptr<FlexPAGraphics> graphics_;
   std::string debugPinName_;
 
@@ -130,6 +147,8 @@ class FlexPA
   // prep
   void prep();
   void prepPoint();
+  void prepPoint_findReusable(std::vector<odb::dbInst*>& reusable);
+  bool prepPoint_loadInst(frInst* inst, odb::dbInst* db_inst);
   template <typename T>
   int prepPoint_pin(T* pin, frInstTerm* instTerm = nullptr);
   template <typename T>
@@ -27,12 +27,14 @@
  */
 
 #include <chrono>
+#include <cstdio>
 #include <iostream>
 #include <sstream>
 
 #include "FlexPA.h"
 #include "db/infra/frTime.h"
 #include "gc/FlexGC.h"
+#include "odb/lefout.h"
 
 using namespace std;
 using namespace fr;
@@ -122,6 +124,130 @@ bool FlexPA::hasTrackPattern(frTrackPattern* tp, const Rect& box)
   }
 }
 
+std::string FlexPA::getPinAccessClassPropName(const frString& master_name,
+                                              int pin_access_idx)
+{
+  return "drt_pa:" + master_name + ":" + std::to_string(pin_access_idx);
+}
+
+std::string FlexPA::getTrackSignature(frDesign* design)
+{
+  std::stringstream ss;
+  for (auto tp : design->getTopBlock()->getTrackPatterns()) {
+    ss << tp->getLayerNum() << " " << tp->isHorizontal() << " "
+       << tp->getStartCoord() << " " << tp->getNumTracks() << " "
+       << tp->getTrackSpacing() << ";";
+  }
+  return ss.str();
+}
+
+static std::string fnv1aHex(const char* data, size_t size)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < size; i++) {
+    hash ^= (unsigned char) data[i];
+    hash *= 1099511628211ULL;
+  }
+  std::stringstream ss;
+  ss << std::hex << hash;
+  return ss.str();
+}
+
+// hash of the pin and obstruction shapes of the master
+std::string FlexPA::getMasterSignature(frMaster* master)
+{
+  std::stringstream ss;
+  auto addFig = [&ss](frPinFig* fig) {
+    Rect box;
+    fig->getBBox(box);
+    ss << fig->typeId() << " " << box.xMin() << " " << box.yMin() << " "
+       << box.xMax() << " " << box.yMax();
+    if (fig->typeId() == frcRect || fig->typeId() == frcPolygon) {
+      ss << " " << static_cast<frShape*>(fig)->getLayerNum();
+    }
+    if (fig->typeId() == frcPolygon) {
+      for (auto& pt : static_cast<frPolygon*>(fig)->getPoints()) {
+        ss << " " << pt.x() << " " << pt.y();
+      }
+    }
+    ss << ";";
+  };
+  const Rect& dieBox = master->getDieBox();
+  ss << dieBox.xMin() << " " << dieBox.yMin() << " " << dieBox.xMax() << " "
+     << dieBox.yMax() << ";";
+  for (auto& term : master->getTerms()) {
+    ss << term->getName() << ":";
+    for (auto& pin : term->getPins()) {
+      for (auto& fig : pin->getFigs()) {
+        addFig(fig.get());
+      }
+      ss << "|";
+    }
+  }
+  for (auto& blockage : master->getBlockages()) {
+    ss << "obs " << blockage->getDesignRuleWidth() << ":";
+    for (auto& fig : blockage->getPin()->getFigs()) {
+      addFig(fig.get());
+    }
+  }
+  const std::string sig = ss.str();
+  return fnv1aHex(sig.data(), sig.size());
+}
+
+// hash of the tech as written to LEF plus the router settings that limit
+// the layers pin access may use
+std::string FlexPA::getTechSignature(odb::dbTech* tech, Logger* logger)
+{
+  std::stringstream ss;
+  ss << DBPROCESSNODE << " " << BOTTOM_ROUTING_LAYER << " "
+     << TOP_ROUTING_LAYER << " " << VIAINPIN_BOTTOMLAYERNUM << " "
+     << VIAINPIN_TOPLAYERNUM << " " << USENONPREFTRACKS << " "
+     << USEMINSPACING_OBS << ";";
+  char* buffer = nullptr;
+  size_t size = 0;
+  FILE* out = open_memstream(&buffer, &size);
+  if (out == nullptr) {
+    return "";
+  }
+  odb::lefout writer(logger);
+  writer.writeTech(tech, out);
+  fclose(out);
+  ss << fnv1aHex(buffer, size);
+  free(buffer);
+  return ss.str();
+}
+
+// true if both boxes see every track pattern at the same offset, i.e. an
+// instance at either location falls in the same unique instance class
+bool FlexPA::isSameTrackOffset(frDesign* design,
+                               const Rect& box1,
+                               const Rect& box2)
+{
+  for (auto tp : design->getTopBlock()->getTrackPatterns()) {
+    auto isVerticalTrack = tp->isHorizontal();  // yes = vertical track
+    frCoord low = tp->getStartCoord();
+    frCoord high = low
+                   + (frCoord) (tp->getTrackSpacing())
+                         * ((frCoord) (tp->getNumTracks()) - 1);
+    frCoord spacing = tp->getTrackSpacing();
+    bool has1, has2;
+    frCoord delta;
+    if (isVerticalTrack) {
+      has1 = !(low > box1.xMax() || high < box1.xMin());
+      has2 = !(low > box2.xMax() || high < box2.xMin());
+      delta = box1.xMin() - box2.xMin();
+    } else {
+      has1 = !(low > box1.yMax() || high < box1.yMin());
+      has2 = !(low > box2.yMax() || high < box2.yMin());
+      delta = box1.yMin() - box2.yMin();
+    }
+    if (has1 != has2 || (has1 && delta % spacing != 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // must init all unique, including filler, macro, etc. to ensure frInst
 // pinAccessIdx is active
 void FlexPA::initUniqueInstance_main(
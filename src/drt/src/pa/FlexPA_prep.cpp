@@ -37,6 +37,7 @@
 #include "db/infra/frTime.h"
 #include "frProfileTask.h"
 #include "gc/FlexGC.h"
+#include "odb/db.h"
 
 #include "utl/exception.h"
 
@@ -1268,10 +1269,163 @@ int FlexPA::prepPoint_pin(T* pin, frInstTerm* instTerm)
   return nAps;
 }
 
+// find the unique instances whose access points persisted in the database
+// were computed for the same master geometry, orientation, track offset and
+// tech
+void FlexPA::prepPoint_findReusable(vector<odb::dbInst*>& reusable)
+{
+  reusable.assign(uniqueInstances_.size(), nullptr);
+  if (db_ == nullptr || db_->getChip() == nullptr || graphics_) {
+    return;
+  }
+  odb::dbBlock* block = db_->getChip()->getBlock();
+  auto tracks = odb::dbStringProperty::find(block, "drt_pa:tracks");
+  if (tracks == nullptr || tracks->getValue() != getTrackSignature(design_)) {
+    return;
+  }
+  auto tech = odb::dbStringProperty::find(block, "drt_pa:tech");
+  const std::string techSignature = getTechSignature(db_->getTech(), logger_);
+  if (tech == nullptr || techSignature.empty()
+      || tech->getValue() != techSignature) {
+    return;
+  }
+  std::map<frMaster*, std::string> masterSignatures;
+  for (int i = 0; i < (int) uniqueInstances_.size(); i++) {
+    auto inst = uniqueInstances_[i];
+    // ndr instances are checked against their nets
+    if (inst2Class_[inst] == nullptr) {
+      continue;
+    }
+    odb::dbInst* db_inst = block->findInst(inst->getName().c_str());
+    if (db_inst == nullptr
+        || db_inst->getMaster()->getName() != inst->getMaster()->getName()) {
+      continue;
+    }
+    auto prop = odb::dbStringProperty::find(
+        block,
+        getPinAccessClassPropName(inst->getMaster()->getName(),
+                                  db_inst->getPinAccessIdx())
+            .c_str());
+    if (prop == nullptr) {
+      continue;
+    }
+    std::istringstream ss(prop->getValue());
+    std::string orient;
+    int xlo, ylo, xhi, yhi;
+    std::string masterSignature;
+    if (!(ss >> orient >> xlo >> ylo >> xhi >> yhi >> masterSignature)
+        || orient != inst->getOrient().getString()) {
+      continue;
+    }
+    auto [sig, inserted] = masterSignatures.emplace(inst->getMaster(), "");
+    if (inserted) {
+      sig->second = getMasterSignature(inst->getMaster());
+    }
+    if (masterSignature != sig->second) {
+      continue;
+    }
+    Rect boundaryBBox;
+    inst->getBoundaryBBox(boundaryBBox);
+    if (isSameTrackOffset(design_, boundaryBBox, Rect(xlo, ylo, xhi, yhi))) {
+      reusable[i] = db_inst;
+    }
+  }
+}
+
+// rebuild the access points of a unique instance from the database; the
+// via access is re-checked since the chosen via defs are not persisted.
+// Returns false if the persisted points are incomplete or no longer valid,
+// in which case nothing is written and the instance is recomputed.
+bool FlexPA::prepPoint_loadInst(frInst* inst, odb::dbInst* db_inst)
+{
+  dbTransform xform;
+  inst->getTransform(xform);
+  Point offset(xform.getOffset());
+  auto paIdx = unique2paidx_[inst];
+
+  vector<pair<frMPin*, vector<unique_ptr<frAccessPoint>>>> pinAps;
+  vector<frInstTerm*> pinInstTerms;
+  for (auto& instTerm : inst->getInstTerms()) {
+    if (isSkipInstTerm(instTerm.get())) {
+      continue;
+    }
+    auto db_iterm
+        = db_inst->findITerm(instTerm->getTerm()->getName().c_str());
+    if (db_iterm == nullptr) {
+      return false;
+    }
+    auto db_pins = db_iterm->getMTerm()->getMPins();
+    auto& pins = instTerm->getTerm()->getPins();
+    if (db_pins.size() != pins.size()) {
+      return false;
+    }
+    auto db_aps = db_iterm->getAccessPoints();
+    int nAps = 0;
+    int pinIdx = 0;
+    for (auto db_pin : db_pins) {
+      auto pin = pins[pinIdx++].get();
+      vector<gtl::polygon_90_set_data<frCoord>> pinShapes;
+      prepPoint_pin_mergePinShapes(pinShapes, pin, instTerm.get());
+      vector<unique_ptr<frAccessPoint>> aps;
+      for (auto db_ap : db_aps[db_pin]) {
+        auto layer = getTech()->getLayer(db_ap->getLayer()->getName());
+        if (layer == nullptr) {
+          return false;
+        }
+        Point pt(db_ap->getPoint().x() + offset.x(),
+                 db_ap->getPoint().y() + offset.y());
+        auto ap = make_unique<frAccessPoint>(pt, layer->getLayerNum());
+        ap->setType((frAccessPointEnum) db_ap->getLowType().getValue(), true);
+        ap->setType((frAccessPointEnum) db_ap->getHighType().getValue(),
+                    false);
+        ap->setAccess(frDirEnum::E, db_ap->hasAccess(odb::dbDirection::EAST));
+        ap->setAccess(frDirEnum::S,
+                      db_ap->hasAccess(odb::dbDirection::SOUTH));
+        ap->setAccess(frDirEnum::W, db_ap->hasAccess(odb::dbDirection::WEST));
+        ap->setAccess(frDirEnum::N,
+                      db_ap->hasAccess(odb::dbDirection::NORTH));
+        ap->setAccess(frDirEnum::D, db_ap->hasAccess(odb::dbDirection::DOWN));
+        bool hasVia = db_ap->hasAccess(odb::dbDirection::UP);
+        ap->setAccess(frDirEnum::U, hasVia);
+        if (hasVia) {
+          prepPoint_pin_checkPoint_via(ap.get(),
+                                       pinShapes[ap->getLayerNum()],
+                                       frDirEnum::U,
+                                       pin,
+                                       instTerm.get());
+          if (!ap->hasAccess(frDirEnum::U)) {
+            return false;
+          }
+        }
+        aps.push_back(std::move(ap));
+      }
+      nAps += aps.size();
+      pinAps.push_back(make_pair(pin, std::move(aps)));
+      pinInstTerms.push_back(instTerm.get());
+    }
+    if (!nAps) {
+      return false;
+    }
+  }
+
+  for (int i = 0; i < (int) pinAps.size(); i++) {
+    auto& [pin, aps] = pinAps[i];
+    prepPoint_pin_updateStat(aps, pin, pinInstTerms[i]);
+    for (auto& ap : aps) {
+      pin->getPinAccess(paIdx)->addAccessPoint(std::move(ap));
+    }
+  }
+  return true;
+}
+
 void FlexPA::prepPoint()
 {
   ProfileTask profile("PA:point");
   int cnt = 0;
+  int reusedCnt = 0;
+
+  vector<odb::dbInst*> reusable;
+  prepPoint_findReusable(reusable);
 
   omp_set_num_threads(MAX_THREADS);
   ThreadException exception;
@@ -1289,6 +1443,11 @@ void FlexPA::prepPoint()
           && masterType != dbMasterType::RING) {
         continue;
       }
+      if (reusable[i] && prepPoint_loadInst(inst, reusable[i])) {
+#pragma omp atomic
+        reusedCnt++;
+        continue;
+      }
       ProfileTask profile("PA:uniqueInstance");
       for (auto& instTerm : inst->getInstTerms()) {
         // only do for normal and clock terms
@@ -1361,6 +1520,13 @@ void FlexPA::prepPoint()
 
   if (VERBOSE > 0) {
     logger_->info(DRT, 78, "  Complete {} pins.", cnt);
+    if (reusedCnt > 0) {
+      logger_->info(DRT,
+                    609,
+                    "  Reused access points of {} of {} unique instances.",
+                    reusedCnt,
+                    uniqueInstances_.size());
+    }
   }
 }
 
@@ -0,0 +1,31 @@
+# check_drc right after read_db of a routed design, and again after an ECO
+# made in odb.
+source "helpers.tcl"
+
+set db_file [make_result_file check_drc_read_db.odb]
+file delete -force $db_file
+exec [info nameofexecutable] -no_init -no_splash -exit \
+  check_drc_write_db.tcl >@stdout 2>@stderr
+
+read_db $db_file
+check_drc -output_file [make_result_file check_drc_read_db.rpt]
+set routed_drvs [drt::detailed_route_num_drvs]
+
+# Place a new inverter on top of _350_.
+set block [ord::get_db_block]
+set master [[ord::get_db] findMaster INV_X1]
+set inst [odb::dbInst_create $block $master eco_inv]
+$inst setOrient FS
+$inst setLocation 74480 92400
+$inst setPlacementStatus PLACED
+
+check_drc -output_file [make_result_file check_drc_read_db_eco.rpt]
+set eco_drvs [drt::detailed_route_num_drvs]
+
+puts "routed: $routed_drvs eco: $eco_drvs"
+if { $eco_drvs <= $routed_drvs } {
+  puts "fail: check_drc did not see the ECO"
+  exit 1
+}
+puts "pass"
+exit 0
@@ -0,0 +1,7 @@
+# Writes the routed gcd design used by check_drc_read_db.
+source "helpers.tcl"
+
+read_lef gcd_nangate45_distributed/Nangate45_tech.lef
+read_lef gcd_nangate45_distributed/Nangate45_stdcell.lef
+read_def ../../odb/test/data/gcd/gcd_nangate45_route.def
+write_db [make_result_file check_drc_read_db.odb]
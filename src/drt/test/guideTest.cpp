@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2022, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAS_BOOST_UNIT_TEST_LIBRARY
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+
+#include "fixture.h"
+#include "frDesign.h"
+#include "global.h"
+#include "gr/FlexGR.h"
+#include "io/io.h"
+
+using namespace fr;
+
+using GuideMap = std::map<frNet*, std::vector<frRect>, frBlockObjectComp>;
+
+// Fixture for the guides FlexGR hands to the parser
+struct GuideFixture : public Fixture
+{
+  GuideFixture()
+  {
+    auto tech = design->getTech();
+    addLayer(tech, "v1", dbTechLayerType::CUT);
+    addLayer(tech, "m2", dbTechLayerType::ROUTING);
+    BOTTOM_ROUTING_LAYER = 2;
+    TOP_ROUTING_LAYER = 4;
+
+    auto block = design->getTopBlock();
+    std::vector<frBoundary> bounds(1);
+    bounds[0].setPoints({Point(0, 0),
+                         Point(10000, 0),
+                         Point(10000, 10000),
+                         Point(0, 10000)});
+    block->setBoundaries(bounds);
+    frGCellPattern xgp, ygp;
+    xgp.setHorizontal(false);
+    xgp.setStartCoord(0);
+    xgp.setSpacing(1000);
+    xgp.setCount(10);
+    ygp.setHorizontal(true);
+    ygp.setStartCoord(0);
+    ygp.setSpacing(1000);
+    ygp.setCount(10);
+    block->setGCellPatterns({xgp, ygp});
+  }
+
+  void addGuide(frNet* net,
+                Point begin,
+                Point end,
+                frLayerNum beginLayer,
+                frLayerNum endLayer)
+  {
+    auto guide = std::make_unique<frGuide>();
+    guide->setPoints(begin, end);
+    guide->setBeginLayerNum(beginLayer);
+    guide->setEndLayerNum(endLayer);
+    guide->addToNet(net);
+    net->addGuide(std::move(guide));
+  }
+
+  // The guide file FlexGR used to write before it handed its guides over
+  // in memory: every net, with a unit guide per layer of a stacked via.
+  void writeGuideFile(const std::string& path)
+  {
+    auto block = design->getTopBlock();
+    std::ofstream out(path);
+    for (auto& net : block->getNets()) {
+      out << net->getName() << "\n(\n";
+      for (auto& guide : net->getGuides()) {
+        Point bp, ep;
+        guide->getPoints(bp, ep);
+        Point bpIdx, epIdx;
+        block->getGCellIdx(bp, bpIdx);
+        block->getGCellIdx(ep, epIdx);
+        Rect bbox, ebox;
+        block->getGCellBox(bpIdx, bbox);
+        block->getGCellBox(epIdx, ebox);
+        frLayerNum bNum = guide->getBeginLayerNum();
+        frLayerNum eNum = guide->getEndLayerNum();
+        if (bNum != eNum) {
+          for (auto lNum = std::min(bNum, eNum); lNum <= std::max(bNum, eNum);
+               lNum += 2) {
+            out << bbox.xMin() << " " << bbox.yMin() << " " << bbox.xMax()
+                << " " << bbox.yMax() << " "
+                << design->getTech()->getLayer(lNum)->getName() << "\n";
+          }
+        } else {
+          out << bbox.xMin() << " " << bbox.yMin() << " " << ebox.xMax()
+              << " " << ebox.yMax() << " "
+              << design->getTech()->getLayer(bNum)->getName() << "\n";
+        }
+      }
+      out << ")\n";
+    }
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(guide, GuideFixture);
+
+// The in-memory guides from FlexGR must be the ones readGuide gets from
+// the guide file, including no entry at all for nets without guides.
+BOOST_AUTO_TEST_CASE(flexgr_guides_match_file)
+{
+  frNet* n1 = makeNet("n1");
+  addGuide(n1, Point(500, 500), Point(3500, 500), 2, 2);
+  addGuide(n1, Point(3500, 500), Point(3500, 500), 2, 4);
+  addGuide(n1, Point(3500, 500), Point(3500, 7500), 4, 4);
+  makeNet("unrouted");
+  frNet* n2 = makeNet("n2");
+  addGuide(n2, Point(9500, 9500), Point(9500, 9500), 4, 2);
+
+  GuideMap inMemory;
+  FlexGR(design.get(), logger.get(), nullptr).getGuides(inMemory);
+
+  std::string path = "flexgr_guides_match_file.guide";
+  writeGuideFile(path);
+  std::string guideFile = GUIDE_FILE;
+  GUIDE_FILE = path;
+  io::Parser parser(design.get(), logger.get());
+  parser.readGuide();
+  GUIDE_FILE = guideFile;
+  std::remove(path.c_str());
+
+  const GuideMap& fromFile = parser.getGuides();
+  BOOST_TEST(inMemory.size() == 2);
+  BOOST_TEST(inMemory.size() == fromFile.size());
+  for (auto& [net, rects] : fromFile) {
+    BOOST_TEST_CONTEXT(net->getName())
+    {
+      auto it = inMemory.find(net);
+      BOOST_REQUIRE(it != inMemory.end());
+      BOOST_TEST(it->second.size() == rects.size());
+      for (size_t i = 0; i < std::min(rects.size(), it->second.size()); i++) {
+        BOOST_TEST(it->second[i].getLayerNum() == rects[i].getLayerNum());
+        BOOST_TEST((it->second[i].getBBox() == rects[i].getBBox()));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,29 @@
+# Access points saved with the db are reused by pin_access after read_db,
+# except for masters whose geometry changed or when the tech changed.
+source "helpers.tcl"
+
+file delete -force [make_result_file pa_reuse.odb]
+
+proc run_pin_access { step } {
+  set ::env(PA_REUSE_STEP) $step
+  set log [exec [info nameofexecutable] -no_init -no_splash -exit \
+             pa_reuse_run.tcl 2>@1]
+  if { [regexp {Reused access points of ([0-9]+) of} $log -> reused] } {
+    return $reused
+  }
+  return 0
+}
+
+set saved [run_pin_access save]
+set reloaded [run_pin_access reload]
+set master_changed [run_pin_access master]
+set tech_changed [run_pin_access tech]
+puts "reused: save $saved reload $reloaded master $master_changed tech $tech_changed"
+
+if { $saved != 0 || $reloaded == 0 || $master_changed >= $reloaded
+     || $tech_changed != 0 } {
+  puts "fail: unexpected access point reuse"
+  exit 1
+}
+puts "pass"
+exit 0
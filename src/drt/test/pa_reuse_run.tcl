@@ -0,0 +1,29 @@
+# One pin_access run of pa_reuse, selected by PA_REUSE_STEP.
+source "helpers.tcl"
+
+set db_file [make_result_file pa_reuse.odb]
+set step $::env(PA_REUSE_STEP)
+if { $step == "save" } {
+  read_lef gcd_nangate45_distributed/Nangate45_tech.lef
+  read_lef gcd_nangate45_distributed/Nangate45_stdcell.lef
+  read_def gcd_nangate45_distributed/gcd_nangate45_preroute.def
+} else {
+  read_db $db_file
+  set db [ord::get_db]
+  set tech [$db getTech]
+  if { $step == "master" } {
+    # Add an obstruction to one master.
+    odb::dbBox_create [$db findMaster INV_X1] [$tech findLayer metal4] \
+      0 0 140 140
+  } elseif { $step == "tech" } {
+    # Change a rule of a layer.
+    set layer [$tech findLayer metal10]
+    $layer setWidth [expr [$layer getWidth] + 20]
+  }
+}
+
+pin_access
+
+if { $step == "save" } {
+  write_db $db_file
+}
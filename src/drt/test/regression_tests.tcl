@@ -2,5 +2,7 @@ record_tests {
   ispd18_sample
 }
 record_pass_fail_tests {
+  check_drc_read_db
   gc_test
+  pa_reuse
 }
\ No newline at end of file
@@ -35,9 +35,11 @@
 
 #include <algorithm>
 #include <boost/lexical_cast.hpp>
+#include <limits>
 
 #include "graphics.h"
 #include "odb/dbShape.h"
+#include "utl/ThreadPool.h"
 
 namespace fin {
 
@@ -47,6 +49,9 @@ namespace pt = boost::property_tree;
 
 using namespace odb;
 
+// Size of the fill tiles in microns unless the layer sets density_window
+static constexpr double default_density_window = 100.0;
+
 // The rules for OPC or non-OPC shapes on a layer from the JSON config
 struct DensityFillShapesConfig
 {
@@ -61,6 +66,9 @@ struct DensityFillShapesConfig
 struct DensityFillLayerConfig
 {
   int space_to_outline;
+  // fill is computed per window and stops at the target density
+  int density_window;
+  double density_target;
   int num_masks;
   int opc_halo;
   bool has_opc;
@@ -69,6 +77,23 @@ struct DensityFillLayerConfig
   DensityFillShapesConfig non_opc;
 };
 
+// A fill shape waiting to be inserted into the db
+struct FillShape
+{
+  Rectangle rect;
+  int mask;
+  bool needs_opc;
+};
+
+// The fills made in one tile of a layer
+struct TileFills
+{
+  std::vector<FillShape> shapes;
+  int non_opc_areas = 0;
+  int opc_areas = 0;
+  int non_opc_fills = 0;
+};
+
 // Make a boost polygon representing a rectangle
 static Polygon90 makeRect(int x_lo, int y_lo, int x_hi, int y_hi)
 {
@@ -120,6 +145,22 @@ void DensityFill::readAndExpandLayers(dbTech* tech, pt::ptree& tree)
   for (auto& [name, layer] : layers) {
     DensityFillLayerConfig cfg;
     cfg.space_to_outline = getValue("space_to_outline", layer) * dbu;
+    if (layer.find("density_window") != layer.not_found()) {
+      cfg.density_window = getValue("density_window", layer) * dbu;
+      if (cfg.density_window <= 0) {
+        logger_->error(FIN, 11, "density_window must be positive.");
+      }
+    } else {
+      cfg.density_window = default_density_window * dbu;
+    }
+    if (layer.find("density_target") != layer.not_found()) {
+      cfg.density_target = getValue("density_target", layer);
+      if (cfg.density_target < 0 || cfg.density_target > 1) {
+        logger_->error(FIN, 12, "density_target must be between 0 and 1.");
+      }
+    } else {
+      cfg.density_target = 1.0;
+    }
 
     // non-OPC data
     {
@@ -204,10 +245,10 @@ void DensityFill::loadConfig(const char* cfg_filename, dbTech* tech)
   readAndExpandLayers(tech, tree);
 }
 
-// Insert into polygon_set any part of given shape on the given layer (shape may
+// Add to rects any part of given shape on the given layer (shape may
 // be a via)
 static void insertShape(const dbShape& shape,
-                        Polygon90Set& polygon_set,
+                        std::vector<Rectangle>& rects,
                         dbTechLayer* layer)
 {
   auto type = shape.getType();
@@ -233,34 +274,35 @@ static void insertShape(const dbShape& shape,
       dbShape::getViaBoxes(shape, boxes);
       for (auto& box : boxes) {
         if (box.getTechLayer() == layer) {
-          polygon_set.insert(
-              makeRect(box.xMin(), box.yMin(), box.xMax(), box.yMax()));
+          rects.emplace_back(box.xMin(), box.yMin(), box.xMax(), box.yMax());
         }
       }
       break;
     }
     case dbShape::SEGMENT:
       if (shape.getTechLayer() == layer) {
-        polygon_set.insert(
-            makeRect(shape.xMin(), shape.yMin(), shape.xMax(), shape.yMax()));
+        rects.emplace_back(
+            shape.xMin(), shape.yMin(), shape.xMax(), shape.yMax());
       }
       break;
     case dbShape::TECH_VIA_BOX:
     case dbShape::VIA_BOX:
       if (shape.getTechLayer() == layer) {
-        polygon_set.insert(
-            makeRect(shape.xMin(), shape.yMin(), shape.xMax(), shape.yMax()));
+        rects.emplace_back(
+            shape.xMin(), shape.yMin(), shape.xMax(), shape.yMax());
       }
       break;
   }
 }
 
-// Build a polygon set out of all the non-fill shape on the given layer
-// including wires, special wires, and instances' pins & OBS
-static Polygon90Set orNonFills(dbBlock* block, dbTechLayer* layer)
+// Collect all the non-fill shapes on the given layer including
+// wires, special wires, and instances' pins & OBS.  The shapes are
+// kept as plain rectangles; each tile only merges the ones near it.
+static std::vector<Rectangle> collectNonFills(dbBlock* block,
+                                              dbTechLayer* layer)
 {
-  Polygon90Set non_fill;  // The result
-  dbShape shape;          // Shared temp
+  std::vector<Rectangle> non_fill;  // The result
+  dbShape shape;                    // Shared temp
 
   // Get shapes from regular wires
   dbWireShapeItr shapes;
@@ -289,8 +331,8 @@ static Polygon90Set orNonFills(dbBlock* block, dbTechLayer* layer)
             insertShape(via_shape, non_fill, layer);
           }
         } else if (sbox->getTechLayer() == layer) {
-          non_fill.insert(
-              makeRect(sbox->xMin(), sbox->yMin(), sbox->xMax(), sbox->yMax()));
+          non_fill.emplace_back(
+              sbox->xMin(), sbox->yMin(), sbox->xMax(), sbox->yMax());
         }
       }
     }
@@ -344,15 +386,17 @@ static void prune(Polygon90Set& fill_area,
 }
 
 // Fill a polygon (area) on the given layer using the given configuration.
-// Num_masks is used to color the generated fills.
+// Num_masks is used to color the generated fills.  The fills are added to
+// fill_shapes as long as their total area fits in fill_budget.
 // filled_area, if given, is an OR of the generated fills without bloating
 static void fillPolygon(const Polygon90& area,
                         dbTechLayer* layer,
-                        dbBlock* block,
                         const DensityFillShapesConfig& cfg,
                         int num_masks,
                         bool needs_opc,
                         Graphics* graphics,
+                        int64_t& fill_budget,
+                        std::vector<FillShape>& fill_shapes,
                         Polygon90Set* filled_area = nullptr)
 {
   // Convert the area polygon to a polygon set as we will remove areas
@@ -414,46 +458,64 @@ static void fillPolygon(const Polygon90& area,
       Polygon90Set fills = all_fills & sub_fill_area;
       keep(fills, w * h, w * h, w - 1, w, h - 1, h);
 
-      Polygon90Set tmp_fills(fills);
-      all_iter_fills += bloat(tmp_fills, space_x, space_x, space_y, space_y);
-
-      // Insert fills into the db
+      // Save the fills that fit in the budget for insertion into the db
       std::vector<Rectangle> polygons;
       fills.get_rectangles(polygons);
       const int num_mask = std::max(num_masks, 1);
       int cnt = 0;
+      Polygon90Set kept_fills;
       for (auto& f : polygons) {
-        int mask = cnt++ % num_mask + 1;
-        auto x_lo = xl(f);
-        auto y_lo = yl(f);
-        auto x_hi = xh(f);
-        auto y_hi = yh(f);
-        dbFill::create(block, needs_opc, mask, layer, x_lo, y_lo, x_hi, y_hi);
-        if (filled_area) {
-          *filled_area += makeRect(x_lo, y_lo, x_hi, y_hi);
+        if (fill_budget < (int64_t) w * h) {
+          break;
         }
+        fill_budget -= (int64_t) w * h;
+        int mask = cnt++ % num_mask + 1;
+        fill_shapes.push_back({f, mask, needs_opc});
+        kept_fills += makeRect(xl(f), yl(f), xh(f), yh(f));
       }
+      if (filled_area) {
+        *filled_area += kept_fills;
+      }
+
+      // Only the kept fills block the area for the following shapes
+      all_iter_fills += bloat(kept_fills, space_x, space_x, space_y, space_y);
     }
     // Remove filled area from use by future shapes
     fill_area -= all_iter_fills;
   }
 }
 
-// Fill the given layer
-void DensityFill::fillLayer(dbBlock* block,
-                            dbTechLayer* layer,
-                            const odb::Rect& fill_bounds_rect)
+// Fill one tile of a layer.  Fills are only made inside fill_bounds while
+// the density target applies to the whole window.  The non-fill shapes are
+// the ones within the halo of the tile.
+static void fillTile(const Rectangle& window,
+                     const Rectangle& fill_bounds_rect,
+                     const std::vector<Rectangle>& non_fill_rects,
+                     const std::vector<int>& tile_rects,
+                     dbTechLayer* layer,
+                     const DensityFillLayerConfig& cfg,
+                     Graphics* graphics,
+                     TileFills& tile_fills)
 {
-  logger_->info(FIN, 3, "Filling layer {}.", layer->getConstName());
-
-  Polygon90Set non_fill = orNonFills(block, layer);
-
-  auto fill_bounds = makeRect(fill_bounds_rect.xMin(),
-                              fill_bounds_rect.yMin(),
-                              fill_bounds_rect.xMax(),
-                              fill_bounds_rect.yMax());
+  Polygon90Set non_fill;
+  for (int idx : tile_rects) {
+    const Rectangle& rect = non_fill_rects[idx];
+    non_fill.insert(makeRect(xl(rect), yl(rect), xh(rect), yh(rect)));
+  }
 
-  const DensityFillLayerConfig& cfg = layers_[layer];
+  auto fill_bounds = makeRect(xl(fill_bounds_rect),
+                              yl(fill_bounds_rect),
+                              xh(fill_bounds_rect),
+                              yh(fill_bounds_rect));
+
+  // Fill no more than the density target allows in this window.
+  int64_t fill_budget = std::numeric_limits<int64_t>::max();
+  if (cfg.density_target < 1) {
+    Polygon90Set metal
+        = non_fill
+          & makeRect(xl(window), yl(window), xh(window), yh(window));
+    fill_budget = cfg.density_target * area(window) - area(metal);
+  }
 
   std::vector<Polygon90> polygons;
 
@@ -461,28 +523,29 @@ void DensityFill::fillLayer(dbBlock* block,
   Polygon90Set fill_area
       = fill_bounds - (non_fill + cfg.non_opc.space_to_non_fill);
 
-  if (graphics_) {
-    graphics_->status("Non-OPC Area");
-    graphics_->drawPolygon90Set(fill_area);
+  if (graphics) {
+    graphics->status("Non-OPC Area");
+    graphics->drawPolygon90Set(fill_area);
   }
 
-  prune(fill_area, layer, cfg.non_opc, graphics_.get());
+  prune(fill_area, layer, cfg.non_opc, graphics);
 
   fill_area.get(polygons);
-  logger_->info(FIN, 9, "Filling {} areas with non-OPC fill.", polygons.size());
+  tile_fills.non_opc_areas = polygons.size();
 
   Polygon90Set non_opc_fill_area;
   for (auto& polygon : polygons) {
     fillPolygon(polygon,
                 layer,
-                block,
                 cfg.non_opc,
                 cfg.num_masks,
                 false,
-                graphics_.get(),
+                graphics,
+                fill_budget,
+                tile_fills.shapes,
                 &non_opc_fill_area);
   }
-  logger_->info(FIN, 4, "Total fills: {}.", block->getFills().size());
+  tile_fills.non_opc_fills = tile_fills.shapes.size();
 
   if (!cfg.has_opc) {
     return;
@@ -492,27 +555,156 @@ void DensityFill::fillLayer(dbBlock* block,
       = fill_bounds - (non_fill + cfg.opc.space_to_non_fill)
         - (non_opc_fill_area + cfg.non_opc.space_to_fill);
 
-  if (graphics_) {
-    graphics_->status("OPC Area");
-    graphics_->drawPolygon90Set(opc_fill_area);
+  if (graphics) {
+    graphics->status("OPC Area");
+    graphics->drawPolygon90Set(opc_fill_area);
   }
 
-  prune(opc_fill_area, layer, cfg.opc, graphics_.get());
+  prune(opc_fill_area, layer, cfg.opc, graphics);
 
   polygons.clear();
   opc_fill_area.get(polygons);
-  logger_->info(FIN, 5, "Filling {} areas with OPC fill.", polygons.size());
+  tile_fills.opc_areas = polygons.size();
   for (auto& polygon : polygons) {
-    fillPolygon(
-        polygon, layer, block, cfg.opc, cfg.num_masks, true, graphics_.get());
+    fillPolygon(polygon,
+                layer,
+                cfg.opc,
+                cfg.num_masks,
+                true,
+                graphics,
+                fill_budget,
+                tile_fills.shapes);
   }
 
-  logger_->info(FIN, 6, "Total fills: {}.", block->getFills().size());
+  if (graphics) {
+    graphics->status("OPC Area");
+    graphics->drawPolygon90Set(opc_fill_area);
+  }
+}
+
+// Fill the given layer.  The layer is split into tiles of the density
+// window size that are filled independently on the thread pool.  Fills
+// keep half the fill spacing away from the tile edges so that the fills
+// of neighboring tiles are legal together.  The fills are inserted into
+// the db a batch of tiles at a time to bound memory.
+void DensityFill::fillLayer(dbBlock* block,
+                            dbTechLayer* layer,
+                            const odb::Rect& fill_bounds_rect)
+{
+  logger_->info(FIN, 3, "Filling layer {}.", layer->getConstName());
 
-  if (graphics_) {
-    graphics_->status("OPC Area");
-    graphics_->drawPolygon90Set(opc_fill_area);
+  const DensityFillLayerConfig& cfg = layers_[layer];
+  const int fills_before = block->getFills().size();
+  const std::vector<Rectangle> non_fill = collectNonFills(block, layer);
+
+  auto [space_x, space_y] = getSpacing(layer, cfg.non_opc);
+  space_x = std::max(space_x, cfg.non_opc.space_to_fill);
+  space_y = std::max(space_y, cfg.non_opc.space_to_fill);
+  int halo = cfg.non_opc.space_to_non_fill;
+  if (cfg.has_opc) {
+    auto [opc_space_x, opc_space_y] = getSpacing(layer, cfg.opc);
+    space_x = std::max(space_x, opc_space_x);
+    space_y = std::max(space_y, opc_space_y);
+    halo = std::max(halo, cfg.opc.space_to_non_fill);
   }
+  const int margin_x = (space_x + 1) / 2;
+  const int margin_y = (space_y + 1) / 2;
+
+  const int x_min = fill_bounds_rect.xMin();
+  const int y_min = fill_bounds_rect.yMin();
+  const int x_max = fill_bounds_rect.xMax();
+  const int y_max = fill_bounds_rect.yMax();
+  const int window = cfg.density_window;
+  const int cols = std::max(1, (x_max - x_min + window - 1) / window);
+  const int rows = std::max(1, (y_max - y_min + window - 1) / window);
+
+  // Bucket the non-fill shapes by the tiles whose halo they touch.
+  std::vector<std::vector<int>> tile_rects(cols * rows);
+  for (int i = 0; i < non_fill.size(); i++) {
+    const Rectangle& rect = non_fill[i];
+    const int col_lo = std::max(0, (xl(rect) - halo - x_min) / window);
+    const int col_hi = std::min(cols - 1, (xh(rect) + halo - x_min) / window);
+    const int row_lo = std::max(0, (yl(rect) - halo - y_min) / window);
+    const int row_hi = std::min(rows - 1, (yh(rect) + halo - y_min) / window);
+    for (int row = row_lo; row <= row_hi; row++) {
+      for (int col = col_lo; col <= col_hi; col++) {
+        tile_rects[row * cols + col].push_back(i);
+      }
+    }
+  }
+
+  utl::ThreadPool& pool = utl::ThreadPool::get();
+  // Debug graphics can only be drawn from one thread.
+  const int max_threads = graphics_ ? 1 : 0;
+  const int tile_count = cols * rows;
+  const int batch_size = 4 * pool.threadCount();
+  int non_opc_areas = 0;
+  int opc_areas = 0;
+  int non_opc_fills = 0;
+  std::vector<TileFills> batch_fills;
+  for (int first = 0; first < tile_count; first += batch_size) {
+    const int last = std::min(first + batch_size, tile_count);
+    batch_fills.assign(last - first, TileFills());
+    pool.parallelFor(
+        first,
+        last,
+        [&](int tile) {
+          const int col = tile % cols;
+          const int row = tile / cols;
+          const int win_x_lo = x_min + col * window;
+          const int win_y_lo = y_min + row * window;
+          const int win_x_hi = std::min(x_max, win_x_lo + window);
+          const int win_y_hi = std::min(y_max, win_y_lo + window);
+          const Rectangle win(win_x_lo, win_y_lo, win_x_hi, win_y_hi);
+          const int fill_x_lo = (col > 0) ? win_x_lo + margin_x : win_x_lo;
+          const int fill_y_lo = (row > 0) ? win_y_lo + margin_y : win_y_lo;
+          const int fill_x_hi
+              = (col < cols - 1) ? win_x_hi - margin_x : win_x_hi;
+          const int fill_y_hi
+              = (row < rows - 1) ? win_y_hi - margin_y : win_y_hi;
+          if (fill_x_lo >= fill_x_hi || fill_y_lo >= fill_y_hi) {
+            return;
+          }
+          const Rectangle fill_bounds(
+              fill_x_lo, fill_y_lo, fill_x_hi, fill_y_hi);
+          fillTile(win,
+                   fill_bounds,
+                   non_fill,
+                   tile_rects[tile],
+                   layer,
+                   cfg,
+                   graphics_.get(),
+                   batch_fills[tile - first]);
+        },
+        max_threads);
+
+    // Insert the fills into the db in tile order
+    for (const TileFills& tile_fills : batch_fills) {
+      for (const FillShape& fill : tile_fills.shapes) {
+        dbFill::create(block,
+                       fill.needs_opc,
+                       fill.mask,
+                       layer,
+                       xl(fill.rect),
+                       yl(fill.rect),
+                       xh(fill.rect),
+                       yh(fill.rect));
+      }
+      non_opc_areas += tile_fills.non_opc_areas;
+      opc_areas += tile_fills.opc_areas;
+      non_opc_fills += tile_fills.non_opc_fills;
+    }
+  }
+
+  logger_->info(FIN, 9, "Filling {} areas with non-OPC fill.", non_opc_areas);
+  logger_->info(FIN, 4, "Total fills: {}.", fills_before + non_opc_fills);
+
+  if (!cfg.has_opc) {
+    return;
+  }
+
+  logger_->info(FIN, 5, "Filling {} areas with OPC fill.", opc_areas);
+  logger_->info(FIN, 6, "Total fills: {}.", block->getFills().size());
 }
 
 // Fill the design according to the given cfg file
@@ -39,6 +39,7 @@
 #include "routeBase.h" 
 #include "timingBase.h"
 #include "utl/Logger.h"
+#include "utl/Tracer.h"
 #include "rsz/Resizer.hh"
 #include "odb/db.h"
 #include "plot.h"
@@ -174,6 +175,7 @@ void Replace::setLogger(utl::Logger* logger) {
 
 void Replace::doIncrementalPlace()
 {
+  utl::TraceScope trace(GPL, "incremental_place");
   PlacerBaseVars pbVars;
   pbVars.padLeft = padLeft_;
   pbVars.padRight = padRight_;
@@ -231,6 +233,7 @@ void Replace::doIncrementalPlace()
 
 void Replace::doInitialPlace()
 {
+  utl::TraceScope trace(GPL, "initial_place");
 
   log_->setDebugLevel(GPL, "replace", verbose_);
 
@@ -332,6 +335,7 @@ void Replace::initNesterovPlace() {
 }
 
 int Replace::doNesterovPlace(int start_iter) {
+  utl::TraceScope trace(GPL, "nesterov_place");
   initNesterovPlace();
   if (timingDrivenMode_)
     rs_->resizeSlackPreamble();
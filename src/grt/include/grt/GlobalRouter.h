@@ -169,6 +169,10 @@ class GlobalRouter
   // flow functions
   void readGuides(const char* file_name);  // just for display
   void writeGuides(const char* file_name);
+  // Guide boxes (in dbu) for db_net's route, the same ones writeGuides
+  // prints.  Lets the detailed router take the guides without a file.
+  std::vector<std::pair<odb::Rect, odb::dbTechLayer*>> getGuides(
+      odb::dbNet* db_net);
   std::vector<Net*> initFastRoute(int min_routing_layer, int max_routing_layer);
   void initFastRouteIncr(std::vector<Net*>& nets);
   void estimateRC();
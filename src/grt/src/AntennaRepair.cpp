@@ -43,13 +43,16 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "Net.h"
 #include "Pin.h"
 #include "grt/GlobalRouter.h"
+#include "odb/dbSpatialIndex.h"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 
 namespace grt {
 
@@ -69,73 +72,45 @@ int AntennaRepair::checkAntennaViolations(NetRouteMap& routing,
                                           int max_routing_layer,
                                           odb::dbMTerm* diode_mterm)
 {
-  odb::dbTech* tech = db_->getTech();
-
   arc_->load_antenna_rules();
 
   std::map<int, odb::dbTechVia*> default_vias
       = grouter_->getDefaultVias(max_routing_layer);
 
-  for (auto net_route : routing) {
-    odb::dbNet* db_net = net_route.first;
-    GRoute& route = net_route.second;
-    odb::dbWire* wire = odb::dbWire::create(db_net);
-    if (wire != nullptr) {
-      odb::dbWireEncoder wire_encoder;
-      wire_encoder.begin(wire);
-      odb::dbWireType wire_type = odb::dbWireType::ROUTED;
-
-      std::vector<GSegment> segments_to_wires;
-      for (GSegment& seg : route) {
-        if (std::abs(seg.init_layer - seg.final_layer) > 1) {
-          logger_->error(GRT, 68, "Global route segment not valid.");
-        }
-
-        if (std::find(segments_to_wires.begin(), segments_to_wires.end(), seg)
-            == segments_to_wires.end()) {
-          int x1 = seg.init_x;
-          int y1 = seg.init_y;
-          int x2 = seg.final_x;
-          int y2 = seg.final_y;
-          int l1 = seg.init_layer;
-          int l2 = seg.final_layer;
-
-          odb::dbTechLayer* layer = tech->findRoutingLayer(l1);
-
-          if (l1 == l2) {  // Add wire
-            if (x1 != x2 || y1 != y2) {
-              wire_encoder.newPath(layer, wire_type);
-              wire_encoder.addPoint(x1, y1);
-              wire_encoder.addPoint(x2, y2);
-              segments_to_wires.push_back(seg);
-            }
-          } else {  // Add via
-            int bottom_layer = (l1 < l2) ? l1 : l2;
-            wire_encoder.newPath(layer, wire_type);
-            wire_encoder.addPoint(x1, y1);
-            wire_encoder.addTechVia(default_vias[bottom_layer]);
-            segments_to_wires.push_back(seg);
-          }
-        }
-      }
-      wire_encoder.end();
+  const std::string diode_master = diode_mterm->getMaster()->getConstName();
+  const std::string diode_pin = diode_mterm->getConstName();
+
+  // Wires are created and destroyed serially, a batch of nets at a time.
+  // The antenna checker only reads the db, so the nets of a batch are
+  // checked in parallel.
+  utl::ThreadPool& pool = utl::ThreadPool::get();
+  const int batch_size = 256 * pool.threadCount();
+  std::vector<odb::dbNet*> nets;
+  std::vector<std::vector<ant::VINFO>> net_violations;
+  auto net_route = routing.begin();
+  while (net_route != routing.end()) {
+    nets.clear();
+    for (; net_route != routing.end() && nets.size() < batch_size;
+         ++net_route) {
+      odb::dbNet* db_net = net_route->first;
+      makeNetWire(db_net, net_route->second, default_vias);
+      nets.push_back(db_net);
+    }
 
-      odb::orderWires(db_net, false, false);
+    net_violations.assign(nets.size(), std::vector<ant::VINFO>());
+    pool.parallelFor(0, nets.size(), [&](int i) {
+      net_violations[i] = arc_->get_net_antenna_violations(
+          nets[i], diode_master, diode_pin);
+    });
 
-      std::vector<ant::VINFO> netViol = arc_->get_net_antenna_violations(
-          db_net,
-          diode_mterm->getMaster()->getConstName(),
-          diode_mterm->getConstName());
-      if (!netViol.empty()) {
-        antenna_violations_[db_net] = netViol;
+    for (int i = 0; i < nets.size(); i++) {
+      odb::dbNet* db_net = nets[i];
+      if (!net_violations[i].empty()) {
+        antenna_violations_[db_net] = net_violations[i];
         // This should be done with the db callbacks.
         grouter_->addDirtyNet(db_net);
       }
-
-      odb::dbWire::destroy(wire);
-    } else {
-      logger_->error(
-          GRT, 221, "Cannot create wire for net {}.", db_net->getConstName());
+      odb::dbWire::destroy(db_net->getWire());
     }
   }
 
@@ -143,11 +118,64 @@ int AntennaRepair::checkAntennaViolations(NetRouteMap& routing,
   return antenna_violations_.size();
 }
 
+void AntennaRepair::makeNetWire(odb::dbNet* db_net,
+                                GRoute& route,
+                                std::map<int, odb::dbTechVia*>& default_vias)
+{
+  odb::dbTech* tech = db_->getTech();
+  odb::dbWire* wire = odb::dbWire::create(db_net);
+  if (wire != nullptr) {
+    odb::dbWireEncoder wire_encoder;
+    wire_encoder.begin(wire);
+    odb::dbWireType wire_type = odb::dbWireType::ROUTED;
+
+    std::unordered_set<GSegment, GSegmentHash> segments_to_wires;
+    for (GSegment& seg : route) {
+      if (std::abs(seg.init_layer - seg.final_layer) > 1) {
+        logger_->error(GRT, 68, "Global route segment not valid.");
+      }
+
+      if (segments_to_wires.find(seg) == segments_to_wires.end()) {
+        int x1 = seg.init_x;
+        int y1 = seg.init_y;
+        int x2 = seg.final_x;
+        int y2 = seg.final_y;
+        int l1 = seg.init_layer;
+        int l2 = seg.final_layer;
+
+        odb::dbTechLayer* layer = tech->findRoutingLayer(l1);
+
+        if (l1 == l2) {  // Add wire
+          if (x1 != x2 || y1 != y2) {
+            wire_encoder.newPath(layer, wire_type);
+            wire_encoder.addPoint(x1, y1);
+            wire_encoder.addPoint(x2, y2);
+            segments_to_wires.insert(seg);
+          }
+        } else {  // Add via
+          int bottom_layer = (l1 < l2) ? l1 : l2;
+          wire_encoder.newPath(layer, wire_type);
+          wire_encoder.addPoint(x1, y1);
+          wire_encoder.addTechVia(default_vias[bottom_layer]);
+          segments_to_wires.insert(seg);
+        }
+      }
+    }
+    wire_encoder.end();
+
+    odb::orderWires(db_net, false, false);
+  } else {
+    logger_->error(
+        GRT, 221, "Cannot create wire for net {}.", db_net->getConstName());
+  }
+}
+
 void AntennaRepair::repairAntennas(odb::dbMTerm* diode_mterm)
 {
   int site_width = -1;
   int cnt = diode_insts_.size();
-  r_tree fixed_insts;
+  // Diodes placed by this call; they block the ones placed after them.
+  std::set<odb::dbInst*> new_diodes;
 
   auto rows = block_->getRows();
   for (odb::dbRow* db_row : rows) {
@@ -163,7 +191,6 @@ void AntennaRepair::repairAntennas(odb::dbMTerm* diode_mterm)
   }
 
   setInstsPlacementStatus(odb::dbPlacementStatus::FIRM);
-  getFixedInstances(fixed_insts);
 
   for (auto const& violation : antenna_violations_) {
     odb::dbNet* net = violation.first;
@@ -178,7 +205,7 @@ void AntennaRepair::repairAntennas(odb::dbMTerm* diode_mterm)
                       sink_iterm,
                       antenna_inst_name,
                       site_width,
-                      fixed_insts);
+                      new_diodes);
           cnt++;
         }
       }
@@ -216,7 +243,7 @@ void AntennaRepair::insertDiode(odb::dbNet* net,
                                 odb::dbITerm* sink_iterm,
                                 std::string antenna_inst_name,
                                 int site_width,
-                                r_tree& fixed_insts)
+                                std::set<odb::dbInst*>& new_diodes)
 {
   const int max_legalize_itr = 50;
   bool legally_placed = false;
@@ -244,9 +271,8 @@ void AntennaRepair::insertDiode(odb::dbNet* net,
   odb::Rect core_area;
   block_->getCoreArea(core_area);
 
-  // Use R-tree to check if diode will not overlap or cause 1-site spacing with
-  // other cells
-  std::vector<value> overlap_insts;
+  // Use the block spatial index to check if diode will not overlap or cause
+  // 1-site spacing with other cells
   int legalize_itr = 0;
   while (!legally_placed && legalize_itr < max_legalize_itr) {
     if (place_at_left) {
@@ -265,17 +291,16 @@ void AntennaRepair::insertDiode(odb::dbNet* net,
     antenna_inst->setLocation(inst_loc_x + offset, inst_loc_y);
 
     odb::dbBox* instBox = antenna_inst->getBBox();
-    box box(point(instBox->xMin() - ((left_pad + right_pad) * site_width) + 1,
-                  instBox->yMin() + 1),
-            point(instBox->xMax() + ((left_pad + right_pad) * site_width) - 1,
-                  instBox->yMax() - 1));
-    fixed_insts.query(bgi::intersects(box), std::back_inserter(overlap_insts));
+    odb::Rect area(instBox->xMin() - ((left_pad + right_pad) * site_width) + 1,
+                   instBox->yMin() + 1,
+                   instBox->xMax() + ((left_pad + right_pad) * site_width) - 1,
+                   instBox->yMax() - 1);
 
-    if (overlap_insts.empty() && instBox->xMin() >= core_area.xMin()
+    if (!overlapsFixedInst(area, new_diodes)
+        && instBox->xMin() >= core_area.xMin()
         && instBox->xMax() <= core_area.xMax()) {
       legally_placed = true;
     }
-    overlap_insts.clear();
     legalize_itr++;
   }
 
@@ -303,29 +328,20 @@ void AntennaRepair::insertDiode(odb::dbNet* net,
 
   antenna_iterm->connect(net);
   diode_insts_.push_back(antenna_inst);
-
-  // Add diode to the R-tree of fixed instances
-  int fixed_inst_id = fixed_insts.size();
-  box b(point(inst_rect.xMin(), inst_rect.yMin()),
-        point(inst_rect.xMax(), inst_rect.yMax()));
-  value v(b, fixed_inst_id);
-  fixed_insts.insert(v);
-  fixed_inst_id++;
+  new_diodes.insert(antenna_inst);
 }
 
-void AntennaRepair::getFixedInstances(r_tree& fixed_insts)
+// FIRM instances and the diodes placed so far are fixed.
+bool AntennaRepair::overlapsFixedInst(const odb::Rect& area,
+                                      const std::set<odb::dbInst*>& new_diodes)
 {
-  int fixed_inst_id = 0;
-  for (odb::dbInst* inst : block_->getInsts()) {
-    if (inst->getPlacementStatus() == odb::dbPlacementStatus::FIRM) {
-      odb::dbBox* instBox = inst->getBBox();
-      box b(point(instBox->xMin(), instBox->yMin()),
-            point(instBox->xMax(), instBox->yMax()));
-      value v(b, fixed_inst_id);
-      fixed_insts.insert(v);
-      fixed_inst_id++;
+  for (odb::dbInst* inst : block_->getSpatialIndex()->findInsts(area)) {
+    if (inst->getPlacementStatus() == odb::dbPlacementStatus::FIRM
+        || new_diodes.find(inst) != new_diodes.end()) {
+      return true;
     }
   }
+  return false;
 }
 
 void AntennaRepair::setInstsPlacementStatus(
@@ -35,9 +35,7 @@
 
 #pragma once
 
-#include <boost/geometry.hpp>
-#include <boost/geometry/index/rtree.hpp>
-#include <boost/iterator/function_output_iterator.hpp>
+#include <set>
 #include <string>
 
 #include "ant/AntennaChecker.hh"
@@ -60,9 +58,6 @@ namespace utl {
 class Logger;
 }  // namespace utl
 
-namespace bg = boost::geometry;
-namespace bgi = boost::geometry::index;
-
 namespace grt {
 
 typedef std::map<odb::dbNet*, std::vector<ant::VINFO>> AntennaViolations;
@@ -93,21 +88,18 @@ class AntennaRepair
   void deleteFillerCells();
 
  private:
-  typedef int coord_type;
-  typedef bg::cs::cartesian coord_sys_type;
-  typedef bg::model::point<coord_type, 2, coord_sys_type> point;
-  typedef bg::model::box<point> box;
-  typedef std::pair<box, int> value;
-  typedef bgi::rtree<value, bgi::quadratic<8, 4>> r_tree;
-
+  void makeNetWire(odb::dbNet* db_net,
+                   GRoute& route,
+                   std::map<int, odb::dbTechVia*>& default_vias);
   void insertDiode(odb::dbNet* net,
                    odb::dbMTerm* diode_mterm,
                    odb::dbInst* sink_inst,
                    odb::dbITerm* sink_iterm,
                    std::string antenna_inst_name,
                    int site_width,
-                   r_tree& fixed_insts);
-  void getFixedInstances(r_tree& fixed_insts);
+                   std::set<odb::dbInst*>& new_diodes);
+  bool overlapsFixedInst(const odb::Rect& area,
+                         const std::set<odb::dbInst*>& new_diodes);
   void setInstsPlacementStatus(odb::dbPlacementStatus placement_status);
   odb::Rect getInstRect(odb::dbInst* inst, odb::dbITerm* iterm);
   bool diodeInRow(odb::Rect diode_rect);
@@ -68,6 +68,7 @@
 #include "sta/Set.hh"
 #include "stt/SteinerTreeBuilder.h"
 #include "utl/Logger.h"
+#include "utl/Tracer.h"
 #include "utl/algorithms.h"
 
 namespace grt {
@@ -192,6 +193,7 @@ void GlobalRouter::applyAdjustments(int min_routing_layer,
 
 void GlobalRouter::globalRoute()
 {
+  utl::TraceScope trace(GRT, "global_route");
   clear();
   block_ = db_->getChip()->getBlock();
 
@@ -242,13 +244,26 @@ void GlobalRouter::repairAntennas(sta::LibertyPort* diode_port, int iterations)
 
   int violations_cnt = -1;
   int itr = 0;
+  // Nets rerouted by the previous iteration. The other nets keep the
+  // routes that were already checked, so they cannot have violations.
+  std::set<odb::dbNet*> rerouted_nets;
   while (violations_cnt != 0 && itr < iterations) {
     if (verbose_)
       logger_->info(GRT, 6, "Repairing antennas, iteration {}.", itr + 1);
 
     // Antenna checker requires local connections so copy the routes
     // so the originals are not side-effected.
-    NetRouteMap routes = routes_;
+    NetRouteMap routes;
+    if (itr == 0) {
+      routes = routes_;
+    } else {
+      for (odb::dbNet* db_net : rerouted_nets) {
+        auto net_route = routes_.find(db_net);
+        if (net_route != routes_.end()) {
+          routes.insert(*net_route);
+        }
+      }
+    }
     addLocalConnections(routes);
     violations_cnt = antenna_repair.checkAntennaViolations(
         routes, max_routing_layer_, diode_mterm);
@@ -263,6 +278,8 @@ void GlobalRouter::repairAntennas(sta::LibertyPort* diode_port, int iterations)
             GRT, 15, "{} diodes inserted.", antenna_repair.getDiodesCount());
 
       antenna_repair.legalizePlacedCells();
+      // The violating nets and the nets moved by legalization are dirty.
+      rerouted_nets = dirty_nets_;
       incr_groute.updateRoutes();
     }
     antenna_repair.clearViolations();
@@ -1491,14 +1508,9 @@ void GlobalRouter::writeGuides(const char* file_name)
     guide_file.close();
     logger_->error(GRT, 73, "Guides file could not be opened.");
   }
-  odb::dbTechLayer* ph_layer_final = nullptr;
-
-  int offset_x = grid_origin_.x();
-  int offset_y = grid_origin_.y();
 
   if (verbose_)
     logger_->info(GRT, 14, "Routed nets: {}", routes_.size());
-  int final_layer;
 
   // Sort nets so guide file net order is consistent.
   std::vector<odb::dbNet*> sorted_nets;
@@ -1511,78 +1523,95 @@ void GlobalRouter::writeGuides(const char* file_name)
             });
 
   for (odb::dbNet* db_net : sorted_nets) {
-    GRoute& route = routes_[db_net];
-    if (!route.empty()) {
-      guide_file << db_net->getConstName() << "\n";
-      guide_file << "(\n";
-      std::vector<odb::Rect> guide_box;
-      final_layer = -1;
-      for (GSegment& segment : route) {
-        if (segment.init_layer != final_layer && final_layer != -1) {
-          mergeBox(guide_box);
-          for (odb::Rect& guide : guide_box) {
-            guide_file << guide.xMin() + offset_x << " "
-                       << guide.yMin() + offset_y << " "
-                       << guide.xMax() + offset_x << " "
-                       << guide.yMax() + offset_y << " "
-                       << ph_layer_final->getName() << "\n";
-          }
-          guide_box.clear();
-          final_layer = segment.init_layer;
-        }
-        if (segment.init_layer == segment.final_layer) {
-          if (segment.init_layer < min_routing_layer_
-              && segment.init_x != segment.final_x
-              && segment.init_y != segment.final_y) {
-            logger_->error(GRT,
-                           74,
-                           "Routing with guides in blocked metal for net {}.",
-                           db_net->getConstName());
-          }
+    auto it = routes_.find(db_net);
+    if (it == routes_.end() || it->second.empty()) {
+      continue;
+    }
+    guide_file << db_net->getConstName() << "\n";
+    guide_file << "(\n";
+    for (auto& [guide, layer] : getGuides(db_net)) {
+      guide_file << guide.xMin() << " " << guide.yMin() << " " << guide.xMax()
+                 << " " << guide.yMax() << " " << layer->getName() << "\n";
+    }
+    guide_file << ")\n";
+  }
 
-          guide_box.push_back(globalRoutingToBox(segment));
-          ph_layer_final = routing_layers_[segment.final_layer];
-          final_layer = segment.final_layer;
-        } else {
-          if (abs(segment.final_layer - segment.init_layer) > 1) {
-            logger_->error(GRT,
-                           75,
-                           "Connection between non-adjacent layers in net {}.",
-                           db_net->getConstName());
-          } else {
-            odb::dbTechLayer* ph_layer_init;
-            ph_layer_init = routing_layers_[segment.init_layer];
-            ph_layer_final = routing_layers_[segment.final_layer];
-
-            final_layer = segment.final_layer;
-            odb::Rect box;
-            guide_box.push_back(globalRoutingToBox(segment));
-            mergeBox(guide_box);
-            for (odb::Rect& guide : guide_box) {
-              guide_file << guide.xMin() + offset_x << " "
-                         << guide.yMin() + offset_y << " "
-                         << guide.xMax() + offset_x << " "
-                         << guide.yMax() + offset_y << " "
-                         << ph_layer_init->getName() << "\n";
-            }
-            guide_box.clear();
+  guide_file.close();
+}
 
-            guide_box.push_back(globalRoutingToBox(segment));
-          }
-        }
-      }
+std::vector<std::pair<odb::Rect, odb::dbTechLayer*>> GlobalRouter::getGuides(
+    odb::dbNet* db_net)
+{
+  std::vector<std::pair<odb::Rect, odb::dbTechLayer*>> guides;
+  auto it = routes_.find(db_net);
+  if (it == routes_.end()) {
+    return guides;
+  }
+  GRoute& route = it->second;
+
+  odb::dbTechLayer* ph_layer_final = nullptr;
+
+  int offset_x = grid_origin_.x();
+  int offset_y = grid_origin_.y();
+
+  auto addGuides = [&](std::vector<odb::Rect>& guide_box,
+                       odb::dbTechLayer* layer) {
+    for (odb::Rect& guide : guide_box) {
+      guides.emplace_back(odb::Rect(guide.xMin() + offset_x,
+                                    guide.yMin() + offset_y,
+                                    guide.xMax() + offset_x,
+                                    guide.yMax() + offset_y),
+                          layer);
+    }
+  };
+
+  std::vector<odb::Rect> guide_box;
+  int final_layer = -1;
+  for (GSegment& segment : route) {
+    if (segment.init_layer != final_layer && final_layer != -1) {
       mergeBox(guide_box);
-      for (odb::Rect& guide : guide_box) {
-        guide_file << guide.xMin() + offset_x << " " << guide.yMin() + offset_y
-                   << " " << guide.xMax() + offset_x << " "
-                   << guide.yMax() + offset_y << " "
-                   << ph_layer_final->getName() << "\n";
+      addGuides(guide_box, ph_layer_final);
+      guide_box.clear();
+      final_layer = segment.init_layer;
+    }
+    if (segment.init_layer == segment.final_layer) {
+      if (segment.init_layer < min_routing_layer_
+          && segment.init_x != segment.final_x
+          && segment.init_y != segment.final_y) {
+        logger_->error(GRT,
+                       74,
+                       "Routing with guides in blocked metal for net {}.",
+                       db_net->getConstName());
+      }
+
+      guide_box.push_back(globalRoutingToBox(segment));
+      ph_layer_final = routing_layers_[segment.final_layer];
+      final_layer = segment.final_layer;
+    } else {
+      if (abs(segment.final_layer - segment.init_layer) > 1) {
+        logger_->error(GRT,
+                       75,
+                       "Connection between non-adjacent layers in net {}.",
+                       db_net->getConstName());
+      } else {
+        odb::dbTechLayer* ph_layer_init;
+        ph_layer_init = routing_layers_[segment.init_layer];
+        ph_layer_final = routing_layers_[segment.final_layer];
+
+        final_layer = segment.final_layer;
+        guide_box.push_back(globalRoutingToBox(segment));
+        mergeBox(guide_box);
+        addGuides(guide_box, ph_layer_init);
+        guide_box.clear();
+
+        guide_box.push_back(globalRoutingToBox(segment));
       }
-      guide_file << ")\n";
     }
   }
+  mergeBox(guide_box);
+  addGuides(guide_box, ph_layer_final);
 
-  guide_file.close();
+  return guides;
 }
 
 RoutingTracks GlobalRouter::getRoutingTracksByIndex(int layer)
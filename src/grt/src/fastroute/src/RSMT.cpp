@@ -36,6 +36,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <vector>
 
 #include "DataType.h"
 #include "FastRoute.h"
@@ -657,6 +658,27 @@ void FastRouteCore::gen_brk_RSMT(const bool congestionDriven,
 
   const int flute_accuracy = 2;
 
+  // Trees for nets with an alpha only depend on the net pins, not on
+  // the congestion updated by the loop below, so they are built up front
+  // in one batch.
+  std::vector<int> alpha_tree_index(num_valid_nets_, -1);
+  std::vector<odb::dbNet*> alpha_nets;
+  std::vector<std::vector<int>> alpha_xs;
+  std::vector<std::vector<int>> alpha_ys;
+  std::vector<int> alpha_drvr_indices;
+  for (int i = 0; i < num_valid_nets_; i++) {
+    FrNet* net = nets_[i];
+    if (stt_builder_->getAlpha(net->db_net) > 0.0) {
+      alpha_tree_index[i] = alpha_nets.size();
+      alpha_nets.push_back(net->db_net);
+      alpha_xs.push_back(net->pinX);
+      alpha_ys.push_back(net->pinY);
+      alpha_drvr_indices.push_back(net->driver_idx);
+    }
+  }
+  std::vector<Tree> alpha_trees = stt_builder_->makeSteinerTrees(
+      alpha_nets, alpha_xs, alpha_ys, alpha_drvr_indices);
+
   for (int i = 0; i < num_valid_nets_; i++) {
     FrNet* net = nets_[i];
     float coeffV = 1.36;
@@ -704,10 +726,8 @@ void FastRouteCore::gen_brk_RSMT(const bool congestionDriven,
 
     // check net alpha because FastRoute has a special implementation of flute
     // TODO: move this flute implementation to SteinerTreeBuilder
-    const float net_alpha = stt_builder_->getAlpha(net->db_net);
-    if (net_alpha > 0.0) {
-      rsmt = stt_builder_->makeSteinerTree(
-          net->db_net, net->pinX, net->pinY, net->driver_idx);
+    if (alpha_tree_index[i] >= 0) {
+      rsmt = alpha_trees[alpha_tree_index[i]];
     } else {
       if (congestionDriven) {
         // call congestion driven flute to generate RSMT
@@ -44,3 +44,7 @@ record_tests {
   tracks2
   tracks3
 }
+
+record_pass_fail_tests {
+  repair_antennas_threads
+}
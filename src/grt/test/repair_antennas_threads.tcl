@@ -0,0 +1,37 @@
+# repair_antennas checks the nets on several threads. The diodes and
+# guides must be the ones of repair_antennas1, which runs on one thread.
+source "helpers.tcl"
+read_liberty "sky130hs/sky130hs_tt.lib"
+read_lef "sky130hs/sky130hs.tlef"
+read_lef "sky130hs/sky130hs_std_cell.lef"
+
+read_def "gcd_sky130.def"
+
+set_thread_count 4
+
+set_placement_padding -global -left 2 -right 2
+
+set guide_file [make_result_file repair_antennas_threads.guide]
+set def_file [make_result_file repair_antennas_threads.def]
+
+set_global_routing_layer_adjustment met2-met5 0.15
+
+set_routing_layers -signal met1-met5
+
+global_route -verbose
+
+repair_antennas sky130_fd_sc_hs__diode_2/DIODE
+
+set_placement_padding -global -left 0 -right 0
+check_placement
+
+write_guides $guide_file
+write_def $def_file
+
+if { [diff_files repair_antennas1.guideok $guide_file]
+     || [diff_files repair_antennas1.defok $def_file] } {
+  puts "fail: 4 threads differ from 1 thread"
+  exit 1
+}
+puts "pass"
+exit 0
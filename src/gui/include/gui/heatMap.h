@@ -32,9 +32,7 @@
 
 #pragma once
 
-#include <boost/geometry.hpp>
-#include <boost/geometry/index/rtree.hpp>
-#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/multi_array.hpp>
 
 #include <array>
 #include <functional>
@@ -58,9 +56,6 @@ namespace gui {
 class HeatMapRenderer;
 class HeatMapSetup;
 
-namespace bg = boost::geometry;
-namespace bgi = boost::geometry::index;
-
 class HeatMapDataSource
 {
  public:
@@ -84,9 +79,8 @@ class HeatMapDataSource
     double value;
     Painter::Color color;
   };
-  using Point = bg::model::d2::point_xy<int, bg::cs::cartesian>;
-  using Box = bg::model::box<Point>;
-  using Map = bgi::rtree<std::pair<Box, std::shared_ptr<MapColor>>, bgi::quadratic<16>>;
+  // grid cells indexed by [x][y]
+  using Map = boost::multi_array<MapColor, 2>;
 
   using MapSetting = std::variant<MapSettingBoolean, MapSettingMultiChoice>;
 
@@ -162,7 +156,15 @@ class HeatMapDataSource
   void update() { destroyMap(); }
   void ensureMap();
   void destroyMap();
-  const Map& getMap() const { return map_; }
+  // level 0 is the full resolution map, each further level halves it
+  const Map& getMap(int level = 0) const;
+  int getMapLevel(double pixels_per_dbu) const;
+  bool getMapRange(int level,
+                   const odb::Rect& rect,
+                   int& x_lo,
+                   int& x_hi,
+                   int& y_lo,
+                   int& y_hi) const;
   bool isPopulated() const { return populated_; }
 
   const std::vector<std::pair<int, double>> getLegendValues() const;
@@ -188,6 +190,8 @@ class HeatMapDataSource
   odb::dbBlock* getBlock() const { return block_; }
 
   void setupMap();
+  void rasterizeMap();
+  void buildMapLevels();
   virtual bool populateMap() = 0;
   void addToMap(const odb::Rect& region, double value);
   virtual void combineMapData(bool base_has_value,
@@ -216,6 +220,7 @@ class HeatMapDataSource
   const std::string short_name_;
   const std::string settings_group_;
   bool destroy_map_;
+  bool regrid_map_;
   bool use_dbu_;
 
   bool populated_;
@@ -236,7 +241,17 @@ class HeatMapDataSource
   bool show_numbers_;
   bool show_legend_;
 
+  // contributions from populateMap, kept so a new grid does not need to
+  // query the database again
+  std::vector<std::pair<odb::Rect, double>> map_data_;
   Map map_;
+  std::vector<Map> map_levels_;
+  odb::Rect map_bounds_;
+  int map_dx_;
+  int map_dy_;
+
+  // smallest size of a drawn cell in pixels
+  static constexpr double min_cell_pixels_ = 2.0;
 
   std::unique_ptr<HeatMapRenderer> renderer_;
   HeatMapSetup* setup_;
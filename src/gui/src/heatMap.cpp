@@ -31,6 +31,7 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 #include "gui/heatMap.h"
 #include "heatMapSetup.h"
 
@@ -48,6 +49,7 @@ HeatMapDataSource::HeatMapDataSource(utl::Logger* logger,
     short_name_(short_name),
     settings_group_(settings_group),
     destroy_map_(true),
+    regrid_map_(false),
     use_dbu_(false),
     populated_(false),
     colors_correct_(false),
@@ -65,7 +67,12 @@ HeatMapDataSource::HeatMapDataSource(utl::Logger* logger,
     reverse_log_(false),
     show_numbers_(false),
     show_legend_(false),
+    map_data_(),
     map_(),
+    map_levels_(),
+    map_bounds_(),
+    map_dx_(0),
+    map_dy_(0),
     renderer_(std::make_unique<HeatMapRenderer>(*this)),
     setup_(nullptr),
     color_generator_(SpectrumGenerator(100.0))
@@ -100,20 +107,25 @@ void HeatMapDataSource::dumpToFile(const std::string& file)
   const double dbu_to_micron = block_->getDbUnitsPerMicron();
 
   csv << "x0,y0,x1,y1,value" << std::endl;
-  for (const auto& [box, box_value] : map_) {
-    if (!box_value->has_value) {
-      continue;
+  const int x_count = map_.shape()[0];
+  const int y_count = map_.shape()[1];
+  for (int x = 0; x < x_count; x++) {
+    for (int y = 0; y < y_count; y++) {
+      const auto& box_value = map_[x][y];
+      if (!box_value.has_value) {
+        continue;
+      }
+      const odb::Rect& box_rect = box_value.rect;
+      const double scaled_value = convertPercentToValue(box_value.value);
+
+      csv << std::defaultfloat << std::setprecision(4);
+      csv << box_rect.xMin() / dbu_to_micron << ",";
+      csv << box_rect.yMin() / dbu_to_micron << ",";
+      csv << box_rect.xMax() / dbu_to_micron << ",";
+      csv << box_rect.yMax() / dbu_to_micron << ",";
+      csv << std::scientific << std::setprecision(6);
+      csv << scaled_value << std::endl;
     }
-    const odb::Rect& box_rect = box_value->rect;
-    const double scaled_value = convertPercentToValue(box_value->value);
-
-    csv << std::defaultfloat << std::setprecision(4);
-    csv << box_rect.xMin() / dbu_to_micron << ",";
-    csv << box_rect.yMin() / dbu_to_micron << ",";
-    csv << box_rect.xMax() / dbu_to_micron << ",";
-    csv << box_rect.yMax() / dbu_to_micron << ",";
-    csv << std::scientific << std::setprecision(6);
-    csv << scaled_value << std::endl;
   }
 
   csv.close();
@@ -177,7 +189,10 @@ void HeatMapDataSource::setGridSizes(double x, double y)
   }
 
   if (changed) {
-    destroyMap();
+    // the data does not depend on the grid, so only rasterize it again
+    regrid_map_ = true;
+
+    redraw();
   }
 }
 
@@ -321,21 +336,47 @@ void HeatMapDataSource::setSettings(const Renderer::Settings& settings)
 
 void HeatMapDataSource::addToMap(const odb::Rect& region, double value)
 {
-  Box query(Point(region.xMin(), region.yMin()), Point(region.xMax(), region.yMax()));
-  for (auto it = map_.qbegin(bgi::intersects(query)); it != map_.qend(); it++) {
-    auto* map_pt = it->second.get();
-    odb::Rect intersection;
-    map_pt->rect.intersection(region, intersection);
+  map_data_.push_back({region, value});
+}
 
-    const double intersect_area = intersection.area();
-    const double value_area = region.area();
-    const double region_area = map_pt->rect.area();
+bool HeatMapDataSource::getMapRange(int level,
+                                    const odb::Rect& rect,
+                                    int& x_lo,
+                                    int& x_hi,
+                                    int& y_lo,
+                                    int& y_hi) const
+{
+  const Map& map = getMap(level);
+  const int x_count = map.shape()[0];
+  const int y_count = map.shape()[1];
+  if (x_count == 0 || y_count == 0) {
+    return false;
+  }
 
-    combineMapData(map_pt->has_value, map_pt->value, value, value_area, intersect_area, region_area);
-    map_pt->has_value = true;
+  // cells that touch rect are included, as they would be by an rtree
+  // intersects query
+  auto range = [](int64_t lo, int64_t hi, int64_t origin, int64_t end, int64_t step, int count, int& idx_lo, int& idx_hi) {
+    if (lo > end) {
+      // last cell is clipped to the bounds
+      return false;
+    }
+    lo -= origin;
+    hi -= origin;
+    int64_t first = lo / step - ((lo % step) < 0 ? 1 : 0);
+    if (first * step == lo) {
+      // previous cell ends on lo
+      first--;
+    }
+    const int64_t last = hi / step - ((hi % step) < 0 ? 1 : 0);
+    idx_lo = std::max<int64_t>(first, 0);
+    idx_hi = std::min<int64_t>(last, count - 1);
+    return idx_lo <= idx_hi;
+  };
 
-    markColorsInvalid();
-  }
+  const int64_t dx = static_cast<int64_t>(map_dx_) << level;
+  const int64_t dy = static_cast<int64_t>(map_dy_) << level;
+  return range(rect.xMin(), rect.xMax(), map_bounds_.xMin(), map_bounds_.xMax(), dx, x_count, x_lo, x_hi)
+         && range(rect.yMin(), rect.yMax(), map_bounds_.yMin(), map_bounds_.yMax(), dy, y_count, y_lo, y_hi);
 }
 
 void HeatMapDataSource::setupMap()
@@ -353,6 +394,11 @@ void HeatMapDataSource::setupMap()
   const int x_grid = std::ceil(bounds.dx() / static_cast<double>(dx));
   const int y_grid = std::ceil(bounds.dy() / static_cast<double>(dy));
 
+  map_bounds_ = bounds;
+  map_dx_ = dx;
+  map_dy_ = dy;
+  map_.resize(boost::extents[x_grid][y_grid]);
+
   for (int x = 0; x < x_grid; x++) {
     const int xMin = bounds.xMin() + x * dx;
     const int xMax = std::min(xMin + dx, bounds.xMax());
@@ -361,16 +407,152 @@ void HeatMapDataSource::setupMap()
       const int yMin = bounds.yMin() + y * dy;
       const int yMax = std::min(yMin + dy, bounds.yMax());
 
-      auto map_pt = std::make_shared<MapColor>();
-      map_pt->rect = odb::Rect(xMin, yMin, xMax, yMax);
-      map_pt->has_value = false;
-      map_pt->value = 0.0;
-      map_pt->color = getColor(0);
+      MapColor& map_pt = map_[x][y];
+      map_pt.rect = odb::Rect(xMin, yMin, xMax, yMax);
+      map_pt.has_value = false;
+      map_pt.value = 0.0;
+      map_pt.color = getColor(0);
+    }
+  }
+}
+
+void HeatMapDataSource::rasterizeMap()
+{
+  const int x_count = map_.shape()[0];
+  const int y_count = map_.shape()[1];
+  if (x_count == 0 || y_count == 0) {
+    return;
+  }
 
-      Box bbox(Point(xMin, yMin), Point(xMax, yMax));
-      map_.insert(std::make_pair(bbox, map_pt));
+  // Columns are split into stripes that are filled independently.  Every
+  // cell combines its data in the order it was added, so the result does
+  // not depend on the number of threads.
+  utl::ThreadPool& pool = utl::ThreadPool::get();
+  const int stripe_count = std::min(x_count, 4 * pool.threadCount());
+  auto stripe_of = [x_count, stripe_count](int x) {
+    return static_cast<int>(static_cast<int64_t>(x) * stripe_count / x_count);
+  };
+  auto stripe_begin = [x_count, stripe_count](int stripe) {
+    return static_cast<int>((static_cast<int64_t>(stripe) * x_count + stripe_count - 1) / stripe_count);
+  };
+
+  std::vector<std::vector<int>> stripe_data(stripe_count);
+  for (int i = 0; i < map_data_.size(); i++) {
+    int x_lo, x_hi, y_lo, y_hi;
+    if (!getMapRange(0, map_data_[i].first, x_lo, x_hi, y_lo, y_hi)) {
+      continue;
+    }
+    for (int stripe = stripe_of(x_lo); stripe <= stripe_of(x_hi); stripe++) {
+      stripe_data[stripe].push_back(i);
     }
   }
+
+  pool.parallelFor(0, stripe_count, [&](int stripe) {
+    const int x_begin = stripe_begin(stripe);
+    const int x_end = stripe_begin(stripe + 1);
+
+    for (int x = x_begin; x < x_end; x++) {
+      for (int y = 0; y < y_count; y++) {
+        map_[x][y].has_value = false;
+        map_[x][y].value = 0.0;
+      }
+    }
+
+    for (const int idx : stripe_data[stripe]) {
+      const auto& [region, value] = map_data_[idx];
+      int x_lo, x_hi, y_lo, y_hi;
+      getMapRange(0, region, x_lo, x_hi, y_lo, y_hi);
+
+      const double value_area = region.area();
+      for (int x = std::max(x_lo, x_begin); x <= std::min(x_hi, x_end - 1); x++) {
+        for (int y = y_lo; y <= y_hi; y++) {
+          MapColor& map_pt = map_[x][y];
+          odb::Rect intersection;
+          map_pt.rect.intersection(region, intersection);
+
+          const double intersect_area = intersection.area();
+          const double region_area = map_pt.rect.area();
+
+          combineMapData(map_pt.has_value, map_pt.value, value, value_area, intersect_area, region_area);
+          map_pt.has_value = true;
+        }
+      }
+    }
+  });
+
+  markColorsInvalid();
+}
+
+void HeatMapDataSource::buildMapLevels()
+{
+  map_levels_.clear();
+
+  // Each level merges 2x2 cells of the previous one and keeps the largest
+  // value, so hot spots remain visible when zoomed out.  The levels are
+  // reserved up front so prev stays valid while they are added.
+  int level_count = 0;
+  for (int x_count = map_.shape()[0], y_count = map_.shape()[1];
+       x_count > 1 || y_count > 1;
+       x_count = (x_count + 1) / 2, y_count = (y_count + 1) / 2) {
+    level_count++;
+  }
+  map_levels_.reserve(level_count);
+
+  const Map* prev = &map_;
+  while (prev->shape()[0] > 1 || prev->shape()[1] > 1) {
+    const int prev_x_count = prev->shape()[0];
+    const int prev_y_count = prev->shape()[1];
+    const int x_count = (prev_x_count + 1) / 2;
+    const int y_count = (prev_y_count + 1) / 2;
+
+    map_levels_.emplace_back(boost::extents[x_count][y_count]);
+    Map& level = map_levels_.back();
+    for (int x = 0; x < x_count; x++) {
+      for (int y = 0; y < y_count; y++) {
+        MapColor& map_pt = level[x][y];
+        map_pt.rect = (*prev)[2 * x][2 * y].rect;
+        map_pt.has_value = false;
+        map_pt.value = 0.0;
+
+        for (int px = 2 * x; px < std::min(2 * x + 2, prev_x_count); px++) {
+          for (int py = 2 * y; py < std::min(2 * y + 2, prev_y_count); py++) {
+            const MapColor& child = (*prev)[px][py];
+            map_pt.rect.merge(child.rect);
+            if (!child.has_value) {
+              continue;
+            }
+            if (!map_pt.has_value || child.value > map_pt.value) {
+              map_pt.value = child.value;
+            }
+            map_pt.has_value = true;
+          }
+        }
+      }
+    }
+
+    prev = &level;
+  }
+
+  markColorsInvalid();
+}
+
+const HeatMapDataSource::Map& HeatMapDataSource::getMap(int level) const
+{
+  if (level == 0) {
+    return map_;
+  }
+  return map_levels_[level - 1];
+}
+
+int HeatMapDataSource::getMapLevel(double pixels_per_dbu) const
+{
+  const double cell_pixels = std::min(map_dx_, map_dy_) * pixels_per_dbu;
+
+  int level = 0;
+  while (level < map_levels_.size() && (cell_pixels * (1 << level)) < min_cell_pixels_) {
+    level++;
+  }
+  return level;
 }
 
 void HeatMapDataSource::destroyMap()
@@ -383,22 +565,40 @@ void HeatMapDataSource::destroyMap()
 void HeatMapDataSource::ensureMap()
 {
   if (destroy_map_) {
-    map_.clear();
+    map_data_.clear();
+    map_.resize(boost::extents[0][0]);
+    map_levels_.clear();
     destroy_map_ = false;
+    regrid_map_ = false;
   }
 
-  const bool build_map = map_.empty();
+  if (regrid_map_) {
+    map_.resize(boost::extents[0][0]);
+    map_levels_.clear();
+    regrid_map_ = false;
+  }
+
+  const bool build_map = map_.num_elements() == 0;
   if (build_map) {
     setupMap();
   }
 
   if (build_map || !isPopulated()) {
-    populated_ = populateMap();
+    // only a new grid, the data collected before is still valid
+    const bool reuse_data = build_map && isPopulated() && !map_data_.empty();
+    if (!reuse_data) {
+      map_data_.clear();
+      populated_ = populateMap();
+    }
+
+    rasterizeMap();
 
     if (isPopulated()) {
       correctMapScale(map_);
     }
 
+    buildMapLevels();
+
     if (setup_ != nullptr) {
       // announce changes
       setIssueRedraw(false);
@@ -453,8 +653,15 @@ void HeatMapDataSource::updateMapColors()
 
 void HeatMapDataSource::assignMapColors()
 {
-  for (auto& [bbox, map_pt] : map_) {
-    map_pt->color = getColor(map_pt->value);
+  for (int level = 0; level <= map_levels_.size(); level++) {
+    Map& map = level == 0 ? map_ : map_levels_[level - 1];
+    const int x_count = map.shape()[0];
+    const int y_count = map.shape()[1];
+    for (int x = 0; x < x_count; x++) {
+      for (int y = 0; y < y_count; y++) {
+        map[x][y].color = getColor(map[x][y].value);
+      }
+    }
   }
   colors_correct_ = true;
 }
@@ -544,7 +751,7 @@ void HeatMapRenderer::drawObjects(Painter& painter)
     return;
   }
 
-  const bool show_numbers = datasource_.getShowNumbers();
+  bool show_numbers = datasource_.getShowNumbers();
   const double min_value = datasource_.getRealRangeMinimumValue();
   const double max_value = datasource_.getRealRangeMaximumValue();
   const bool show_mins = datasource_.getDrawBelowRangeMin();
@@ -552,41 +759,56 @@ void HeatMapRenderer::drawObjects(Painter& painter)
 
   const odb::Rect& bounds = painter.getBounds();
 
-  for (const auto& [bbox, map_pt] : datasource_.getMap()) {
-    if (!map_pt->has_value) { // value not set so nothing to draw
-      continue;
-    }
-    if (!show_mins && map_pt->value < min_value) {
-      continue;
-    }
-    if (!show_maxs && map_pt->value > max_value) {
-      continue;
-    }
+  // use a coarser level when the cells would be too small to see
+  const int level = datasource_.getMapLevel(painter.getPixelsPerDBU());
+  const HeatMapDataSource::Map& map = datasource_.getMap(level);
+  if (level != 0) {
+    // merged cells show their largest value
+    show_numbers = false;
+  }
 
-    if (bounds.overlaps(map_pt->rect)) {
-      painter.setPen(map_pt->color, true);
-      painter.setBrush(map_pt->color);
+  int x_lo, x_hi, y_lo, y_hi;
+  if (!datasource_.getMapRange(level, bounds, x_lo, x_hi, y_lo, y_hi)) {
+    x_lo = 0;
+    x_hi = -1;
+  }
 
-      painter.drawRect(map_pt->rect);
+  for (int x = x_lo; x <= x_hi; x++) {
+    for (int y = y_lo; y <= y_hi; y++) {
+      const MapColor& map_pt = map[x][y];
+      if (!map_pt.has_value) { // value not set so nothing to draw
+        continue;
+      }
+      if (!show_mins && map_pt.value < min_value) {
+        continue;
+      }
+      if (!show_maxs && map_pt.value > max_value) {
+        continue;
+      }
+
+      painter.setPen(map_pt.color, true);
+      painter.setBrush(map_pt.color);
+
+      painter.drawRect(map_pt.rect);
 
       if (show_numbers) {
-        const int x = 0.5 * (map_pt->rect.xMin() + map_pt->rect.xMax());
-        const int y = 0.5 * (map_pt->rect.yMin() + map_pt->rect.yMax());
+        const int text_x = 0.5 * (map_pt.rect.xMin() + map_pt.rect.xMax());
+        const int text_y = 0.5 * (map_pt.rect.yMin() + map_pt.rect.yMax());
         const Painter::Anchor text_anchor = Painter::Anchor::CENTER;
         const double text_rect_margin = 0.8;
 
-        const std::string text = datasource_.formatValue(map_pt->value, false);
-        const odb::Rect text_bound = painter.stringBoundaries(x, y, text_anchor, text);
+        const std::string text = datasource_.formatValue(map_pt.value, false);
+        const odb::Rect text_bound = painter.stringBoundaries(text_x, text_y, text_anchor, text);
         bool draw = true;
-        if (text_bound.dx() >= text_rect_margin * map_pt->rect.dx() ||
-            text_bound.dy() >= text_rect_margin * map_pt->rect.dy()) {
+        if (text_bound.dx() >= text_rect_margin * map_pt.rect.dx() ||
+            text_bound.dy() >= text_rect_margin * map_pt.rect.dy()) {
           // don't draw if text will be too small
           draw = false;
         }
 
         if (draw) {
           painter.setPen(Painter::white, true);
-          painter.drawString(x, y, text_anchor, text);
+          painter.drawString(text_x, text_y, text_anchor, text);
         }
       }
     }
@@ -652,8 +874,12 @@ void RealValueHeatMapDataSource::correctMapScale(HeatMapDataSource::Map& map)
   min_ = roundData(min_);
   max_ = roundData(max_);
 
-  for (auto& [bbox, map_pt] : map) {
-    map_pt->value = convertValueToPercent(map_pt->value);
+  const int x_count = map.shape()[0];
+  const int y_count = map.shape()[1];
+  for (int x = 0; x < x_count; x++) {
+    for (int y = 0; y < y_count; y++) {
+      map[x][y].value = convertValueToPercent(map[x][y].value);
+    }
   }
 
   // reset since all data has been scaled by the appropriate amount
@@ -672,9 +898,13 @@ void RealValueHeatMapDataSource::determineMinMax(const HeatMapDataSource::Map& m
   min_ = std::numeric_limits<double>::max();
   max_ = std::numeric_limits<double>::min();
 
-  for (const auto& [bbox, map_pt] : map) {
-    min_ = std::min(min_, map_pt->value);
-    max_ = std::max(max_, map_pt->value);
+  const int x_count = map.shape()[0];
+  const int y_count = map.shape()[1];
+  for (int x = 0; x < x_count; x++) {
+    for (int y = 0; y < y_count; y++) {
+      min_ = std::min(min_, map[x][y].value);
+      max_ = std::max(max_, map[x][y].value);
+    }
   }
 }
 
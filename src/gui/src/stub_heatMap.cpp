@@ -42,6 +42,7 @@ HeatMapDataSource::HeatMapDataSource(utl::Logger* logger,
     short_name_(short_name),
     settings_group_(settings_group),
     destroy_map_(true),
+    regrid_map_(false),
     use_dbu_(false),
     populated_(false),
     colors_correct_(false),
@@ -59,7 +60,12 @@ HeatMapDataSource::HeatMapDataSource(utl::Logger* logger,
     reverse_log_(false),
     show_numbers_(false),
     show_legend_(false),
+    map_data_(),
     map_(),
+    map_levels_(),
+    map_bounds_(),
+    map_dx_(0),
+    map_dy_(0),
     renderer_(nullptr),
     setup_(nullptr),
     color_generator_(SpectrumGenerator(100.0))
@@ -145,6 +145,7 @@ class MacroPlacer
 
   // return weighted wire-length to get best solution
   double getWeightedWL();
+  double getWeightedWL(const vector<Macro>& macros);
   int weight(int idx11, int idx12);
   int macroIndex(odb::dbInst* inst);
   MacroSpacings& getSpacings(const Macro& macro);
@@ -161,6 +162,7 @@ class MacroPlacer
   void init();
   // Update Macro Location from Partition info
   void updateMacroLocations(Partition& part);
+  void updateMacroLocations(Partition& part, vector<Macro>& macros);
   void updateDbInstLocations();
   void makeMacroPartMap(const Partition& part, MacroPartMap& macroPartMap) const;
   vector<pair<Partition, Partition>> getPartitions(const Layout& layout,
@@ -178,6 +180,7 @@ class MacroPlacer
   void findAdjWeights(VertexFaninMap& vertex_fanins, AdjWeightMap& adj_map);
   sta::Pin* findSeqOutPin(sta::Instance* inst, sta::LibertyPort* out_port);
   void fillMacroWeights(AdjWeightMap& adj_map);
+  void findWeightedPairs();
   CoreEdge findNearestEdge(odb::dbBTerm* bTerm);
   string faninName(Macro* macro);
   int macroIndex(Macro* macro);
@@ -197,6 +200,15 @@ class MacroPlacer
 
   // macro idx/idx pair -> give each
   vector<vector<int>> macro_weights_;
+  // Non-zero entries of macro_weights_ so wire length evaluation does not
+  // rescan the whole matrix for every solution.
+  struct WeightedPair
+  {
+    int idx1;
+    int idx2;
+    float weight;
+  };
+  vector<WeightedPair> weighted_pairs_;
   // macro Information
   vector<Macro> macros_;
   // dbInst* --> macros_'s index
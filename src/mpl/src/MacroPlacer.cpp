@@ -33,6 +33,7 @@
 
 #include "mpl/MacroPlacer.h"
 
+#include <algorithm>
 #include <string>
 
 #include "db_sta/dbNetwork.hh"
@@ -50,6 +51,7 @@
 #include "sta/Sequential.hh"
 #include "sta/Sta.hh"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 
 namespace mpl {
 
@@ -401,47 +403,58 @@ void MacroPlacer::placeMacrosCornerMaxWl()
     graphics = std::make_unique<Graphics>(db_);
   }
 
-  solution_count_ = 0;
-  bool found_best = false;
-  int best_setIdx = 0;
-  double bestWwl = -DBL_MAX;
-  for (auto& partition_set : allSets) {
-    // skip for top partition
-    if (partition_set.size() == 1) {
-      continue;
-    }
-
-    if (gui_debug_) {
-      graphics->status("Pre-anneal");
-      graphics->set_partitions(partition_set, true);
-    }
-
+  // Each partition set is annealed and scored independently against its own
+  // copy of the macro locations, so the sets can be evaluated concurrently.
+  // Results are reported and compared in set order afterwards to keep the
+  // chosen solution independent of the thread count.
+  struct SetResult
+  {
+    bool failed = false;
+    const Partition* failed_part = nullptr;
+    double wwl = 0.0;
+  };
+  vector<SetResult> results(allSets.size());
+
+  auto evaluateSet = [&](size_t set_idx) {
+    vector<Partition>& partition_set = allSets[set_idx];
+    SetResult& result = results[set_idx];
+    vector<Macro> macros = macros_;
     // For each of the 4 partitions
-    bool isFailed = false;
     for (auto& curPart : partition_set) {
       // Annealing based on ParquetFP Engine
       bool success = curPart.anneal();
       if (!success) {
-        logger_->warn(
-            MPL,
-            61,
-            "Parquet area {:g} x {:g} exceeds the partition area {:g} x {:g}.",
-            curPart.solution_width,
-            curPart.solution_height,
-            curPart.width,
-            curPart.height);
-        isFailed = true;
-        break;
+        result.failed = true;
+        result.failed_part = &curPart;
+        return;
       }
       // Update mckt frequently
-      updateMacroLocations(curPart);
+      updateMacroLocations(curPart, macros);
     }
+    result.wwl = getWeightedWL(macros);
+  };
 
-    if (isFailed) {
-      continue;
+  solution_count_ = 0;
+  bool found_best = false;
+  int best_setIdx = 0;
+  double bestWwl = -DBL_MAX;
+  auto reportSet = [&](size_t set_idx) {
+    vector<Partition>& partition_set = allSets[set_idx];
+    const SetResult& result = results[set_idx];
+    if (result.failed) {
+      const Partition* curPart = result.failed_part;
+      logger_->warn(
+          MPL,
+          61,
+          "Parquet area {:g} x {:g} exceeds the partition area {:g} x {:g}.",
+          curPart->solution_width,
+          curPart->solution_height,
+          curPart->width,
+          curPart->height);
+      return;
     }
 
-    double curWwl = getWeightedWL();
+    double curWwl = result.wwl;
     logger_->info(MPL,
                   71,
                   "Solution {} weighted wire length {:g}.",
@@ -455,7 +468,7 @@ void MacroPlacer::placeMacrosCornerMaxWl()
         // up in one clump. -cherry
         || curWwl > bestWwl) {
       bestWwl = curWwl;
-      best_setIdx = &partition_set - &allSets[0];
+      best_setIdx = set_idx;
       found_best = true;
       is_best = true;
     }
@@ -469,6 +482,31 @@ void MacroPlacer::placeMacrosCornerMaxWl()
       graphics->status(msg);
       graphics->set_partitions(partition_set, false);
     }
+  };
+
+  // skip for top partition
+  vector<size_t> set_indices;
+  for (size_t set_idx = 0; set_idx < allSets.size(); set_idx++) {
+    if (allSets[set_idx].size() != 1) {
+      set_indices.push_back(set_idx);
+    }
+  }
+
+  if (gui_debug_) {
+    // Step through the sets one at a time for the debug display.
+    for (size_t set_idx : set_indices) {
+      graphics->status("Pre-anneal");
+      graphics->set_partitions(allSets[set_idx], true);
+      evaluateSet(set_idx);
+      reportSet(set_idx);
+    }
+  } else {
+    utl::ThreadPool::get().parallelFor(
+        0, set_indices.size(), [&](int i) { evaluateSet(set_indices[i]); });
+
+    for (size_t set_idx : set_indices) {
+      reportSet(set_idx);
+    }
   }
 
   if (found_best) {
@@ -828,6 +866,13 @@ static float getRoundUpFloat(float x, float unit)
 }
 
 void MacroPlacer::updateMacroLocations(Partition& part)
+{
+  updateMacroLocations(part, macros_);
+}
+
+// Snap partition macro locations and copy them to macros (parallel to
+// macros_).
+void MacroPlacer::updateMacroLocations(Partition& part, vector<Macro>& macros)
 {
   dbTech* tech = db_->getTech();
   const float pitchX = static_cast<float>(snap_layer_->getPitchX())
@@ -843,8 +888,8 @@ void MacroPlacer::updateMacroLocations(Partition& part)
     macro.ly = macroY;
     // Update Macro Location
     int macroIdx = macro_inst_map_.at(macro.dbInstPtr);
-    macros_[macroIdx].lx = macroX;
-    macros_[macroIdx].ly = macroY;
+    macros[macroIdx].lx = macroX;
+    macros[macroIdx].ly = macroY;
   }
 }
 
@@ -855,70 +900,69 @@ void MacroPlacer::updateMacroLocations(Partition& part)
 
 double MacroPlacer::getWeightedWL()
 {
-  double wwl = 0.0f;
+  return getWeightedWL(macros_);
+}
 
+// Weighted wire length of macro locations in macros, which is parallel to
+// macros_.
+double MacroPlacer::getWeightedWL(const vector<Macro>& macros)
+{
   double width = ux_ - lx_;
   double height = uy_ - ly_;
 
-  for (size_t i = 0; i < macros_.size() + core_edge_count; i++) {
-    for (size_t j = i + 1; j < macros_.size() + core_edge_count; j++) {
-      double pointX1 = 0, pointY1 = 0;
-      if (i == EAST_IDX) {
-        pointX1 = lx_ + width;
-        pointY1 = ly_ + height / 2.0;
-      } else if (i == WEST_IDX) {
-        pointX1 = lx_;
-        pointY1 = ly_ + height / 2.0;
-      } else if (i == NORTH_IDX) {
-        pointX1 = lx_ + width / 2.0;
-        pointY1 = ly_ + height;
-      } else if (i == SOUTH_IDX) {
-        pointX1 = lx_ + width / 2.0;
-        pointY1 = ly_;
-      } else {
-        pointX1 = macros_[i].lx + macros_[i].w / 2;
-        pointY1 = macros_[i].ly + macros_[i].h / 2;
-      }
-
-      double pointX2 = 0, pointY2 = 0;
-      if (j == EAST_IDX) {
-        pointX2 = lx_ + width;
-        pointY2 = ly_ + height / 2.0;
-      } else if (j == WEST_IDX) {
-        pointX2 = lx_;
-        pointY2 = ly_ + height / 2.0;
-      } else if (j == NORTH_IDX) {
-        pointX2 = lx_ + width / 2.0;
-        pointY2 = ly_ + height;
-      } else if (j == SOUTH_IDX) {
-        pointX2 = lx_ + width / 2.0;
-        pointY2 = ly_;
-      } else {
-        pointX2 = macros_[j].lx + macros_[j].w / 2;
-        pointY2 = macros_[j].ly + macros_[j].h / 2;
-      }
+  auto indexLocation = [&](size_t idx, double& x, double& y) {
+    if (idx == EAST_IDX) {
+      x = lx_ + width;
+      y = ly_ + height / 2.0;
+    } else if (idx == WEST_IDX) {
+      x = lx_;
+      y = ly_ + height / 2.0;
+    } else if (idx == NORTH_IDX) {
+      x = lx_ + width / 2.0;
+      y = ly_ + height;
+    } else if (idx == SOUTH_IDX) {
+      x = lx_ + width / 2.0;
+      y = ly_;
+    } else {
+      x = macros[idx].lx + macros[idx].w / 2;
+      y = macros[idx].ly + macros[idx].h / 2;
+    }
+  };
+
+  auto pairWeightedWL = [&](size_t i, size_t j, float edgeWeight) {
+    double pointX1 = 0, pointY1 = 0;
+    indexLocation(i, pointX1, pointY1);
+    double pointX2 = 0, pointY2 = 0;
+    indexLocation(j, pointX2, pointY2);
+
+    double wl = std::sqrt((pointX1 - pointX2) * (pointX1 - pointX2)
+                          + (pointY1 - pointY2) * (pointY1 - pointY2));
+    double weighted_wl = edgeWeight * wl;
+    if (edgeWeight > 0)
+      debugPrint(logger_,
+                 MPL,
+                 "weighted_wl",
+                 1,
+                 "{} -> {} wl {:.2f} * weight {:.2f} = {:.2f}",
+                 macroIndexName(i),
+                 macroIndexName(j),
+                 wl,
+                 edgeWeight,
+                 weighted_wl);
+    return weighted_wl;
+  };
 
-      float edgeWeight = 0.0f;
-      if (connection_driven_) {
-        edgeWeight = macro_weights_[i][j];
-      } else {
-        edgeWeight = 1;
+  double wwl = 0.0f;
+  if (connection_driven_) {
+    // Zero weight pairs do not contribute, so only visit the weighted ones.
+    for (const WeightedPair& pair : weighted_pairs_) {
+      wwl += pairWeightedWL(pair.idx1, pair.idx2, pair.weight);
+    }
+  } else {
+    for (size_t i = 0; i < macros.size() + core_edge_count; i++) {
+      for (size_t j = i + 1; j < macros.size() + core_edge_count; j++) {
+        wwl += pairWeightedWL(i, j, 1);
       }
-      double wl = std::sqrt((pointX1 - pointX2) * (pointX1 - pointX2)
-                            + (pointY1 - pointY2) * (pointY1 - pointY2));
-      double weighted_wl = edgeWeight * wl;
-      if (edgeWeight > 0)
-        debugPrint(logger_,
-                   MPL,
-                   "weighted_wl",
-                   1,
-                   "{} -> {} wl {:.2f} * weight {:.2f} = {:.2f}",
-                   macroIndexName(i),
-                   macroIndexName(j),
-                   wl,
-                   edgeWeight,
-                   weighted_wl);
-      wwl += weighted_wl;
     }
   }
 
@@ -1014,6 +1058,7 @@ void MacroPlacer::findAdjacencies()
   findAdjWeights(vertex_fanins, adj_map);
 
   fillMacroWeights(adj_map);
+  findWeightedPairs();
 }
 
 void MacroPlacer::seedFaninBfs(sta::BfsFwdIterator& bfs,
@@ -1199,8 +1244,7 @@ void MacroPlacer::fillMacroWeights(AdjWeightMap& adj_map)
   size_t weight_size = macros_.size() + core_edge_count;
   macro_weights_.resize(weight_size);
   for (size_t i = 0; i < weight_size; i++) {
-    macro_weights_[i].resize(weight_size);
-    macro_weights_[i] = {0};
+    macro_weights_[i].assign(weight_size, 0);
   }
 
   for (auto pair_weight : adj_map) {
@@ -1226,6 +1270,21 @@ void MacroPlacer::fillMacroWeights(AdjWeightMap& adj_map)
   }
 }
 
+void MacroPlacer::findWeightedPairs()
+{
+  weighted_pairs_.clear();
+  for (size_t i = 0; i < macro_weights_.size(); i++) {
+    // Note macro_weights only has entries for idx1 < idx2.
+    for (size_t j = i + 1; j < macro_weights_[i].size(); j++) {
+      int weight = macro_weights_[i][j];
+      if (weight != 0)
+        weighted_pairs_.push_back({static_cast<int>(i),
+                                   static_cast<int>(j),
+                                   static_cast<float>(weight)});
+    }
+  }
+}
+
 std::string MacroPlacer::faninName(Macro* macro)
 {
   intptr_t edge_index = reinterpret_cast<intptr_t>(macro);
@@ -183,7 +183,7 @@ void ClusterDB::cluster1Layer(unsigned layerNum,
   unsigned currNodeIdx, nextNodeIdx;
 
   itNode node, nodeBegin;
-  static bool direction = false;
+  static thread_local bool direction = false;
 
   blkCtr = 0;
   vector<bool> seenNodes;
@@ -491,7 +491,7 @@ Node& ClusterDB::getClosestNode(Node& currNode,
       Node& nextClosestNode = getClosestNodeBFS(currNode, nodes, nets,
       seenNodes, maxConnId, direction);
     */
-    maxConnectionsIdx = rand() % numNodes;
+    maxConnectionsIdx = fpRand() % numNodes;
   }
   numConnections.clear();
   return nodes->getNode(maxConnectionsIdx);
@@ -110,5 +110,5 @@ Command_Line::Command_Line()
 
 void Command_Line::setSeed()
 {
-  std::srand(seed);  // seed for rand function
+  fpSrand(seed);  // seed for rand function
 }
@@ -31,6 +31,8 @@
 ***************************************************************************/
 
 #include "FPcommon.h"
+
+#include <cstdint>
 using std::cout;
 using std::endl;
 using std::ostream;
@@ -214,3 +216,59 @@ const char* parquetfp::toChar(ORIENT orient)
   cout << "ERROR: in converting ORIENT to char* " << endl;
   return "N";
 }
+
+namespace {
+
+// Additive feedback generator r[i] = r[i-3] + r[i-31] used by glibc's
+// TYPE_3 random().
+struct FPRandState
+{
+  uint32_t r[31];
+  int front;
+  int rear;
+};
+
+int nextRand(FPRandState& state)
+{
+  state.r[state.front] += state.r[state.rear];
+  const int result = static_cast<int>(state.r[state.front] >> 1);
+  state.front = (state.front + 1) % 31;
+  state.rear = (state.rear + 1) % 31;
+  return result;
+}
+
+FPRandState makeRandState(unsigned seed)
+{
+  FPRandState state;
+  int32_t word = (seed == 0) ? 1 : static_cast<int32_t>(seed);
+  state.r[0] = word;
+  for (int i = 1; i < 31; i++) {
+    // word = (16807 * word) % 2147483647 without overflow
+    const int32_t hi = word / 127773;
+    const int32_t lo = word % 127773;
+    word = 16807 * lo - 2836 * hi;
+    if (word < 0)
+      word += 2147483647;
+    state.r[i] = word;
+  }
+  state.front = 3;
+  state.rear = 0;
+  // Discard the first 310 outputs like srandom_r does.
+  for (int i = 0; i < 310; i++)
+    nextRand(state);
+  return state;
+}
+
+thread_local FPRandState rand_state = makeRandState(1);
+
+}  // namespace
+
+void parquetfp::fpSrand(unsigned seed)
+{
+  rand_state = makeRandState(seed);
+}
+
+int parquetfp::fpRand()
+{
+  return nextRand(rand_state);
+}
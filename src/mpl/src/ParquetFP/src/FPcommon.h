@@ -165,6 +165,12 @@ inline bool lessThanFloat(const float a, const float b)
   return (a < b) && !equalFloat(a, b);
 }
 
+// Random numbers for the annealers.  Same sequence as glibc
+// srand()/rand(), but the generator state is per thread so that several
+// annealers can run concurrently and still reproduce their seeded results.
+void fpSrand(unsigned seed);
+int fpRand();
+
 #define fpwarn(CONDITION, ERRMESSAGE)         \
   {                                           \
     if (!(CONDITION)) {                       \
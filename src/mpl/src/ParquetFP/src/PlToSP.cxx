@@ -285,7 +285,7 @@ void Pl2SP::TCGAlgo(void)
         ++ctr;
 
       if (ctr > 1) {
-        unsigned dir = rand() % 2;
+        unsigned dir = fpRand() % 2;
         if (dir == 0)  // H constraint
         {
           TCGMatrixVert[i][j] = 0;
@@ -318,7 +318,7 @@ void Pl2SP::TCGAlgo(void)
           TCGMatrixHoriz[j][i] = 1;
 
         /*
-          unsigned dir = rand()%2;
+          unsigned dir = fpRand()%2;
           if(dir == 0) //H constraint
           {
           if(_xloc[i] < _xloc[j])
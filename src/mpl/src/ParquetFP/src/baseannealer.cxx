@@ -88,7 +88,7 @@ BaseAnnealer::BaseAnnealer(const parquetfp::Command_Line* const params,
   // set the random seed for each invokation of the Annealer
   unsigned seed = _params->seed;
 
-  srand(seed);             // seed for rand function
+  parquetfp::fpSrand(seed);  // seed for rand function
   _random_gen.seed(seed);  // seed for shuffle
 
   _baseFileName = _params->inFileName;
@@ -211,7 +211,7 @@ void BTreeAreaWireAnnealer::sort_slacks(const std::vector<float>& slacks,
 BTree::MoveType BTreeAreaWireAnnealer::get_move() const
 {
   // 0 <= "rand_num" < 1
-  float rand_num = rand() / (RAND_MAX + 1.0);
+  float rand_num = fpRand() / (RAND_MAX + 1.0);
   if (rand_num < 0.3333)
     return BTree::SWAP;
   else if (rand_num < 0.6666)
@@ -223,8 +223,8 @@ BTree::MoveType BTreeAreaWireAnnealer::get_move() const
 void BTreeAreaWireAnnealer::perform_swap()
 {
   int blocknum = blockinfo.currDimensions.blocknum();
-  int blkA = int(blocknum * (rand() / (RAND_MAX + 1.0)));
-  int blkB = int((blocknum - 1) * (rand() / (RAND_MAX + 1.0)));
+  int blkA = int(blocknum * (fpRand() / (RAND_MAX + 1.0)));
+  int blkB = int((blocknum - 1) * (fpRand() / (RAND_MAX + 1.0)));
   blkB = (blkB >= blkA) ? blkB + 1 : blkB;
 
   in_next_solution = in_curr_solution;
@@ -234,7 +234,7 @@ void BTreeAreaWireAnnealer::perform_swap()
 void BTreeAreaWireAnnealer::perform_rotate()
 {
   int blocknum = blockinfo.currDimensions.blocknum();
-  int blk = int(blocknum * (rand() / (RAND_MAX + 1.0)));
+  int blk = int(blocknum * (fpRand() / (RAND_MAX + 1.0)));
 
   // may want to do something different here,
   // like search for something that can be rotated
@@ -253,9 +253,9 @@ void BTreeAreaWireAnnealer::perform_rotate()
 void BTreeAreaWireAnnealer::perform_move()
 {
   int blocknum = blockinfo.currDimensions.blocknum();
-  int blk = int(blocknum * (rand() / (RAND_MAX + 1.0)));
+  int blk = int(blocknum * (fpRand() / (RAND_MAX + 1.0)));
 
-  int target_rand_num = int((2 * blocknum - 1) * (rand() / (RAND_MAX + 1.0)));
+  int target_rand_num = int((2 * blocknum - 1) * (fpRand() / (RAND_MAX + 1.0)));
   int target = target_rand_num / 2;
   target = (target >= blk) ? target + 1 : target;
 
@@ -271,7 +271,7 @@ void BTreeAreaWireAnnealer::perform_rotate(int& blk,
                                            parquetfp::ORIENT& oldOrient)
 {
   int blocknum = blockinfo.currDimensions.blocknum();
-  blk = int(blocknum * (rand() / (RAND_MAX + 1.0)));
+  blk = int(blocknum * (fpRand() / (RAND_MAX + 1.0)));
   int blk_orient = in_curr_solution.tree[blk].orient;
   int new_orient = blk_orient;
 
@@ -281,7 +281,7 @@ void BTreeAreaWireAnnealer::perform_rotate(int& blk,
   } else {
     if (_params->minWL) {
       while (new_orient == blk_orient)
-        new_orient = (blk_orient + rand() % 8) % 8;
+        new_orient = (blk_orient + fpRand() % 8) % 8;
     } else
       new_orient = (blk_orient + 1) % 8;
     new_orient = _physicalOrient[blk][new_orient];
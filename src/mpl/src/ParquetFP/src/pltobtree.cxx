@@ -38,6 +38,7 @@
 #include <list>
 #include <vector>
 
+#include "FPcommon.h"
 #include "plsptobtree.h"
 
 namespace parquetfp {
@@ -375,7 +376,7 @@ void Pl2BTree::TCG_build_tree()
         ++ctr;
 
       if (ctr > 1) {
-        unsigned dir = rand() % 2;
+        unsigned dir = fpRand() % 2;
         if (dir == 0)  // H constraint
         {
           TCGMatrixVert[i][j] = false;
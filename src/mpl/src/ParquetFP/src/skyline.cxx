@@ -390,11 +390,11 @@ float SkylineContour::GetContourArea()
 
 /*
 int GetVal (int min, int max) {
-  return rand() % (max-min) + min;
+  return fpRand() % (max-min) + min;
 }
 
 float GetRandFloat () {
-  return 1000.0f * static_cast <float> (rand()) / static_cast <float>
+  return 1000.0f * static_cast <float> (fpRand()) / static_cast <float>
 (RAND_MAX);
 }
 
@@ -42,13 +42,13 @@
 #include <queue>
 #include <random>
 #include <stdexcept>
-#include <thread>
 #include <unordered_map>
 #include <vector>
 
 #include "shape_engine.h"
 #include "util.h"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 
 namespace block_placement {
 using std::abs;
@@ -72,7 +72,6 @@ using std::stoi;
 using std::string;
 using std::swap;
 using std::tanh;
-using std::thread;
 using std::to_string;
 using std::unordered_map;
 using std::vector;
@@ -360,67 +359,53 @@ SimulatedAnnealingCore::SimulatedAnnealingCore(
   }
 
   pre_blocks_ = blocks_;
+  InitNetIndex();
 }
 
-void SimulatedAnnealingCore::PackFloorplan()
+// Evaluates one direction of the sequence pair as a weighted longest common
+// subsequence (Tang & Wong, FAST-SP).  pack_front_ maps the neg_seq position
+// of every block on the current front to its far edge; both keys and values
+// are increasing, so the location of the next block is the value of its
+// predecessor in the map and each block is inserted and erased at most once.
+float SimulatedAnnealingCore::PackSequence(const vector<int>& seq,
+                                           bool horizontal)
 {
-  for (int i = 0; i < blocks_.size(); i++) {
-    blocks_[i].SetX(0.0);
-    blocks_[i].SetY(0.0);
-  }
-
-  // calculate X position
-  vector<pair<int, int>> match(blocks_.size());
-  for (int i = 0; i < pos_seq_.size(); i++) {
-    match[pos_seq_[i]].first = i;
-    match[neg_seq_[i]].second = i;
+  pack_front_.clear();
+  for (int b : seq) {
+    const int p = pack_match_[b];
+    auto next = pack_front_.lower_bound(p);
+    const float loc
+        = (next == pack_front_.begin()) ? 0.0 : std::prev(next)->second;
+    const float t = loc
+                    + (horizontal ? blocks_[b].GetWidth()
+                                  : blocks_[b].GetHeight());
+    if (horizontal)
+      blocks_[b].SetX(loc);
+    else
+      blocks_[b].SetY(loc);
+    if (t <= loc)
+      continue;
+    while (next != pack_front_.end() && next->second <= t)
+      next = pack_front_.erase(next);
+    pack_front_.emplace_hint(next, p, t);
   }
+  return pack_front_.empty() ? 0.0 : pack_front_.rbegin()->second;
+}
 
-  vector<float> length(blocks_.size());
-  for (int i = 0; i < blocks_.size(); i++)
-    length[i] = 0.0;
-
-  for (int i = 0; i < pos_seq_.size(); i++) {
-    int b = pos_seq_[i];
-    int p = match[b].second;
-    blocks_[b].SetX(length[p]);
-    float t = blocks_[b].GetX() + blocks_[b].GetWidth();
-    for (int j = p; j < neg_seq_.size(); j++)
-      if (t > length[j])
-        length[j] = t;
-      else
-        break;
-  }
-
-  width_ = length[blocks_.size() - 1];
-
-  // calulate Y position
-  vector<int> pos_seq(pos_seq_.size());
-  int num_blocks = pos_seq_.size();
+void SimulatedAnnealingCore::PackFloorplan()
+{
+  const int num_blocks = pos_seq_.size();
+  pack_match_.resize(blocks_.size());
   for (int i = 0; i < num_blocks; i++)
-    pos_seq[i] = pos_seq_[num_blocks - 1 - i];
+    pack_match_[neg_seq_[i]] = i;
 
-  for (int i = 0; i < num_blocks; i++) {
-    match[pos_seq[i]].first = i;
-    match[neg_seq_[i]].second = i;
-  }
+  // calculate X position
+  width_ = PackSequence(pos_seq_, true);
 
-  for (int i = 0; i < num_blocks; i++)
-    length[i] = 0.0;
-
-  for (int i = 0; i < num_blocks; i++) {
-    int b = pos_seq[i];
-    int p = match[b].second;
-    blocks_[b].SetY(length[p]);
-    float t = blocks_[b].GetY() + blocks_[b].GetHeight();
-    for (int j = p; j < num_blocks; j++)
-      if (t > length[j])
-        length[j] = t;
-      else
-        break;
-  }
+  // calulate Y position
+  pack_rev_seq_.assign(pos_seq_.rbegin(), pos_seq_.rend());
+  height_ = PackSequence(pack_rev_seq_, false);
 
-  height_ = length[num_blocks - 1];
   area_ = width_ * height_;
 }
 
@@ -1127,39 +1112,88 @@ void SimulatedAnnealingCore::CalculateBoundaryPenalty()
   }
 }
 
+void SimulatedAnnealingCore::InitNetIndex()
+{
+  net_blocks_.assign(nets_.size(), vector<int>());
+  block_nets_.assign(blocks_.size(), vector<int>());
+  net_terminal_bbox_.assign(nets_.size(), Outline());
+  for (int net_id = 0; net_id < nets_.size(); net_id++) {
+    const Net* net = nets_[net_id];
+    for (const string& block : net->blocks_) {
+      const int block_id = block_map_[block];
+      net_blocks_[net_id].push_back(block_id);
+      if (block_nets_[block_id].empty()
+          || block_nets_[block_id].back() != net_id)
+        block_nets_[block_id].push_back(net_id);
+    }
+
+    Outline& bbox = net_terminal_bbox_[net_id];
+    bbox.lx = FLT_MAX;
+    bbox.ly = FLT_MAX;
+    for (const string& terminal : net->terminals_) {
+      const float x = terminal_position_[terminal].first;
+      const float y = terminal_position_[terminal].second;
+      bbox.lx = min(bbox.lx, x);
+      bbox.ly = min(bbox.ly, y);
+      bbox.ux = max(bbox.ux, x);
+      bbox.uy = max(bbox.uy, y);
+    }
+  }
+  net_wirelength_.clear();
+}
+
+SimulatedAnnealingCore::Outline SimulatedAnnealingCore::BlockOutline(
+    int block_id) const
+{
+  const Block& block = blocks_[block_id];
+  Outline outline;
+  outline.lx = block.GetX();
+  outline.ly = block.GetY();
+  outline.ux = outline.lx + block.GetWidth();
+  outline.uy = outline.ly + block.GetHeight();
+  return outline;
+}
+
+float SimulatedAnnealingCore::NetWirelength(int net_id) const
+{
+  Outline bbox = net_terminal_bbox_[net_id];
+  for (int block_id : net_blocks_[net_id]) {
+    const Outline& outline = evaluated_outlines_[block_id];
+    bbox.lx = min(bbox.lx, outline.lx);
+    bbox.ly = min(bbox.ly, outline.ly);
+    bbox.ux = max(bbox.ux, outline.ux);
+    bbox.uy = max(bbox.uy, outline.uy);
+  }
+  return (abs(bbox.ux - bbox.lx) + abs(bbox.uy - bbox.ly))
+         * nets_[net_id]->weight_;
+}
+
 void SimulatedAnnealingCore::CalculateWirelength()
 {
-  wirelength_ = 0.0;
-  for (Net* net : nets_) {
-    vector<string> blocks = net->blocks_;
-    vector<string> terminals = net->terminals_;
-    const int weight = net->weight_;
-    float lx = FLT_MAX;
-    float ly = FLT_MAX;
-    float ux = 0.0;
-    float uy = 0.0;
-
-    for (int i = 0; i < blocks.size(); i++) {
-      const float temp_lx = blocks_[block_map_[blocks[i]]].GetX();
-      const float temp_ux = temp_lx + blocks_[block_map_[blocks[i]]].GetWidth();
-      const float temp_ly = blocks_[block_map_[blocks[i]]].GetY();
-      const float temp_uy
-          = temp_ly + blocks_[block_map_[blocks[i]]].GetHeight();
-      lx = min(lx, temp_lx);
-      ly = min(ly, temp_ly);
-      ux = max(ux, temp_ux);
-      uy = max(uy, temp_uy);
+  if (net_wirelength_.size() != nets_.size()) {
+    evaluated_outlines_.resize(blocks_.size());
+    for (int i = 0; i < blocks_.size(); i++)
+      evaluated_outlines_[i] = BlockOutline(i);
+    net_wirelength_.resize(nets_.size());
+    net_dirty_.assign(nets_.size(), true);
+  } else {
+    for (int i = 0; i < blocks_.size(); i++) {
+      const Outline outline = BlockOutline(i);
+      if (outline != evaluated_outlines_[i]) {
+        evaluated_outlines_[i] = outline;
+        for (int net_id : block_nets_[i])
+          net_dirty_[net_id] = true;
+      }
     }
+  }
 
-    for (int i = 0; i < terminals.size(); i++) {
-      const float x = terminal_position_[terminals[i]].first;
-      const float y = terminal_position_[terminals[i]].second;
-      lx = min(lx, x);
-      ly = min(ly, y);
-      ux = max(ux, x);
-      uy = max(uy, y);
+  wirelength_ = 0.0;
+  for (int net_id = 0; net_id < nets_.size(); net_id++) {
+    if (net_dirty_[net_id]) {
+      net_wirelength_[net_id] = NetWirelength(net_id);
+      net_dirty_[net_id] = false;
     }
-    wirelength_ += (abs(ux - lx) + abs(uy - ly)) * weight;
+    wirelength_ += net_wirelength_[net_id];
   }
 }
 
@@ -1690,7 +1724,6 @@ vector<Block> Floorplan(const vector<shape_engine::Cluster*>& clusters,
     init_T = init_T * heat_count;
     heat_count = heat_count * heat_rate;
     vector<SimulatedAnnealingCore*> sa_vec;
-    vector<thread> threads;
     for (int j = 0; j < num_worker; j++) {
       float cooling_rate = 0.995;
       if (num_worker >= 2) {
@@ -1739,11 +1772,10 @@ vector<Block> Floorplan(const vector<shape_engine::Cluster*>& clusters,
 
       sa->SetSeq(pos_seq, neg_seq);
       sa_vec.push_back(sa);
-      threads.push_back(thread(Run, sa));
     }
 
-    for (auto& th : threads)
-      th.join();
+    utl::ThreadPool::get().parallelFor(
+        0, num_worker, [&](int j) { Run(sa_vec[j]); });
 
     for (int j = 0; j < num_worker; j++) {
       if (best_cost > sa_vec[j]->GetCost()) {
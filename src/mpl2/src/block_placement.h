@@ -34,6 +34,7 @@
 #pragma once
 
 #include <iostream>
+#include <map>
 #include <random>
 #include <string>
 #include <unordered_map>
@@ -251,10 +252,41 @@ class SimulatedAnnealingCore
   std::vector<int> pre_pos_seq_;
   std::vector<int> pre_neg_seq_;
 
+  // Incremental wirelength evaluation.  Block and terminal names are resolved
+  // once; each net keeps its last HPWL and only nets of blocks whose outline
+  // changed since the previous evaluation are recomputed.
+  struct Outline
+  {
+    float lx = 0.0;
+    float ly = 0.0;
+    float ux = 0.0;
+    float uy = 0.0;
+    bool operator!=(const Outline& other) const
+    {
+      return lx != other.lx || ly != other.ly || ux != other.ux
+             || uy != other.uy;
+    }
+  };
+  std::vector<std::vector<int>> net_blocks_;
+  std::vector<std::vector<int>> block_nets_;
+  std::vector<Outline> net_terminal_bbox_;
+  std::vector<float> net_wirelength_;
+  std::vector<Outline> evaluated_outlines_;
+  std::vector<bool> net_dirty_;
+
+  // Scratch buffers for PackFloorplan
+  std::vector<int> pack_match_;
+  std::vector<int> pack_rev_seq_;
+  std::map<int, float> pack_front_;
+
   std::mt19937 generator_;
   std::uniform_real_distribution<float> distribution_;
 
   void ShrinkBlocks();
+  void InitNetIndex();
+  float NetWirelength(int net_id) const;
+  Outline BlockOutline(int block_id) const;
+  float PackSequence(const std::vector<int>& seq, bool horizontal);
   void PackFloorplan();
   void Resize();
   void SingleSwap(bool flag);  // true for pos_seq and false for neg_seq
@@ -39,7 +39,6 @@
 #include <fstream>
 #include <random>
 #include <string>
-#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -47,6 +46,7 @@
 #include "shape_engine.h"
 #include "util.h"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 
 namespace pin_alignment {
 using std::abs;
@@ -65,7 +65,6 @@ using std::sort;
 using std::stof;
 using std::string;
 using std::swap;
-using std::thread;
 using std::to_string;
 using std::unordered_map;
 using std::vector;
@@ -610,7 +609,6 @@ bool PinAlignmentSingleCluster(
   int sa_id = 0;
 
   vector<SimulatedAnnealingCore*> sa_vector;
-  vector<thread> threads;
   while (remaining_run > 0) {
     run_thread = num_thread;
     if (remaining_run < num_thread)
@@ -646,13 +644,9 @@ bool PinAlignmentSingleCluster(
       sa_vector.push_back(sa);
     }
 
-    for (int j = 0; j < run_thread; j++)
-      threads.push_back(thread(Run, sa_vector[sa_id++]));
-
-    for (auto& th : threads)
-      th.join();
-
-    threads.clear();
+    utl::ThreadPool::get().parallelFor(
+        sa_id, sa_id + run_thread, [&](int j) { Run(sa_vector[j]); });
+    sa_id += run_thread;
     remaining_run = remaining_run - run_thread;
   }
 
@@ -38,12 +38,12 @@
 #include <fstream>
 #include <random>
 #include <string>
-#include <thread>
 #include <unordered_map>
 #include <vector>
 
 #include "util.h"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 
 namespace shape_engine {
 using std::abs;
@@ -61,7 +61,6 @@ using std::sort;
 using std::stof;
 using std::string;
 using std::swap;
-using std::thread;
 using std::to_string;
 using std::unordered_map;
 using std::vector;
@@ -525,12 +524,9 @@ vector<pair<float, float>> TileMacro(const string& report_directory,
       sa_vector.push_back(sa);
     }
 
-    vector<thread> threads;
-    for (int i = 0; i < run_thread; i++)
-      threads.push_back(thread(Run, sa_vector[sa_id++]));
-
-    for (auto& th : threads)
-      th.join();
+    utl::ThreadPool::get().parallelFor(
+        sa_id, sa_id + run_thread, [&](int i) { Run(sa_vector[i]); });
+    sa_id += run_thread;
 
     remaining_run = remaining_run - run_thread;
   }
@@ -93,6 +93,7 @@ class dbCapNode;
 class dbRSeg;
 class dbCCSeg;
 class dbBlockSearch;
+class dbSpatialIndex;
 class dbRow;
 class dbFill;
 class dbTechAntennaPinModel;
@@ -413,6 +414,40 @@ class dbDatabase : public dbObject
   ///
   static void commitEco(dbBlock* block);
 
+  ///
+  /// Begin a transaction on the specified block. Transactions may be
+  /// nested. The changes made inside a transaction are either kept by
+  /// commitTransaction or reverted by rollbackTransaction. Reverting
+  /// goes through the regular db api, so the block callbacks observe
+  /// the restored state.
+  ///
+  /// Instance, net, bterm and wire creation/destruction, connections,
+  /// master swaps, placement and journaled flag changes are reverted.
+  /// Parasitics, special wires, bpins and group/region/module membership
+  /// of destroyed objects are not.
+  ///
+  /// NOTE: An eco can not be started or ended inside a transaction. A
+  ///       transaction inside an eco is recorded in the eco log; a
+  ///       rolled back transaction is removed from it.
+  ///
+  static void beginTransaction(dbBlock* block);
+
+  ///
+  /// Keep the changes of the innermost transaction. They become part of
+  /// the enclosing transaction, if any.
+  ///
+  static void commitTransaction(dbBlock* block);
+
+  ///
+  /// Revert the changes of the innermost transaction.
+  ///
+  static void rollbackTransaction(dbBlock* block);
+
+  ///
+  /// Number of open transactions on the specified block.
+  ///
+  static int transactionDepth(dbBlock* block);
+
   ///
   /// links to utl::Logger
   ///
@@ -1252,6 +1287,12 @@ class dbBlock : public dbObject
   ///
   dbBlockSearch* getSearchDb();
 
+  ///
+  /// Get the area search index shared by all tools working on this block.
+  /// It is created on first use and kept current through block callbacks.
+  ///
+  dbSpatialIndex* getSpatialIndex();
+
   ///
   /// reset _netSdb
   ///
@@ -75,11 +75,15 @@ class dbBlockCallBackObj
   virtual void inDbInstSwapMasterAfter(dbInst*) {}
   virtual void inDbPreMoveInst(dbInst*) {}
   virtual void inDbPostMoveInst(dbInst*) {}
+  virtual void inDbInstRenameBefore(dbInst*, const char* new_name) {}
+  virtual void inDbInstRenameAfter(dbInst*) {}
   // dbInst End
 
   // dbNet Start
   virtual void inDbNetCreate(dbNet*) {}
   virtual void inDbNetDestroy(dbNet*) {}
+  virtual void inDbNetRenameBefore(dbNet*, const char* new_name) {}
+  virtual void inDbNetRenameAfter(dbNet*) {}
   // dbNet End
 
   // dbITerm Start
@@ -103,6 +107,7 @@ class dbBlockCallBackObj
   // dbBPin Start
   virtual void inDbBPinCreate(dbBPin*) {}
   virtual void inDbBPinDestroy(dbBPin*) {}
+  virtual void inDbBPinPlacementStatusBefore(dbBPin*, const dbPlacementStatus&) {}
   // dbBPin End
 
   // dbBlockage Start
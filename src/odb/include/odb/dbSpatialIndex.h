@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "dbBlockCallBackObj.h"
+#include "geom.h"
+
+namespace odb {
+
+class dbBPin;
+class dbInst;
+class dbNet;
+class dbObstruction;
+class dbTechLayer;
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// dbSpatialIndex - A shared area search structure for a block.
+///
+/// Indexes placed instances, routed wires, special wires, obstructions
+/// and block pins.  Each kind of object is indexed on its first query and
+/// then kept current through the block callbacks, so tools that share the
+/// index (see dbBlock::getSpatialIndex) pay for the build only once.
+///
+/// Queries may be issued concurrently from several threads.  As with the
+/// rest of the database, the block must not be modified while queries
+/// are running.
+///
+/// Limitation: wires, special wires and block pins are re-indexed when
+/// they are created, destroyed, attached or detached, and block pins also
+/// when their placement status changes.  Editing them in place
+/// (dbWireEncoder on an existing wire, new sboxes on an existing dbSWire,
+/// new boxes on an existing dbBPin) is not reported by the database; call
+/// invalidate() after such edits.
+///
+///////////////////////////////////////////////////////////////////////////////
+class dbSpatialIndex : public dbBlockCallBackObj
+{
+ public:
+  template <typename T>
+  using Shapes = std::vector<std::pair<Rect, T>>;
+
+  dbSpatialIndex(dbBlock* block);
+  ~dbSpatialIndex();
+
+  ///
+  /// Placed instances whose bbox intersects area.
+  ///
+  std::vector<dbInst*> findInsts(const Rect& area);
+
+  ///
+  /// Wire shapes (including via layer shapes) of routed nets on layer
+  /// intersecting area.
+  ///
+  Shapes<dbNet*> findWires(dbTechLayer* layer, const Rect& area);
+
+  ///
+  /// Special wire shapes on layer intersecting area.
+  ///
+  Shapes<dbNet*> findSWires(dbTechLayer* layer, const Rect& area);
+
+  ///
+  /// Obstructions on layer intersecting area.
+  ///
+  Shapes<dbObstruction*> findObstructions(dbTechLayer* layer,
+                                          const Rect& area);
+
+  ///
+  /// Block pin shapes on layer intersecting area.
+  ///
+  Shapes<dbBPin*> findBPins(dbTechLayer* layer, const Rect& area);
+
+  ///
+  /// Drop everything; the index is rebuilt on the next query.
+  ///
+  void invalidate();
+
+  // dbBlockCallBackObj
+  void inDbInstCreate(dbInst* inst) override;
+  void inDbInstCreate(dbInst* inst, dbRegion* region) override;
+  void inDbInstDestroy(dbInst* inst) override;
+  void inDbInstPlacementStatusBefore(dbInst* inst,
+                                     const dbPlacementStatus& status) override;
+  void inDbInstSwapMasterBefore(dbInst* inst, dbMaster* master) override;
+  void inDbInstSwapMasterAfter(dbInst* inst) override;
+  void inDbPreMoveInst(dbInst* inst) override;
+  void inDbPostMoveInst(dbInst* inst) override;
+  void inDbNetDestroy(dbNet* net) override;
+  void inDbBPinCreate(dbBPin* pin) override;
+  void inDbBPinDestroy(dbBPin* pin) override;
+  void inDbBPinPlacementStatusBefore(dbBPin* pin,
+                                     const dbPlacementStatus& status) override;
+  void inDbObstructionCreate(dbObstruction* obs) override;
+  void inDbObstructionDestroy(dbObstruction* obs) override;
+  void inDbWireCreate(dbWire* wire) override;
+  void inDbWireDestroy(dbWire* wire) override;
+  void inDbWirePostAttach(dbWire* wire) override;
+  void inDbWirePostDetach(dbWire* wire, dbNet* net) override;
+  void inDbWirePostAppend(dbWire* src, dbWire* dst) override;
+  void inDbWirePostCopy(dbWire* src, dbWire* dst) override;
+  void inDbSWireCreate(dbSWire* wire) override;
+  void inDbSWireDestroy(dbSWire* wire) override;
+  void inDbSWirePostDestroySBoxes(dbSWire* wire) override;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace odb
@@ -132,6 +132,8 @@ class lefout
   void setUseMasterIds(bool value) { _use_master_ids = value; }
 
   bool writeTech(dbTech* tech, const char* lef_file);
+  // Writes the tech to an open stream, which the caller closes.
+  void writeTech(dbTech* tech, FILE* out);
   bool writeLib(dbLib* lib, const char* lef_file);
   bool writeTechAndLib(dbLib* lib, const char* lef_file);
   bool writeAbstractLef(dbBlock* db_block, const char* lef_file);
@@ -36,11 +36,37 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <functional>
+#include <vector>
+
 #include "array1.h"
 
 class Ath__parser
 {
+ public:
+  // parallel_for(begin, end, body) calls body(i) for each i in [begin, end).
+  using ParallelFor
+      = std::function<void(int, int, const std::function<void(int)>&)>;
+
  private:
+  // Words and lines of a mapped file, as offsets into the map.
+  struct MappedWord
+  {
+    size_t start;
+    int len;
+  };
+  struct MappedLine
+  {
+    size_t end;
+    int firstWord;
+    int wordCnt;
+  };
+  struct MappedChunk
+  {
+    std::vector<MappedLine> lines;
+    std::vector<MappedWord> words;
+  };
+
   char* _line;
   char* _tmpLine;
   char* _wordSeparators;
@@ -59,6 +85,29 @@ class Ath__parser
   int _dbg;
   int _progressLineChunk;
 
+  // Input mapped by mapFile. _mapPos is the end of the last line read.
+  char* _map;
+  size_t _mapSize;
+  size_t _mapPos;
+
+  // Lines after _mapPos already split into words, see setParallelFor.
+  std::vector<MappedChunk> _chunks;
+  int _chunkIdx;
+  int _chunkLineIdx;
+  int _parallelTasks;
+  ParallelFor _parallelFor;
+
+  bool getLine();
+  size_t mappedLineEnd(size_t pos) const;
+  bool readMappedWords(int jj);
+  void splitMappedWords();
+  void splitMappedChunk(size_t start,
+                        size_t end,
+                        const bool* isSep,
+                        MappedChunk& chunk) const;
+  void dropMappedWords();
+  void unmapFile();
+
  public:
   Ath__parser();
   Ath__parser(int lSize, int wCnt, int wSize);
@@ -67,6 +116,13 @@ class Ath__parser
   void getTmpLine();
   ~Ath__parser();
   void openFile(char* name = NULL);
+  // Read the file through a memory map; .gz files and files that cannot be
+  // mapped are opened with openFile. Returns true if the file was mapped.
+  bool mapFile(char* name);
+  // Split the lines of a mapped file into words ahead of the reader in
+  // chunks of lines run by parallel_for on up to tasks threads.
+  // tasks <= 1 splits each line as it is read.
+  void setParallelFor(int tasks, const ParallelFor& parallel_for);
   void setInputFP(FILE* fp);
   void setDbg(int v);
   FILE* getDbgFP();
@@ -205,8 +205,13 @@ dbPlacementStatus dbBPin::getPlacementStatus()
 void dbBPin::setPlacementStatus(dbPlacementStatus status)
 {
   _dbBPin* bpin = (_dbBPin*) this;
-  bpin->_flags._status = status.getValue();
   _dbBlock* block = (_dbBlock*) bpin->getOwner();
+
+  for (auto callback : block->_callbacks) {
+    callback->inDbBPinPlacementStatusBefore(this, status);
+  }
+
+  bpin->_flags._status = status.getValue();
   block->_flags._valid_bbox = 0;
 }
 
@@ -419,6 +419,7 @@ void dbBTerm::connect(dbNet* net_)
     block->_journal->pushParam(dbBTermObj);
     block->_journal->pushParam(bterm->getId());
     block->_journal->pushParam(net_->getId());
+    block->_journal->pushParam((uint) bterm->_net);
     block->_journal->endAction();
   }
 
@@ -443,6 +444,7 @@ void dbBTerm::disconnect()
       block->_journal->beginAction(dbJournal::DISCONNECT_OBJECT);
       block->_journal->pushParam(dbBTermObj);
       block->_journal->pushParam(bterm->getId());
+      block->_journal->pushParam((uint) bterm->_net);
       block->_journal->endAction();
     }
 
@@ -654,6 +656,7 @@ void dbBTerm::destroy(dbBTerm* bterm_)
   for (itr = bpins.begin(); itr != bpins.end();) {
     itr = dbBPin::destroy(itr);
   }
+  uint net_id = bterm->_net;
   if (bterm->_net)
     bterm->disconnectNet(bterm, block);
   for (auto callback : block->_callbacks)
@@ -669,6 +672,9 @@ void dbBTerm::destroy(dbBTerm* bterm_)
     block->_journal->beginAction(dbJournal::DELETE_OBJECT);
     block->_journal->pushParam(dbBTermObj);
     block->_journal->pushParam(bterm_->getId());
+    block->_journal->pushParam(net_id);
+    block->_journal->pushParam(bterm->_name);
+    block->_journal->pushParam(flagsToUInt(bterm));
     block->_journal->endAction();
   }
 
@@ -98,6 +98,7 @@
 #include "dbSWireItr.h"
 #include "dbSearch.h"
 #include "dbShape.h"
+#include "dbSpatialIndex.h"
 #include "dbTable.h"
 #include "dbTable.hpp"
 #include "dbTech.h"
@@ -389,6 +390,7 @@ _dbBlock::_dbBlock(_dbDatabase* db)
 
   _num_ext_dbs = 1;
   _searchDb = NULL;
+  _spatial_index = nullptr;
   _extmi = NULL;
   _ptFile = NULL;
   _journal = NULL;
@@ -612,6 +614,7 @@ _dbBlock::_dbBlock(_dbDatabase* db, const _dbBlock& block)
 
   // ??? Initialize search-db on copy?
   _searchDb = NULL;
+  _spatial_index = nullptr;
 
   // ??? callbacks
   // _callbacks = ???
@@ -682,6 +685,8 @@ _dbBlock::~_dbBlock()
   delete _region_itr;
   delete _prop_itr;
 
+  delete _spatial_index;
+
   std::list<dbBlockCallBackObj*>::iterator _cbitr;
   while (_callbacks.begin() != _callbacks.end()) {
     _cbitr = _callbacks.begin();
@@ -714,6 +719,10 @@ void dbBlock::clear()
 
   std::list<dbBlockCallBackObj*> callbacks;
 
+  // the spatial index belongs to the old contents
+  delete block->_spatial_index;
+  block->_spatial_index = nullptr;
+
   // save callbacks
   callbacks.swap(block->_callbacks);
 
@@ -2648,6 +2657,14 @@ dbBlockSearch* dbBlock::getSearchDb()
   return block->_searchDb;
 }
 
+dbSpatialIndex* dbBlock::getSpatialIndex()
+{
+  _dbBlock* block = (_dbBlock*) this;
+  if (block->_spatial_index == nullptr)
+    block->_spatial_index = new dbSpatialIndex(this);
+  return block->_spatial_index;
+}
+
 #ifdef ZUI
 ZPtr<ISdb> dbBlock::getSignalNetSdb(ZContext& context, dbTech* tech)
 {
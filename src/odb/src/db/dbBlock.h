@@ -119,6 +119,7 @@ class dbOStream;
 class dbDiff;
 class dbBlockSearch;
 class dbBlockCallBackObj;
+class dbSpatialIndex;
 
 struct _dbBTermPin
 {
@@ -244,6 +245,7 @@ class _dbBlock : public _dbObject
   dbRegionItr* _region_itr;
   dbPropertyItr* _prop_itr;
   dbBlockSearch* _searchDb;
+  dbSpatialIndex* _spatial_index;
 
   float _WNS[2];
   float _TNS[2];
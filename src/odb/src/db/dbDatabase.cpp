@@ -33,6 +33,7 @@
 #include "dbDatabase.h"
 
 #include <algorithm>
+#include <exception>
 #include <map>
 #include <string>
 
@@ -620,8 +621,13 @@ void dbDatabase::beginEco(dbBlock* block_)
 {
   _dbBlock* block = (_dbBlock*) block_;
 
-  if (block->_journal)
+  if (block->_journal) {
+    if (block->_journal->transactionDepth() > 0) {
+      block->getImpl()->getLogger()->error(
+          utl::ODB, 298, "Cannot begin or end an eco inside a transaction.");
+    }
     delete block->_journal;
+  }
 
   block->_journal = new dbJournal(block_);
   assert(block->_journal);
@@ -631,6 +637,12 @@ void dbDatabase::endEco(dbBlock* block_)
 {
   _dbBlock* block = (_dbBlock*) block_;
   dbJournal* eco = block->_journal;
+
+  if (eco && eco->transactionDepth() > 0) {
+    block->getImpl()->getLogger()->error(
+        utl::ODB, 298, "Cannot begin or end an eco inside a transaction.");
+  }
+
   block->_journal = NULL;
 
   if (block->_journal_pending)
@@ -675,7 +687,13 @@ void dbDatabase::readEco(dbBlock* block_, const char* filename)
   dbIStream stream(block->getDatabase(), file);
   dbJournal* eco = new dbJournal(block_);
   assert(eco);
-  stream >> *eco;
+  try {
+    stream >> *eco;
+  } catch (const std::exception&) {
+    delete eco;
+    fclose(file);
+    throw;
+  }
 
   if (block->_journal_pending)
     delete block->_journal_pending;
@@ -719,6 +737,66 @@ void dbDatabase::commitEco(dbBlock* block_)
   }
 }
 
+void dbDatabase::beginTransaction(dbBlock* block_)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+
+  // Without an eco in progress the journal only lives as long as the
+  // outermost transaction.
+  if (block->_journal == NULL) {
+    block->_journal = new dbJournal(block_);
+    block->_journal->setTransient(true);
+  }
+
+  block->_journal->beginTransaction();
+}
+
+static dbJournal* endTransaction(_dbBlock* block)
+{
+  dbJournal* journal = block->_journal;
+
+  if (journal == NULL || journal->transactionDepth() == 0) {
+    block->getImpl()->getLogger()->error(
+        utl::ODB, 299, "No transaction in progress.");
+  }
+
+  return journal;
+}
+
+static void releaseTransientJournal(_dbBlock* block)
+{
+  dbJournal* journal = block->_journal;
+
+  if (journal->isTransient() && journal->transactionDepth() == 0) {
+    delete journal;
+    block->_journal = NULL;
+  }
+}
+
+void dbDatabase::commitTransaction(dbBlock* block_)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+  endTransaction(block)->commitTransaction();
+  releaseTransientJournal(block);
+}
+
+void dbDatabase::rollbackTransaction(dbBlock* block_)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+  endTransaction(block)->rollbackTransaction();
+  releaseTransientJournal(block);
+}
+
+int dbDatabase::transactionDepth(dbBlock* block_)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+
+  if (block->_journal)
+    return block->_journal->transactionDepth();
+
+  return 0;
+}
+
 void dbDatabase::setLogger(utl::Logger* logger)
 {
   _dbDatabase* _db = (_dbDatabase*) this;
@@ -450,12 +450,18 @@ bool dbInst::rename(const char* name)
   if (block->_inst_hash.hasMember(name))
     return false;
 
+  for (auto callback : block->_callbacks)
+    callback->inDbInstRenameBefore(this, name);
+
   block->_inst_hash.remove(inst);
   free((void*) inst->_name);
   inst->_name = strdup(name);
   ZALLOCATED(inst->_name);
   block->_inst_hash.insert(inst);
 
+  for (auto callback : block->_callbacks)
+    callback->inDbInstRenameAfter(this);
+
   return true;
 }
 
@@ -1454,9 +1460,20 @@ void dbInst::destroy(dbInst* inst_)
                "DB_ECO",
                1,
                "ECO: dbInst:destroy");
+    dbMaster* master = inst_->getMaster();
     block->_journal->beginAction(dbJournal::DELETE_OBJECT);
     block->_journal->pushParam(dbInstObj);
     block->_journal->pushParam(inst->getId());
+    block->_journal->pushParam(master->getLib()->getId());
+    block->_journal->pushParam(master->getId());
+    block->_journal->pushParam(inst->_name);
+    block->_journal->pushParam(flagsToUInt(inst));
+    block->_journal->pushParam(inst->_x);
+    block->_journal->pushParam(inst->_y);
+    // undo re-creates the iterms with these ids
+    block->_journal->pushParam(n);
+    for (i = 0; i < n; ++i)
+      block->_journal->pushParam((uint) inst->_iterms[i]);
     block->_journal->endAction();
   }
 
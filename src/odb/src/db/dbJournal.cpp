@@ -41,6 +41,8 @@
 #include "dbInst.h"
 #include "dbNet.h"
 #include "dbRSeg.h"
+#include "dbTable.h"
+#include "dbWire.h"
 #include "utl/Logger.h"
 
 namespace odb {
@@ -54,7 +56,9 @@ dbJournal::dbJournal(dbBlock* block)
       _logger(block->getImpl()->getLogger()),
       _start_action(false),
       _action_idx(0),
-      _cur_action(0)
+      _cur_action(0),
+      _transient(false),
+      _undo_skipped(0)
 {
 }
 
@@ -67,6 +71,27 @@ void dbJournal::clear()
 {
   _log.clear();
   _start_action = false;
+  _transactions.clear();
+}
+
+void dbJournal::beginTransaction()
+{
+  assert(_start_action == false);
+  _transactions.push_back(_log.size());
+}
+
+void dbJournal::commitTransaction()
+{
+  // The entries now belong to the enclosing transaction (or eco).
+  _transactions.pop_back();
+}
+
+void dbJournal::rollbackTransaction()
+{
+  uint start = _transactions.back();
+  _transactions.pop_back();
+  undo(start);
+  _log.truncate(start);
 }
 
 void dbJournal::updateField(dbObject* obj,
@@ -236,6 +261,40 @@ void dbJournal::endAction()
   _log.push(_action_idx);  // This value allows log to be scanned backwards.
 }
 
+void dbJournal::pushWire(dbWire* wire_)
+{
+  _dbWire* wire = (_dbWire*) wire_;
+  _log.push((uint) wire->_data.size());
+  for (int value : wire->_data)
+    _log.push(value);
+  _log.push((uint) wire->_opcodes.size());
+  for (unsigned char opcode : wire->_opcodes)
+    _log.push(opcode);
+}
+
+// Pops the wire contents pushed by pushWire. If wire is null the
+// contents are discarded.
+void dbJournal::popWire(_dbWire* wire)
+{
+  uint size;
+  _log.pop(size);
+  std::vector<int> data(size);
+  for (uint i = 0; i < size; ++i)
+    _log.pop(data[i]);
+
+  _log.pop(size);
+  std::vector<unsigned char> opcodes(size);
+  for (uint i = 0; i < size; ++i)
+    _log.pop(opcodes[i]);
+
+  if (wire == nullptr)
+    return;
+
+  wire->_data = data;
+  wire->_opcodes = opcodes;
+  ((_dbBlock*) _block)->_flags._valid_bbox = 0;
+}
+
 void dbJournal::redo()
 {
   _log.begin();
@@ -408,6 +467,24 @@ void dbJournal::redo_createObject()
                  b->getId(),
                  merge);
       dbCCSeg::create(a, b, merge);
+      break;
+    }
+
+    case dbWireObj: {
+      uint net_id;
+      bool is_global;
+      _log.pop(net_id);
+      _log.pop(is_global);
+      dbNet* net = dbNet::getNet(_block, net_id);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "REDO ECO: create dbWireObj, net_id {}, global {}",
+                 net_id,
+                 is_global);
+      dbWire::create(net, is_global);
+      break;
     }
 
     default:
@@ -424,6 +501,10 @@ void dbJournal::redo_deleteObject()
     case dbNetObj: {
       uint net_id;
       _log.pop(net_id);
+      std::string name;
+      _log.pop(name);
+      uint flags;
+      _log.pop(flags);
       dbNet* net = dbNet::getNet(_block, net_id);
       debugPrint(_logger,
                  utl::ODB,
@@ -438,6 +519,12 @@ void dbJournal::redo_deleteObject()
     case dbBTermObj: {
       uint bterm_id;
       _log.pop(bterm_id);
+      uint net_id;
+      _log.pop(net_id);
+      std::string name;
+      _log.pop(name);
+      uint flags;
+      _log.pop(flags);
       dbBTerm* bterm = dbBTerm::getBTerm(_block, bterm_id);
       debugPrint(_logger,
                  utl::ODB,
@@ -451,6 +538,24 @@ void dbJournal::redo_deleteObject()
     case dbInstObj: {
       uint inst_id;
       _log.pop(inst_id);
+      uint lib_id;
+      _log.pop(lib_id);
+      uint master_id;
+      _log.pop(master_id);
+      std::string name;
+      _log.pop(name);
+      uint flags;
+      _log.pop(flags);
+      int x;
+      _log.pop(x);
+      int y;
+      _log.pop(y);
+      uint iterm_cnt;
+      _log.pop(iterm_cnt);
+      for (uint i = 0; i < iterm_cnt; ++i) {
+        uint iterm_id;
+        _log.pop(iterm_id);
+      }
       dbInst* inst = dbInst::getInst(_block, inst_id);
       debugPrint(_logger,
                  utl::ODB,
@@ -530,6 +635,27 @@ void dbJournal::redo_deleteObject()
       }
       break;
     }
+
+    case dbWireObj: {
+      uint net_id;
+      bool is_global;
+      _log.pop(net_id);
+      _log.pop(is_global);
+      popWire(nullptr);
+      dbNet* net = dbNet::getNet(_block, net_id);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "REDO ECO: destroy dbWire, net_id {}, global {}",
+                 net_id,
+                 is_global);
+      dbWire* wire = is_global ? net->getGlobalWire() : net->getWire();
+      if (wire)
+        dbWire::destroy(wire);
+      break;
+    }
+
     default:
       break;
   }
@@ -565,6 +691,8 @@ void dbJournal::redo_connectObject()
       dbBTerm* bterm = dbBTerm::getBTerm(_block, bterm_id);
       uint net_id;
       _log.pop(net_id);
+      uint prev_net_id;
+      _log.pop(prev_net_id);
       dbNet* net = dbNet::getNet(_block, net_id);
       debugPrint(_logger,
                  utl::ODB,
@@ -590,6 +718,8 @@ void dbJournal::redo_disconnectObject()
     case dbITermObj: {
       uint iterm_id;
       _log.pop(iterm_id);
+      uint net_id;
+      _log.pop(net_id);
       dbITerm* iterm = dbITerm::getITerm(_block, iterm_id);
       debugPrint(_logger,
                  utl::ODB,
@@ -604,6 +734,8 @@ void dbJournal::redo_disconnectObject()
     case dbBTermObj: {
       uint bterm_id;
       _log.pop(bterm_id);
+      uint net_id;
+      _log.pop(net_id);
       dbBTerm* bterm = dbBTerm::getBTerm(_block, bterm_id);
       bterm->disconnect();
 
@@ -697,6 +829,10 @@ void dbJournal::redo_updateField()
       redo_updateCapNodeField();
       break;
 
+    case dbWireObj:
+      redo_updateWireField();
+      break;
+
     default:
       break;
   }
@@ -997,6 +1133,30 @@ void dbJournal::redo_updateITermField()
   }
 }
 
+void dbJournal::redo_updateWireField()
+{
+  uint wire_id;
+  _log.pop(wire_id);
+  _dbWire* wire = (_dbWire*) dbWire::getWire(_block, wire_id);
+
+  int field;
+  _log.pop(field);
+
+  switch ((_dbWire::Field) field) {
+    case _dbWire::DATA: {
+      popWire(nullptr);
+      popWire(wire);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "REDO ECO: dbWire {}, update data",
+                 wire_id);
+      break;
+    }
+  }
+}
+
 void dbJournal::redo_updateRSegField()
 {
   uint rseg_id;
@@ -1390,18 +1550,33 @@ void dbJournal::redo_updateCCSegField()
   }
 }
 
+void dbJournal::undo()
+{
+  undo(0);
+}
+
 //
-// WORK-IN-PROGRESS undo does not yet work.
+// The log is scanned backwards from the end to idx using the action
+// offset stored at the end of each entry. The edits that revert an
+// entry go through the regular db api, so the block callbacks (dbSta,
+// gui, ...) see them, but they are not journaled.
 //
-void dbJournal::undo()
+void dbJournal::undo(uint idx)
 {
-  if (_log.empty())
+  _undo_skipped = 0;
+
+  if (_log.size() <= idx)
     return;
 
-  _log.set(_log.size() - sizeof(uint));
+  _dbBlock* block = (_dbBlock*) _block;
+  dbJournal* journal = block->_journal;
+  block->_journal = NULL;
+
+  uint end = _log.size();
 
-  for (;;) {
+  while (end > idx) {
     uint action_idx;
+    _log.setUIntBefore(end);
     _log.pop(action_idx);
     _log.set(action_idx);
     _log.pop(_cur_action);
@@ -1436,10 +1611,16 @@ void dbJournal::undo()
         break;
     }
 
-    if (action_idx == 0)
-      break;
+    end = action_idx;
+  }
+
+  block->_journal = journal;
 
-    _log.set(action_idx -= sizeof(uint));
+  if (_undo_skipped > 0) {
+    _logger->warn(utl::ODB,
+                  297,
+                  "Undo skipped {} parasitic or block journal entries.",
+                  _undo_skipped);
   }
 }
 
@@ -1449,13 +1630,66 @@ void dbJournal::undo_createObject()
   _log.pop(obj_type);
 
   switch ((dbObjectType) obj_type) {
-    case dbNetObj:
-    case dbInstObj:
-    case dbRSegObj:
-    case dbCapNodeObj:
-    case dbCCSegObj:
+    case dbNetObj: {
+      std::string name;
+      _log.pop(name);
+      debugPrint(
+          _logger, utl::ODB, "DB_ECO", 2, "UNDO ECO: create dbNet {}", name);
+      dbNet* net = _block->findNet(name.c_str());
+      if (net)
+        dbNet::destroy(net);
+      break;
+    }
+
+    case dbBTermObj: {
+      uint net_id;
+      std::string name;
+      _log.pop(net_id);
+      _log.pop(name);
+      debugPrint(
+          _logger, utl::ODB, "DB_ECO", 2, "UNDO ECO: create dbBTerm {}", name);
+      dbBTerm* bterm = _block->findBTerm(name.c_str());
+      if (bterm)
+        dbBTerm::destroy(bterm);
+      break;
+    }
+
+    case dbInstObj: {
+      uint lib_id;
+      uint master_id;
+      std::string name;
+      _log.pop(lib_id);
+      _log.pop(master_id);
+      _log.pop(name);
+      debugPrint(
+          _logger, utl::ODB, "DB_ECO", 2, "UNDO ECO: create dbInst {}", name);
+      dbInst* inst = _block->findInst(name.c_str());
+      if (inst)
+        dbInst::destroy(inst);
+      break;
+    }
+
+    case dbWireObj: {
+      uint net_id;
+      bool is_global;
+      _log.pop(net_id);
+      _log.pop(is_global);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: create dbWire, net_id {}, global {}",
+                 net_id,
+                 is_global);
+      dbNet* net = dbNet::getNet(_block, net_id);
+      dbWire* wire = is_global ? net->getGlobalWire() : net->getWire();
+      if (wire)
+        dbWire::destroy(wire);
+      break;
+    }
 
     default:
+      ++_undo_skipped;
       break;
   }
 }
@@ -1466,12 +1700,116 @@ void dbJournal::undo_deleteObject()
   _log.pop(obj_type);
 
   switch ((dbObjectType) obj_type) {
-    case dbNetObj:
-    case dbInstObj:
-    case dbRSegObj:
-    case dbCapNodeObj:
-    case dbCCSegObj:
+    case dbNetObj: {
+      uint net_id;
+      std::string name;
+      uint flags;
+      _log.pop(net_id);
+      _log.pop(name);
+      _log.pop(flags);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: destroy dbNet {}, net_id {}",
+                 name,
+                 net_id);
+      ((_dbBlock*) _block)->_net_tbl->reuseId(net_id);
+      _dbNet* net = (_dbNet*) dbNet::create(_block, name.c_str());
+      *((uint*) &net->_flags) = flags;
+      break;
+    }
+
+    case dbBTermObj: {
+      uint bterm_id;
+      uint net_id;
+      std::string name;
+      uint flags;
+      _log.pop(bterm_id);
+      _log.pop(net_id);
+      _log.pop(name);
+      _log.pop(flags);
+      if (net_id == 0) {
+        // dbBTerm::create needs a net
+        ++_undo_skipped;
+        break;
+      }
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: destroy dbBTerm {}, bterm_id {}",
+                 name,
+                 bterm_id);
+      ((_dbBlock*) _block)->_bterm_tbl->reuseId(bterm_id);
+      dbNet* net = dbNet::getNet(_block, net_id);
+      _dbBTerm* bterm = (_dbBTerm*) dbBTerm::create(net, name.c_str());
+      *((uint*) &bterm->_flags) = flags;
+      break;
+    }
+
+    case dbInstObj: {
+      uint inst_id;
+      uint lib_id;
+      uint master_id;
+      std::string name;
+      uint flags;
+      int x;
+      int y;
+      _log.pop(inst_id);
+      _log.pop(lib_id);
+      _log.pop(master_id);
+      _log.pop(name);
+      _log.pop(flags);
+      _log.pop(x);
+      _log.pop(y);
+      uint iterm_cnt;
+      _log.pop(iterm_cnt);
+      std::vector<uint> iterm_ids(iterm_cnt);
+      for (uint& iterm_id : iterm_ids)
+        _log.pop(iterm_id);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: destroy dbInst {}, inst_id {}",
+                 name,
+                 inst_id);
+      // Later entries refer to the instance and its iterms by id.
+      // dbInst::create takes the iterms in mterm order, so the first one
+      // goes to the head of the free list last.
+      _dbBlock* block = (_dbBlock*) _block;
+      block->_inst_tbl->reuseId(inst_id);
+      for (auto id = iterm_ids.rbegin(); id != iterm_ids.rend(); ++id)
+        block->_iterm_tbl->reuseId(*id);
+      dbLib* lib = dbLib::getLib(_block->getDb(), lib_id);
+      dbMaster* master = dbMaster::getMaster(lib, master_id);
+      dbInst* inst = dbInst::create(_block, master, name.c_str());
+      restoreInstFlags(inst, flags);
+      inst->setOrigin(x, y);
+      break;
+    }
+
+    case dbWireObj: {
+      uint net_id;
+      bool is_global;
+      _log.pop(net_id);
+      _log.pop(is_global);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: destroy dbWire, net_id {}, global {}",
+                 net_id,
+                 is_global);
+      dbNet* net = dbNet::getNet(_block, net_id);
+      dbWire* wire = dbWire::create(net, is_global);
+      popWire((_dbWire*) wire);
+      break;
+    }
+
     default:
+      ++_undo_skipped;
       break;
   }
 }
@@ -1482,7 +1820,44 @@ void dbJournal::undo_connectObject()
   _log.pop(obj_type);
 
   switch ((dbObjectType) obj_type) {
-    case dbITermObj:
+    case dbITermObj: {
+      uint iterm_id;
+      uint net_id;
+      _log.pop(iterm_id);
+      _log.pop(net_id);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: connect dbITermObj, iterm_id {}, net_id {}",
+                 iterm_id,
+                 net_id);
+      dbITerm::getITerm(_block, iterm_id)->disconnect();
+      break;
+    }
+
+    case dbBTermObj: {
+      uint bterm_id;
+      uint net_id;
+      uint prev_net_id;
+      _log.pop(bterm_id);
+      _log.pop(net_id);
+      _log.pop(prev_net_id);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: connect dbBTermObj, bterm_id {}, net_id {}",
+                 bterm_id,
+                 net_id);
+      dbBTerm* bterm = dbBTerm::getBTerm(_block, bterm_id);
+      if (prev_net_id)
+        bterm->connect(dbNet::getNet(_block, prev_net_id));
+      else
+        bterm->disconnect();
+      break;
+    }
+
     default:
       break;
   }
@@ -1494,7 +1869,40 @@ void dbJournal::undo_disconnectObject()
   _log.pop(obj_type);
 
   switch ((dbObjectType) obj_type) {
-    case dbITermObj:
+    case dbITermObj: {
+      uint iterm_id;
+      uint net_id;
+      _log.pop(iterm_id);
+      _log.pop(net_id);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: disconnect dbITermObj, iterm_id {}, net_id {}",
+                 iterm_id,
+                 net_id);
+      dbITerm::getITerm(_block, iterm_id)
+          ->connect(dbNet::getNet(_block, net_id));
+      break;
+    }
+
+    case dbBTermObj: {
+      uint bterm_id;
+      uint net_id;
+      _log.pop(bterm_id);
+      _log.pop(net_id);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: disconnect dbBTermObj, bterm_id {}, net_id {}",
+                 bterm_id,
+                 net_id);
+      dbBTerm::getBTerm(_block, bterm_id)
+          ->connect(dbNet::getNet(_block, net_id));
+      break;
+    }
+
     default:
       break;
   }
@@ -1506,7 +1914,31 @@ void dbJournal::undo_swapObject()
   _log.pop(obj_type);
 
   switch ((dbObjectType) obj_type) {
-    case dbInstObj:
+    case dbInstObj: {
+      uint inst_id;
+      uint prev_lib_id;
+      uint prev_master_id;
+      uint lib_id;
+      uint master_id;
+      _log.pop(inst_id);
+      _log.pop(prev_lib_id);
+      _log.pop(prev_master_id);
+      _log.pop(lib_id);
+      _log.pop(master_id);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: swapMaster inst {}, back to lib/master: {}/{}",
+                 inst_id,
+                 prev_lib_id,
+                 prev_master_id);
+      dbInst* inst = dbInst::getInst(_block, inst_id);
+      dbLib* lib = dbLib::getLib(_block->getDb(), prev_lib_id);
+      inst->swapMaster(dbMaster::getMaster(lib, prev_master_id));
+      break;
+    }
+
     default:
       break;
   }
@@ -1526,19 +1958,20 @@ void dbJournal::undo_updateField()
       undo_updateInstField();
       break;
 
-    case dbITermObj:
-      undo_updateITermField();
+    case dbBTermObj:
+      undo_updateBTermField();
       break;
 
-    case dbRSegObj:
-      undo_updateRSegField();
+    case dbITermObj:
+      undo_updateITermField();
       break;
 
-    case dbCapNodeObj:
-      undo_updateCapNodeField();
+    case dbWireObj:
+      undo_updateWireField();
       break;
 
     default:
+      ++_undo_skipped;
       break;
   }
 }
@@ -1547,122 +1980,223 @@ void dbJournal::undo_updateNetField()
 {
   uint net_id;
   _log.pop(net_id);
-  //_dbNet * net = (_dbNet *) dbNet::getNet(_block, net_id );
+  _dbNet* net = (_dbNet*) dbNet::getNet(_block, net_id);
 
   int field;
   _log.pop(field);
 
   switch ((_dbNet::Field) field) {
-    case _dbNet::FLAGS:
-    case _dbNet::NON_DEFAULT_RULE:
+    case _dbNet::FLAGS: {
+      uint prev_flags;
+      _log.pop(prev_flags);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: dbNetObj {}, updateNetField back to {}",
+                 net_id,
+                 prev_flags);
+      *((uint*) &net->_flags) = prev_flags;
       break;
+    }
+
+    case _dbNet::NON_DEFAULT_RULE: {
+      uint prev_rule;
+      uint cur_rule;
+      bool prev_block_rule;
+      bool cur_block_rule;
+      _log.pop(prev_rule);
+      _log.pop(cur_rule);
+      _log.pop(prev_block_rule);
+      _log.pop(cur_block_rule);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: dbNetObj {}, updateNonDefaultRule back to {}",
+                 net_id,
+                 prev_rule);
+      net->_non_default_rule = prev_rule;
+      net->_flags._block_rule = prev_block_rule;
+      break;
+    }
+
+    case _dbNet::INVALIDATETIMING:
+      break;
+
     default:
+      ++_undo_skipped;
       break;
   }
 }
 
+// Orientation and placement status are restored through the api so the
+// instance bbox and the callbacks follow.
+void dbJournal::restoreInstFlags(dbInst* inst_, uint flags)
+{
+  _dbInst* inst = (_dbInst*) inst_;
+  _dbInstFlags prev_flags;
+  *((uint*) &prev_flags) = flags;
+
+  if (prev_flags._orient != inst->_flags._orient)
+    inst_->setOrient(dbOrientType(prev_flags._orient));
+
+  if (prev_flags._status != inst->_flags._status)
+    inst_->setPlacementStatus(dbPlacementStatus(prev_flags._status));
+
+  *((uint*) &inst->_flags) = flags;
+}
+
 void dbJournal::undo_updateInstField()
 {
   uint inst_id;
   _log.pop(inst_id);
-  //_dbInst * inst = (_dbInst *) dbInst::getInst(_block, inst_id );
+  dbInst* inst = dbInst::getInst(_block, inst_id);
 
   int field;
   _log.pop(field);
 
-#if 0  // dead code generates warnings -cherry
-    switch( (_dbInst::Field) field )
-    {
-        case _dbInst::FLAGS:
-        case _dbInst::ORIGIN:
-            break;
+  switch ((_dbInst::Field) field) {
+    case _dbInst::FLAGS: {
+      uint prev_flags;
+      _log.pop(prev_flags);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: dbInst {}, updateInstField back to {}",
+                 inst_id,
+                 prev_flags);
+      restoreInstFlags(inst, prev_flags);
+      break;
     }
-#endif
-}
 
-void dbJournal::undo_updateITermField()
-{
-  uint iterm_id;
-  _log.pop(iterm_id);
-  //_dbITerm * iterm = (_dbITerm *) dbITerm::getITerm(_block, iterm_id );
-
-  int field;
-  _log.pop(field);
+    case _dbInst::ORIGIN: {
+      int prev_x;
+      _log.pop(prev_x);
+      int prev_y;
+      _log.pop(prev_y);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: dbInst {}, origin back to {},{}",
+                 inst_id,
+                 prev_x,
+                 prev_y);
+      inst->setOrigin(prev_x, prev_y);
+      break;
+    }
 
-  switch ((_dbITerm::Field) field) {
-    case _dbITerm::FLAGS:
+    case _dbInst::INVALIDATETIMING:
       break;
   }
 }
 
-void dbJournal::undo_updateRSegField()
+void dbJournal::undo_updateBTermField()
 {
-  uint rseg_id;
-  _log.pop(rseg_id);
-  //_dbRSeg * rseg = (_dbRSeg *) dbRSeg::getRSeg(_block, rseg_id );
+  uint bterm_id;
+  _log.pop(bterm_id);
+  _dbBTerm* bterm = (_dbBTerm*) dbBTerm::getBTerm(_block, bterm_id);
 
   int field;
   _log.pop(field);
 
-  switch ((_dbRSeg::Field) field) {
-    case _dbRSeg::FLAGS:
-    case _dbRSeg::SOURCE:
-    case _dbRSeg::TARGET:
-    case _dbRSeg::RESISTANCE:
-    case _dbRSeg::CAPACITANCE:
-      break;
-    default:
+  switch ((_dbBTerm::Field) field) {
+    case _dbBTerm::FLAGS: {
+      uint prev_flags;
+      _log.pop(prev_flags);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: dbBTerm {}, updateBTermField back to {}",
+                 bterm_id,
+                 prev_flags);
+      *((uint*) &bterm->_flags) = prev_flags;
       break;
+    }
   }
 }
 
-void dbJournal::undo_updateCapNodeField()
+void dbJournal::undo_updateITermField()
 {
-  uint node_id;
-  _log.pop(node_id);
-  //_dbCapNode * node = (_dbCapNode *) dbCapNode::getCapNode(_block, node_id );
+  uint iterm_id;
+  _log.pop(iterm_id);
+  _dbITerm* iterm = (_dbITerm*) dbITerm::getITerm(_block, iterm_id);
 
   int field;
   _log.pop(field);
 
-  switch ((_dbCapNode::Fields) field) {
-    case _dbCapNode::FLAGS:
-    case _dbCapNode::CAPACITANCE:
-      break;
-    default:
+  switch ((_dbITerm::Field) field) {
+    case _dbITerm::FLAGS: {
+      uint prev_flags;
+      _log.pop(prev_flags);
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: dbITerm {}, updateITermField back to {}",
+                 iterm_id,
+                 prev_flags);
+      *((uint*) &iterm->_flags) = prev_flags;
       break;
+    }
   }
 }
 
-void dbJournal::undo_updateCCSegField()
+void dbJournal::undo_updateWireField()
 {
-  uint node_id;
-  _log.pop(node_id);
-  //_dbCCSeg * node = (_dbCCSeg *) dbCCSeg::getCCSeg(_block, node_id );
+  uint wire_id;
+  _log.pop(wire_id);
+  _dbWire* wire = (_dbWire*) dbWire::getWire(_block, wire_id);
 
   int field;
   _log.pop(field);
 
-  switch ((_dbCCSeg::Fields) field) {
-    case _dbCCSeg::FLAGS:
-    case _dbCCSeg::CAPACITANCE:
-    case _dbCCSeg::ADDCCCAPACITANCE:
-    case _dbCCSeg::SWAPCAPNODE:
-    case _dbCCSeg::LINKCCSEG:
-    case _dbCCSeg::UNLINKCCSEG:
-    case _dbCCSeg::SETALLCCCAP:
+  switch ((_dbWire::Field) field) {
+    case _dbWire::DATA: {
+      debugPrint(_logger,
+                 utl::ODB,
+                 "DB_ECO",
+                 2,
+                 "UNDO ECO: dbWire {}, restore data",
+                 wire_id);
+      popWire(wire);
       break;
+    }
   }
 }
 
 dbOStream& operator<<(dbOStream& stream, const dbJournal& journal)
 {
+  stream << dbJournal::FORMAT_MAGIC;
+  stream << dbJournal::FORMAT_VERSION;
   stream << journal._log;
   return stream;
 }
 
 dbIStream& operator>>(dbIStream& stream, dbJournal& journal)
 {
+  uint magic;
+  stream >> magic;
+  if (magic != dbJournal::FORMAT_MAGIC) {
+    journal._logger->error(
+        utl::ODB,
+        300,
+        "Journal has no format version. It was written by an older release "
+        "and cannot be read.");
+  }
+  uint version;
+  stream >> version;
+  if (version != dbJournal::FORMAT_VERSION) {
+    journal._logger->error(utl::ODB,
+                           301,
+                           "Journal format version {} is not supported, "
+                           "expected version {}.",
+                           version,
+                           dbJournal::FORMAT_VERSION);
+  }
   stream >> journal._log;
   return stream;
 }
@@ -32,6 +32,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "dbJournalLog.h"
 #include "odb.h"
 
@@ -48,6 +50,8 @@ class dbMaster;
 class dbNet;
 class dbInst;
 class dbITerm;
+class dbWire;
+class _dbWire;
 
 class dbJournal
 {
@@ -57,6 +61,19 @@ class dbJournal
   bool _start_action;
   uint _action_idx;
   unsigned char _cur_action;
+  // Log offsets at which the open (nested) transactions started.
+  std::vector<uint> _transactions;
+  // True if the journal only exists to back transactions (no eco).
+  bool _transient;
+  // Number of entries the last undo could not revert.
+  int _undo_skipped;
+
+  // Written ahead of the log. Logs of another version, or from before the
+  // version was recorded, are rejected on read as their entries differ.
+  static constexpr uint FORMAT_MAGIC = 0x4c4e524a;  // "JRNL"
+  static constexpr uint FORMAT_VERSION = 2;
+
+  void popWire(_dbWire* wire);
 
   void redo_createObject();
   void redo_deleteObject();
@@ -72,6 +89,7 @@ class dbJournal
   void redo_updateCapNodeField();
   void redo_updateCCSegField();
   void redo_updateBTermField();
+  void redo_updateWireField();
 
   void undo_createObject();
   void undo_deleteObject();
@@ -81,10 +99,11 @@ class dbJournal
   void undo_updateField();
   void undo_updateNetField();
   void undo_updateInstField();
+  void undo_updateBTermField();
   void undo_updateITermField();
-  void undo_updateRSegField();
-  void undo_updateCapNodeField();
-  void undo_updateCCSegField();
+  void undo_updateWireField();
+
+  void restoreInstFlags(dbInst* inst, uint flags);
 
  public:
   enum Action
@@ -126,6 +145,9 @@ class dbJournal
   void pushParam(const char* value);
   void endAction();
 
+  // Push the encoded contents of a wire (see popWire).
+  void pushWire(dbWire* wire);
+
   //
   // updateField : helper methods to update fields in objects.
   //
@@ -175,8 +197,23 @@ class dbJournal
   // undo the transaction log
   void undo();
 
+  // undo the transaction log back to the given log offset
+  void undo(uint idx);
+
   bool empty() { return _log.empty(); }
 
+  //
+  // Transactions: nested marks in the log that can be committed
+  // (kept) or rolled back (undone and dropped from the log).
+  //
+  void beginTransaction();
+  void commitTransaction();
+  void rollbackTransaction();
+  int transactionDepth() const { return _transactions.size(); }
+
+  bool isTransient() const { return _transient; }
+  void setTransient(bool transient) { _transient = transient; }
+
   friend dbIStream& operator>>(dbIStream& stream, dbJournal& jrnl);
   friend dbOStream& operator<<(dbOStream& stream, const dbJournal& jrnl);
   friend class dbDatabase;
@@ -75,6 +75,21 @@ class dbJournalLog
   bool end() { return _idx == (int) _data.size(); }
   void set(uint idx) { _idx = idx; }
 
+  // Position the log on the unsigned int that ends at idx.
+  // Used to scan the log backwards.
+  void setUIntBefore(uint idx)
+  {
+    _idx = idx - sizeof(unsigned int) - (_debug ? 1 : 0);
+  }
+
+  // Discard the log entries at and after idx.
+  void truncate(uint idx)
+  {
+    _data.truncate(idx);
+    if (_idx > (int) idx)
+      _idx = idx;
+  }
+
   void pop(bool& value);
   void pop(char& value);
   void pop(unsigned char& value);
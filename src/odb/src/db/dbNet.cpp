@@ -649,12 +649,18 @@ bool dbNet::rename(const char* name)
   if (block->_net_hash.hasMember(name))
     return false;
 
+  for (auto callback : block->_callbacks)
+    callback->inDbNetRenameBefore(this, name);
+
   block->_net_hash.remove(net);
   free((void*) net->_name);
   net->_name = strdup(name);
   ZALLOCATED(net->_name);
   block->_net_hash.insert(net);
 
+  for (auto callback : block->_callbacks)
+    callback->inDbNetRenameAfter(this);
+
   return true;
 }
 
@@ -2709,8 +2715,8 @@ void dbNet::setNonDefaultRule(dbTechNonDefaultRule* rule)
     // block->_journal->updateField(this, _dbNet::NON_DEFAULT_RULE, prev_rule,
     // net->_non_default_rule );
     block->_journal->beginAction(dbJournal::UPDATE_FIELD);
-    block->_journal->pushParam(rule->getObjectType());
-    block->_journal->pushParam(rule->getId());
+    block->_journal->pushParam(dbNetObj);
+    block->_journal->pushParam(getId());
     block->_journal->pushParam(_dbNet::NON_DEFAULT_RULE);
     block->_journal->pushParam(prev_rule);
     block->_journal->pushParam((uint) net->_non_default_rule);
@@ -2976,6 +2982,8 @@ void dbNet::destroy(dbNet* net_)
     block->_journal->beginAction(dbJournal::DELETE_OBJECT);
     block->_journal->pushParam(dbNetObj);
     block->_journal->pushParam(net->getId());
+    block->_journal->pushParam(net->_name);
+    block->_journal->pushParam(flagsToUInt(net));
     block->_journal->endAction();
   }
 
@@ -82,6 +82,14 @@ class dbPagedVector
   }
 
   unsigned int size() const { return _next_idx; }
+
+  // Drop the items at and after idx. The pages are kept for reuse.
+  void truncate(unsigned int idx)
+  {
+    if (idx < _next_idx)
+      _next_idx = idx;
+  }
+
   unsigned int getIdx(uint chunkSize, const T& ival);  // DKF - to delete
   void freeIdx(uint idx);                              // DKF - to delete
   void clear();
@@ -0,0 +1,640 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "dbSpatialIndex.h"
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <map>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "db.h"
+#include "dbShape.h"
+#include "dbWireCodec.h"
+
+namespace odb {
+
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+using BPoint = bg::model::d2::point_xy<int, bg::cs::cartesian>;
+using BBox = bg::model::box<BPoint>;
+
+static BBox toBox(const Rect& rect)
+{
+  return BBox(BPoint(rect.xMin(), rect.yMin()),
+              BPoint(rect.xMax(), rect.yMax()));
+}
+
+static Rect toRect(const BBox& box)
+{
+  return Rect(box.min_corner().x(),
+              box.min_corner().y(),
+              box.max_corner().x(),
+              box.max_corner().y());
+}
+
+// One rtree per layer plus, for every owner, the values it inserted so
+// they can be removed again when the owner changes.
+template <typename T>
+class LayerIndex
+{
+ public:
+  using Value = std::pair<BBox, T>;
+  using RTree = bgi::rtree<Value, bgi::quadratic<16>>;
+
+  void add(dbTechLayer* layer, const Rect& rect, T owner)
+  {
+    if (layer == nullptr) {
+      return;
+    }
+    Value value(toBox(rect), owner);
+    trees_[layer].insert(value);
+    owned_[owner].emplace_back(layer, value.first);
+  }
+
+  void remove(T owner)
+  {
+    auto it = owned_.find(owner);
+    if (it == owned_.end()) {
+      return;
+    }
+    for (auto& [layer, box] : it->second) {
+      trees_[layer].remove(Value(box, owner));
+    }
+    owned_.erase(it);
+  }
+
+  void clear()
+  {
+    trees_.clear();
+    owned_.clear();
+  }
+
+  dbSpatialIndex::Shapes<T> query(dbTechLayer* layer, const Rect& area) const
+  {
+    dbSpatialIndex::Shapes<T> result;
+    auto it = trees_.find(layer);
+    if (it == trees_.end()) {
+      return result;
+    }
+    for (auto itr = it->second.qbegin(bgi::intersects(toBox(area)));
+         itr != it->second.qend();
+         ++itr) {
+      result.emplace_back(toRect(itr->first), itr->second);
+    }
+    return result;
+  }
+
+ private:
+  std::map<dbTechLayer*, RTree> trees_;
+  std::unordered_map<T, std::vector<std::pair<dbTechLayer*, BBox>>> owned_;
+};
+
+class dbSpatialIndex::Impl
+{
+ public:
+  using InstValue = std::pair<BBox, dbInst*>;
+  using InstRTree = bgi::rtree<InstValue, bgi::quadratic<16>>;
+
+  explicit Impl(dbBlock* block) : block_(block) {}
+
+  // Brings a category up to date.  Returns with no lock held; queries
+  // then take a shared lock.
+  void syncInsts();
+  void syncWires();
+  void syncSWires();
+  void syncObstructions();
+  void syncBPins();
+
+  void addInst(dbInst* inst);
+  void removeInst(dbInst* inst);
+  void addWire(dbNet* net);
+  void addSWire(dbNet* net);
+  void addBPin(dbBPin* pin);
+  void addObstruction(dbObstruction* obs);
+
+  void wireChanged(dbNet* net);
+  void swireChanged(dbNet* net);
+
+  void clear();
+
+  dbBlock* block_;
+  std::shared_mutex mutex_;
+
+  InstRTree insts_;
+  std::unordered_map<dbInst*, BBox> inst_boxes_;
+  bool insts_built_ = false;
+
+  LayerIndex<dbNet*> wires_;
+  std::set<dbNet*> dirty_wires_;
+  bool wires_built_ = false;
+
+  LayerIndex<dbNet*> swires_;
+  std::set<dbNet*> dirty_swires_;
+  bool swires_built_ = false;
+
+  LayerIndex<dbObstruction*> obstructions_;
+  bool obstructions_built_ = false;
+
+  LayerIndex<dbBPin*> bpins_;
+  std::set<dbBPin*> dirty_bpins_;
+  bool bpins_built_ = false;
+};
+
+void dbSpatialIndex::Impl::addInst(dbInst* inst)
+{
+  if (!inst->getPlacementStatus().isPlaced()) {
+    return;
+  }
+  Rect rect;
+  inst->getBBox()->getBox(rect);
+  BBox box = toBox(rect);
+  insts_.insert(InstValue(box, inst));
+  inst_boxes_[inst] = box;
+}
+
+void dbSpatialIndex::Impl::removeInst(dbInst* inst)
+{
+  auto it = inst_boxes_.find(inst);
+  if (it == inst_boxes_.end()) {
+    return;
+  }
+  insts_.remove(InstValue(it->second, inst));
+  inst_boxes_.erase(it);
+}
+
+void dbSpatialIndex::Impl::addWire(dbNet* net)
+{
+  dbWire* wire = net->getWire();
+  if (wire == nullptr) {
+    return;
+  }
+  dbWireShapeItr itr;
+  dbShape shape;
+  std::vector<dbShape> via_boxes;
+  for (itr.begin(wire); itr.next(shape);) {
+    if (shape.isVia()) {
+      dbShape::getViaBoxes(shape, via_boxes);
+      for (dbShape& box : via_boxes) {
+        wires_.add(box.getTechLayer(),
+                   Rect(box.xMin(), box.yMin(), box.xMax(), box.yMax()),
+                   net);
+      }
+    } else {
+      wires_.add(shape.getTechLayer(),
+                 Rect(shape.xMin(), shape.yMin(), shape.xMax(), shape.yMax()),
+                 net);
+    }
+  }
+}
+
+void dbSpatialIndex::Impl::addSWire(dbNet* net)
+{
+  std::vector<dbShape> via_boxes;
+  for (dbSWire* swire : net->getSWires()) {
+    for (dbSBox* box : swire->getWires()) {
+      if (box->isVia()) {
+        box->getViaBoxes(via_boxes);
+        for (dbShape& via_box : via_boxes) {
+          swires_.add(via_box.getTechLayer(),
+                      Rect(via_box.xMin(),
+                           via_box.yMin(),
+                           via_box.xMax(),
+                           via_box.yMax()),
+                      net);
+        }
+      } else {
+        Rect rect;
+        box->getBox(rect);
+        swires_.add(box->getTechLayer(), rect, net);
+      }
+    }
+  }
+}
+
+void dbSpatialIndex::Impl::addBPin(dbBPin* pin)
+{
+  if (!pin->getPlacementStatus().isPlaced()) {
+    return;
+  }
+  for (dbBox* box : pin->getBoxes()) {
+    Rect rect;
+    box->getBox(rect);
+    bpins_.add(box->getTechLayer(), rect, pin);
+  }
+}
+
+void dbSpatialIndex::Impl::addObstruction(dbObstruction* obs)
+{
+  dbBox* box = obs->getBBox();
+  Rect rect;
+  box->getBox(rect);
+  obstructions_.add(box->getTechLayer(), rect, obs);
+}
+
+void dbSpatialIndex::Impl::wireChanged(dbNet* net)
+{
+  if (wires_built_ && net != nullptr) {
+    dirty_wires_.insert(net);
+  }
+}
+
+void dbSpatialIndex::Impl::swireChanged(dbNet* net)
+{
+  if (swires_built_ && net != nullptr) {
+    dirty_swires_.insert(net);
+  }
+}
+
+void dbSpatialIndex::Impl::syncInsts()
+{
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (insts_built_) {
+      return;
+    }
+  }
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (insts_built_) {
+    return;
+  }
+  for (dbInst* inst : block_->getInsts()) {
+    addInst(inst);
+  }
+  insts_built_ = true;
+}
+
+void dbSpatialIndex::Impl::syncWires()
+{
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (wires_built_ && dirty_wires_.empty()) {
+      return;
+    }
+  }
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (!wires_built_) {
+    for (dbNet* net : block_->getNets()) {
+      addWire(net);
+    }
+    wires_built_ = true;
+  } else {
+    for (dbNet* net : dirty_wires_) {
+      wires_.remove(net);
+      addWire(net);
+    }
+  }
+  dirty_wires_.clear();
+}
+
+void dbSpatialIndex::Impl::syncSWires()
+{
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (swires_built_ && dirty_swires_.empty()) {
+      return;
+    }
+  }
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (!swires_built_) {
+    for (dbNet* net : block_->getNets()) {
+      addSWire(net);
+    }
+    swires_built_ = true;
+  } else {
+    for (dbNet* net : dirty_swires_) {
+      swires_.remove(net);
+      addSWire(net);
+    }
+  }
+  dirty_swires_.clear();
+}
+
+void dbSpatialIndex::Impl::syncObstructions()
+{
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (obstructions_built_) {
+      return;
+    }
+  }
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (obstructions_built_) {
+    return;
+  }
+  for (dbObstruction* obs : block_->getObstructions()) {
+    addObstruction(obs);
+  }
+  obstructions_built_ = true;
+}
+
+void dbSpatialIndex::Impl::syncBPins()
+{
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (bpins_built_ && dirty_bpins_.empty()) {
+      return;
+    }
+  }
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (!bpins_built_) {
+    for (dbBTerm* bterm : block_->getBTerms()) {
+      for (dbBPin* pin : bterm->getBPins()) {
+        addBPin(pin);
+      }
+    }
+    bpins_built_ = true;
+  } else {
+    for (dbBPin* pin : dirty_bpins_) {
+      bpins_.remove(pin);
+      addBPin(pin);
+    }
+  }
+  dirty_bpins_.clear();
+}
+
+void dbSpatialIndex::Impl::clear()
+{
+  insts_.clear();
+  inst_boxes_.clear();
+  insts_built_ = false;
+  wires_.clear();
+  dirty_wires_.clear();
+  wires_built_ = false;
+  swires_.clear();
+  dirty_swires_.clear();
+  swires_built_ = false;
+  obstructions_.clear();
+  obstructions_built_ = false;
+  bpins_.clear();
+  dirty_bpins_.clear();
+  bpins_built_ = false;
+}
+
+////////////////////////////////////////////////////////////////////
+
+dbSpatialIndex::dbSpatialIndex(dbBlock* block)
+    : impl_(std::make_unique<Impl>(block))
+{
+  addOwner(block);
+}
+
+dbSpatialIndex::~dbSpatialIndex() = default;
+
+std::vector<dbInst*> dbSpatialIndex::findInsts(const Rect& area)
+{
+  impl_->syncInsts();
+  std::shared_lock<std::shared_mutex> lock(impl_->mutex_);
+  std::vector<dbInst*> result;
+  for (auto itr = impl_->insts_.qbegin(bgi::intersects(toBox(area)));
+       itr != impl_->insts_.qend();
+       ++itr) {
+    result.push_back(itr->second);
+  }
+  return result;
+}
+
+dbSpatialIndex::Shapes<dbNet*> dbSpatialIndex::findWires(dbTechLayer* layer,
+                                                         const Rect& area)
+{
+  impl_->syncWires();
+  std::shared_lock<std::shared_mutex> lock(impl_->mutex_);
+  return impl_->wires_.query(layer, area);
+}
+
+dbSpatialIndex::Shapes<dbNet*> dbSpatialIndex::findSWires(dbTechLayer* layer,
+                                                          const Rect& area)
+{
+  impl_->syncSWires();
+  std::shared_lock<std::shared_mutex> lock(impl_->mutex_);
+  return impl_->swires_.query(layer, area);
+}
+
+dbSpatialIndex::Shapes<dbObstruction*> dbSpatialIndex::findObstructions(
+    dbTechLayer* layer,
+    const Rect& area)
+{
+  impl_->syncObstructions();
+  std::shared_lock<std::shared_mutex> lock(impl_->mutex_);
+  return impl_->obstructions_.query(layer, area);
+}
+
+dbSpatialIndex::Shapes<dbBPin*> dbSpatialIndex::findBPins(dbTechLayer* layer,
+                                                          const Rect& area)
+{
+  impl_->syncBPins();
+  std::shared_lock<std::shared_mutex> lock(impl_->mutex_);
+  return impl_->bpins_.query(layer, area);
+}
+
+void dbSpatialIndex::invalidate()
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  impl_->clear();
+}
+
+void dbSpatialIndex::inDbInstCreate(dbInst* inst)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  if (impl_->insts_built_) {
+    impl_->addInst(inst);
+  }
+}
+
+void dbSpatialIndex::inDbInstCreate(dbInst* inst, dbRegion* /* region */)
+{
+  inDbInstCreate(inst);
+}
+
+void dbSpatialIndex::inDbInstDestroy(dbInst* inst)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  impl_->removeInst(inst);
+}
+
+void dbSpatialIndex::inDbInstPlacementStatusBefore(
+    dbInst* inst,
+    const dbPlacementStatus& status)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  if (!impl_->insts_built_) {
+    return;
+  }
+  impl_->removeInst(inst);
+  if (status.isPlaced()) {
+    Rect rect;
+    inst->getBBox()->getBox(rect);
+    BBox box = toBox(rect);
+    impl_->insts_.insert(Impl::InstValue(box, inst));
+    impl_->inst_boxes_[inst] = box;
+  }
+}
+
+void dbSpatialIndex::inDbInstSwapMasterBefore(dbInst* inst,
+                                              dbMaster* /* master */)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  impl_->removeInst(inst);
+}
+
+void dbSpatialIndex::inDbInstSwapMasterAfter(dbInst* inst)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  if (impl_->insts_built_) {
+    impl_->addInst(inst);
+  }
+}
+
+void dbSpatialIndex::inDbPreMoveInst(dbInst* inst)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  impl_->removeInst(inst);
+}
+
+void dbSpatialIndex::inDbPostMoveInst(dbInst* inst)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  if (impl_->insts_built_) {
+    impl_->addInst(inst);
+  }
+}
+
+void dbSpatialIndex::inDbNetDestroy(dbNet* net)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  impl_->wires_.remove(net);
+  impl_->dirty_wires_.erase(net);
+  impl_->swires_.remove(net);
+  impl_->dirty_swires_.erase(net);
+}
+
+void dbSpatialIndex::inDbBPinCreate(dbBPin* pin)
+{
+  // The pin boxes are added after creation.
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  if (impl_->bpins_built_) {
+    impl_->dirty_bpins_.insert(pin);
+  }
+}
+
+void dbSpatialIndex::inDbBPinDestroy(dbBPin* pin)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  impl_->bpins_.remove(pin);
+  impl_->dirty_bpins_.erase(pin);
+}
+
+void dbSpatialIndex::inDbBPinPlacementStatusBefore(
+    dbBPin* pin,
+    const dbPlacementStatus& /* status */)
+{
+  // The pin is re-indexed with its new status on the next query.
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  if (impl_->bpins_built_) {
+    impl_->dirty_bpins_.insert(pin);
+  }
+}
+
+void dbSpatialIndex::inDbObstructionCreate(dbObstruction* obs)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  if (impl_->obstructions_built_) {
+    impl_->addObstruction(obs);
+  }
+}
+
+void dbSpatialIndex::inDbObstructionDestroy(dbObstruction* obs)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  impl_->obstructions_.remove(obs);
+}
+
+void dbSpatialIndex::inDbWireCreate(dbWire* wire)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  impl_->wireChanged(wire->getNet());
+}
+
+void dbSpatialIndex::inDbWireDestroy(dbWire* wire)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  impl_->wireChanged(wire->getNet());
+}
+
+void dbSpatialIndex::inDbWirePostAttach(dbWire* wire)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  impl_->wireChanged(wire->getNet());
+}
+
+void dbSpatialIndex::inDbWirePostDetach(dbWire* /* wire */, dbNet* net)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  impl_->wireChanged(net);
+}
+
+void dbSpatialIndex::inDbWirePostAppend(dbWire* /* src */, dbWire* dst)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  impl_->wireChanged(dst->getNet());
+}
+
+void dbSpatialIndex::inDbWirePostCopy(dbWire* /* src */, dbWire* dst)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  impl_->wireChanged(dst->getNet());
+}
+
+void dbSpatialIndex::inDbSWireCreate(dbSWire* wire)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  impl_->swireChanged(wire->getNet());
+}
+
+void dbSpatialIndex::inDbSWireDestroy(dbSWire* wire)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  impl_->swireChanged(wire->getNet());
+}
+
+void dbSpatialIndex::inDbSWirePostDestroySBoxes(dbSWire* wire)
+{
+  std::unique_lock<std::shared_mutex> lock(impl_->mutex_);
+  impl_->swireChanged(wire->getNet());
+}
+
+}  // namespace odb
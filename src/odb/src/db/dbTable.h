@@ -100,6 +100,11 @@ class dbTable : public dbObjectTable, public dbIterator
   // Destroy instance of "T", calls destructor
   void destroy(T*);
 
+  // Make id, which must be free, the next id create() hands out. This
+  // lets a destroyed object be re-created with its old id. Returns false
+  // if id is in use or was never allocated.
+  bool reuseId(uint id);
+
   // clear the table
   void clear();
 
@@ -432,6 +432,20 @@ void dbTable<T>::destroy(T* t)
     findTop();
 }
 
+template <class T>
+bool dbTable<T>::reuseId(uint id)
+{
+  uint page = id >> _page_shift;
+
+  if ((id == 0) || (page >= _page_cnt) || validId(id))
+    return false;
+
+  _dbFreeObject* o = (_dbFreeObject*) getFreeObj(id);
+  unlinkQ(_free_list, o);
+  pushQ(_free_list, o);
+  return true;
+}
+
 template <class T>
 bool dbTable<T>::reversible()
 {
@@ -37,6 +37,7 @@
 #include "db.h"
 #include "dbBlock.h"
 #include "dbBlockCallBackObj.h"
+#include "dbJournal.h"
 #include "dbNet.h"
 #include "dbRtTree.h"
 #include "dbShape.h"
@@ -1821,6 +1822,21 @@ dbWire* dbWire::create(dbNet* net_, bool global_wire)
   }
 
   _dbBlock* block = (_dbBlock*) net->getOwner();
+
+  if (block->_journal) {
+    debugPrint(block->getImpl()->getLogger(),
+               utl::ODB,
+               "DB_ECO",
+               1,
+               "ECO: create wire, net {}",
+               net->getId());
+    block->_journal->beginAction(dbJournal::CREATE_OBJECT);
+    block->_journal->pushParam(dbWireObj);
+    block->_journal->pushParam(net->getId());
+    block->_journal->pushParam(global_wire);
+    block->_journal->endAction();
+  }
+
   _dbWire* wire = block->_wire_tbl->create();
   wire->_net = net->getOID();
 
@@ -1859,6 +1875,22 @@ void dbWire::destroy(dbWire* wire_)
   _dbNet* net = (_dbNet*) wire_->getNet();
   for (auto callback : block->_callbacks)
     callback->inDbWireDestroy(wire_);
+
+  if (block->_journal && net) {
+    debugPrint(block->getImpl()->getLogger(),
+               utl::ODB,
+               "DB_ECO",
+               1,
+               "ECO: destroy wire, net {}",
+               net->getId());
+    block->_journal->beginAction(dbJournal::DELETE_OBJECT);
+    block->_journal->pushParam(dbWireObj);
+    block->_journal->pushParam(net->getId());
+    block->_journal->pushParam((bool) wire->_flags._is_global);
+    block->_journal->pushWire(wire_);
+    block->_journal->endAction();
+  }
+
   Rect bbox;
 
   if (wire_->getBBox(bbox))
@@ -53,6 +53,11 @@ struct _dbWireFlags
 class _dbWire : public _dbObject
 {
  public:
+  enum Field  // dbJournal field name
+  {
+    DATA
+  };
+
   _dbWireFlags _flags;
   dbVector<int> _data;
   dbVector<unsigned char> _opcodes;
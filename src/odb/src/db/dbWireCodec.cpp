@@ -37,6 +37,7 @@
 #include "db.h"
 #include "dbBlock.h"
 #include "dbDatabase.h"
+#include "dbJournal.h"
 #include "dbNet.h"
 #include "dbTable.h"
 #include "dbTech.h"
@@ -586,6 +587,26 @@ void dbWireEncoder::end()
 
   uint n = _opcodes.size();
 
+  // The old and new encodings are only journaled while a transaction is
+  // open, where they are needed to roll the wire back; copying them on every
+  // encode during an eco is too costly for routers.
+  _dbBlock* block = (_dbBlock*) _block;
+  const bool journal
+      = block->_journal && block->_journal->transactionDepth() > 0;
+  if (journal) {
+    debugPrint(block->getImpl()->getLogger(),
+               utl::ODB,
+               "DB_ECO",
+               1,
+               "ECO: encode wire {}",
+               _wire->getOID());
+    block->_journal->beginAction(dbJournal::UPDATE_FIELD);
+    block->_journal->pushParam(dbWireObj);
+    block->_journal->pushParam(_wire->getOID());
+    block->_journal->pushParam(_dbWire::DATA);
+    block->_journal->pushWire((dbWire*) _wire);
+  }
+
   // Free the old memory
   _wire->_data.~dbVector<int>();
   new (&_wire->_data) dbVector<int>();
@@ -598,6 +619,11 @@ void dbWireEncoder::end()
   _wire->_opcodes.reserve(n);
   _wire->_opcodes = _opcodes;
 
+  if (journal) {
+    block->_journal->pushWire((dbWire*) _wire);
+    block->_journal->endAction();
+  }
+
   // Should we calculate the bbox???
   ((_dbBlock*) _block)->_flags._valid_bbox = 0;
   _point_cnt = 0;
@@ -1151,20 +1151,26 @@ void lefout::writePropertyDefinitions(dbLib* lib)
 
 bool lefout::writeTech(dbTech* tech, const char* lef_file)
 {
-  _out = fopen(lef_file, "w");
+  FILE* out = fopen(lef_file, "w");
 
-  if (_out == NULL) {
+  if (out == NULL) {
     logger_->error(utl::ODB, 1015, "Cannot open LEF file %s\n", lef_file);
     return false;
   }
 
+  writeTech(tech, out);
+  fclose(out);
+  return true;
+}
+
+void lefout::writeTech(dbTech* tech, FILE* out)
+{
+  _out = out;
   _dist_factor = 1.0 / (double) tech->getDbUnitsPerMicron();
   _area_factor = _dist_factor * _dist_factor;
   writeTech(tech);
 
   fprintf(_out, "END LIBRARY\n");
-  fclose(_out);
-  return true;
 }
 
 bool lefout::writeLib(dbLib* lib, const char* lef_file)
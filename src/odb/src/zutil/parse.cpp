@@ -32,9 +32,15 @@
 
 #include "parse.h"
 
+#include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
 
 #include "dbLogger.h"
 #include "misc_global.h"
@@ -67,6 +73,13 @@ void Ath__parser::init()
 
   _dbg = -1;
   _progressLineChunk = 1000000;
+
+  _map = NULL;
+  _mapSize = 0;
+  _mapPos = 0;
+  _chunkIdx = 0;
+  _chunkLineIdx = 0;
+  _parallelTasks = 1;
 }
 Ath__parser::Ath__parser()
 {
@@ -102,15 +115,23 @@ bool Ath__parser::isDigit(int ii, int jj)
 
 void Ath__parser::resetSeparator(const char* s)
 {
+  dropMappedWords();
   strcpy(_wordSeparators, s);
 }
 void Ath__parser::addSeparator(const char* s)
 {
+  dropMappedWords();
   strcat(_wordSeparators, s);
 }
 
 void Ath__parser::openFile(char* name)
 {
+  if (name == NULL && _map != NULL) {  // rewind the mapped file
+    dropMappedWords();
+    _mapPos = 0;
+    return;
+  }
+  unmapFile();
   if (name != NULL && strlen(name) > 4
       && !strcmp(name + strlen(name) - 3, ".gz")) {
     char cmd[256];
@@ -140,8 +161,176 @@ void Ath__parser::openFile(char* name)
   }
   //	_dbgFP= ATH__openFile("parse.dbg", (char*) "w");
 }
+bool Ath__parser::mapFile(char* name)
+{
+  unmapFile();
+  int len = strlen(name);
+  if (len > 3 && !strcmp(name + len - 3, ".gz")) {
+    openFile(name);
+    return false;
+  }
+  int fd = open(name, O_RDONLY);
+  if (fd >= 0) {
+    struct stat st;
+    void* map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+      map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map != MAP_FAILED) {
+      madvise(map, st.st_size, MADV_SEQUENTIAL);
+      _map = (char*) map;
+      _mapSize = st.st_size;
+      _mapPos = 0;
+      strcpy(_inputFile, name);
+      return true;
+    }
+  }
+  // Empty or unmappable files; openFile reports files that cannot be opened.
+  openFile(name);
+  return false;
+}
+void Ath__parser::unmapFile()
+{
+  dropMappedWords();
+  if (_map != NULL)
+    munmap(_map, _mapSize);
+  _map = NULL;
+  _mapSize = 0;
+  _mapPos = 0;
+}
+void Ath__parser::setParallelFor(int tasks, const ParallelFor& parallel_for)
+{
+  dropMappedWords();
+  _parallelTasks = parallel_for ? tasks : 1;
+  _parallelFor = parallel_for;
+}
+void Ath__parser::dropMappedWords()
+{
+  // _mapPos is still the end of the last line read, so the dropped lines
+  // are read again.
+  _chunks.clear();
+  _chunkIdx = 0;
+  _chunkLineIdx = 0;
+}
+// End of the line starting at pos, split the same way fgets splits it.
+size_t Ath__parser::mappedLineEnd(size_t pos) const
+{
+  size_t limit = std::min(_mapSize, pos + _lineSize - 1);
+  const char* nl = (const char*) memchr(_map + pos, '\n', limit - pos);
+  return nl != NULL ? nl - _map + 1 : limit;
+}
+bool Ath__parser::getLine()
+{
+  if (_map == NULL)
+    return fgets(_line, _lineSize, _inFP) != NULL;
+
+  dropMappedWords();
+  if (_mapPos >= _mapSize)
+    return false;
+  size_t end = mappedLineEnd(_mapPos);
+  memcpy(_line, _map + _mapPos, end - _mapPos);
+  _line[end - _mapPos] = '\0';
+  _mapPos = end;
+  return true;
+}
+// Split the words of [start, end) the same way mkWords does.
+void Ath__parser::splitMappedChunk(size_t start,
+                                   size_t end,
+                                   const bool* isSep,
+                                   MappedChunk& chunk) const
+{
+  size_t pos = start;
+  while (pos < end) {
+    size_t lineEnd = mappedLineEnd(pos);
+    MappedLine line{lineEnd, (int) chunk.words.size(), 0};
+    // mkWords stops at the line terminator
+    const char* nul = (const char*) memchr(_map + pos, '\0', lineEnd - pos);
+    size_t len = nul != NULL ? nul - _map : lineEnd;
+    size_t k = _map[pos] == _commentChar ? len : pos;
+    while (k < len) {
+      for (; k < len && isSep[(unsigned char) _map[k]]; k++)
+        ;
+      if (k == len)
+        break;
+      size_t wordStart = k;
+      for (; k < len && !isSep[(unsigned char) _map[k]]; k++) {
+        if (_map[k] == _commentChar)
+          break;
+      }
+      if (k < len && _map[k] == _commentChar)
+        break;
+      chunk.words.push_back({wordStart, (int) (k - wordStart)});
+      line.wordCnt++;
+    }
+    chunk.lines.push_back(line);
+    pos = lineEnd;
+  }
+}
+void Ath__parser::splitMappedWords()
+{
+  // Each task splits about this many bytes of whole lines.
+  const size_t chunkSize = 4 << 20;
+
+  bool isSep[256] = {false};
+  for (const char* c = _wordSeparators; *c; c++)
+    isSep[(unsigned char) *c] = true;
+
+  std::vector<size_t> bounds(_parallelTasks + 1, _mapPos);
+  for (int i = 1; i <= _parallelTasks; i++) {
+    size_t pos = std::max(bounds[i - 1], _mapPos + i * chunkSize);
+    if (pos >= _mapSize) {
+      pos = _mapSize;
+    } else {
+      // a chunk ends after a newline so the next one starts a line
+      const char* nl = (const char*) memchr(_map + pos, '\n', _mapSize - pos);
+      pos = nl != NULL ? nl - _map + 1 : _mapSize;
+    }
+    bounds[i] = pos;
+  }
+
+  _chunks.clear();
+  _chunks.resize(_parallelTasks);
+  _parallelFor(0, _parallelTasks, [&](int i) {
+    splitMappedChunk(bounds[i], bounds[i + 1], isSep, _chunks[i]);
+  });
+  _chunkIdx = 0;
+  _chunkLineIdx = 0;
+}
+// Read the next line of the mapped file from the split chunks and append its
+// words to the word array at jj.
+bool Ath__parser::readMappedWords(int jj)
+{
+  while (_chunkIdx == (int) _chunks.size()
+         || _chunkLineIdx == (int) _chunks[_chunkIdx].lines.size()) {
+    if (_chunkIdx < (int) _chunks.size()) {
+      _chunkIdx++;
+      _chunkLineIdx = 0;
+    } else if (_mapPos < _mapSize) {
+      splitMappedWords();
+    } else {
+      return false;
+    }
+  }
+  const MappedChunk& chunk = _chunks[_chunkIdx];
+  const MappedLine& line = chunk.lines[_chunkLineIdx++];
+
+  memcpy(_line, _map + _mapPos, line.end - _mapPos);
+  _line[line.end - _mapPos] = '\0';
+  _mapPos = line.end;
+
+  for (int ii = 0; ii < line.wordCnt && jj < _maxWordCnt; ii++) {
+    const MappedWord& word = chunk.words[line.firstWord + ii];
+    int len = std::min(word.len, _wordSize - 1);
+    memcpy(_wordArray[jj], _map + word.start, len);
+    _wordArray[jj][len] = '\0';
+    jj++;
+  }
+  _currentWordCnt = jj;
+  return true;
+}
 void Ath__parser::setInputFP(FILE* fp)
 {
+  unmapFile();
   _inFP = fp;
 }
 FILE* Ath__parser::getDbgFP()
@@ -165,6 +354,7 @@ Ath__parser::~Ath__parser()
     pclose(_inFP);
     _inFP = NULL;
   }
+  unmapFile();
   ATH__deallocCharWord(_inputFile);
   ATH__deallocCharWord(_line);
   ATH__deallocCharWord(_tmpLine);
@@ -498,7 +688,9 @@ int Ath__parser::reportLines(FILE* fp)
 }
 int Ath__parser::readLineAndBreak(int prevWordCnt)
 {
-  if (fgets(_line, _lineSize, _inFP) == NULL) {
+  int jj = prevWordCnt < 0 ? 0 : prevWordCnt;
+  bool split = _map != NULL && _parallelTasks > 1;
+  if (split ? !readMappedWords(jj) : !getLine()) {
     _currentWordCnt = prevWordCnt;
     return prevWordCnt;
   }
@@ -509,10 +701,8 @@ int Ath__parser::readLineAndBreak(int prevWordCnt)
   if (_dbg > 0)
     fprintf(stdout, "%s", _line);
 
-  if (prevWordCnt < 0)
-    _currentWordCnt = mkWords(0);
-  else
-    _currentWordCnt = mkWords(prevWordCnt);
+  if (!split)
+    _currentWordCnt = mkWords(jj);
 
   return _currentWordCnt;
 }
@@ -520,7 +710,7 @@ int Ath__parser::readMultipleLineAndBreak(char continuationChar)
 {
   strcpy(_tmpLine, "");
 
-  if (fgets(_line, _lineSize, _inFP) == NULL) {
+  if (!getLine()) {
     _currentWordCnt = 0;
     return -1;
   }
@@ -548,7 +738,7 @@ int Ath__parser::readMultipleLineAndBreak(char continuationChar)
     }
     reportProgress(stdout);
 
-  } while (fgets(_line, _lineSize, _inFP) != NULL);
+  } while (getLine());
 
   if (_dbg > 0)
     fprintf(stdout, "%s", _line);
@@ -762,7 +952,7 @@ int Ath__parser::createWords()
 int Ath__parser::readLine(const char* headSubWord)
 {
   _currentWordCnt = 0;
-  if (fgets(_line, _lineSize, _inFP) == NULL) {
+  if (!getLine()) {
     return -1;
   }
   if (_dbg > 0)
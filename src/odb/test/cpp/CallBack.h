@@ -153,6 +153,13 @@ class CallBack : public dbBlockCallBackObj
     if (!_pause)
       events.push_back("Destroy BPin");
   }
+  void inDbBPinPlacementStatusBefore(dbBPin* pin,
+                                     const dbPlacementStatus& status) override
+  {
+    if (!_pause)
+      events.push_back("Change BPin status of " + pin->getBTerm()->getName()
+                       + " to " + status.getString());
+  }
   // dbBPin End
 
   // dbBlockage Start
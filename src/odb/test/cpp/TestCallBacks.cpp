@@ -131,6 +131,10 @@ BOOST_AUTO_TEST_CASE(test_bpin)
   BOOST_TEST(cb->events.size() == 1);
   BOOST_TEST(cb->events[0] == "Create BPin for IN1");
   cb->clearEvents();
+  pin->setPlacementStatus(dbPlacementStatus::FIRM);
+  BOOST_TEST(cb->events.size() == 1);
+  BOOST_TEST(cb->events[0] == "Change BPin status of IN1 to FIRM");
+  cb->clearEvents();
   dbBPin::destroy(pin);
   BOOST_TEST(cb->events.size() == 1);
   BOOST_TEST(cb->events[0] == "Destroy BPin");
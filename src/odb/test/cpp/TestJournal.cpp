@@ -2,6 +2,7 @@
 #include <boost/test/included/unit_test.hpp>
 #include <iostream>
 #include "db.h"
+#include "dbWireCodec.h"
 #include "helper.cpp"
 #include <string>
 
@@ -73,4 +74,169 @@ BOOST_FIXTURE_TEST_CASE(test_read, F_DEFAULT)
   // test journal redo DISCONNECT_OBJECT
   BOOST_TEST(b2->getNet() == nullptr);
 }
+BOOST_FIXTURE_TEST_CASE(test_rollback, F_DEFAULT)
+{
+  auto i1 = odb::dbInst::create(block, lib->findMaster("and2"), "i1");
+  auto i2 = odb::dbInst::create(block, lib->findMaster("and2"), "i2");
+  auto n1 = odb::dbNet::create(block, "n1");
+  auto n2 = odb::dbNet::create(block, "n2");
+  odb::dbBTerm::create(n1, "b1");
+  i1->findITerm("o")->connect(n1);
+  i2->findITerm("a")->connect(n1);
+  i2->findITerm("b")->connect(n2);
+  i1->setLocation(1000, 2000);
+  i1->setPlacementStatus(odb::dbPlacementStatus::PLACED);
+
+  db->beginTransaction(block);
+  BOOST_TEST(db->transactionDepth(block) == 1);
+  auto i3 = odb::dbInst::create(block, lib->findMaster("or2"), "i3");
+  auto n3 = odb::dbNet::create(block, "n3");
+  i3->findITerm("a")->connect(n3);
+  i1->findITerm("o")->connect(n3);
+  i1->setLocation(5000, 6000);
+  i1->setOrient(odb::dbOrientType::MX);
+  i1->swapMaster(lib->findMaster("or2"));
+  odb::dbInst::destroy(i2);
+  odb::dbNet::destroy(n2);
+  odb::dbBTerm::destroy(block->findBTerm("b1"));
+  db->rollbackTransaction(block);
+
+  BOOST_TEST(db->transactionDepth(block) == 0);
+  // test undo CREATE_OBJECT
+  BOOST_TEST(block->findInst("i3") == nullptr);
+  BOOST_TEST(block->findNet("n3") == nullptr);
+  // test undo DELETE_OBJECT
+  i2 = block->findInst("i2");
+  n2 = block->findNet("n2");
+  auto b1 = block->findBTerm("b1");
+  BOOST_TEST(i2 != nullptr);
+  BOOST_TEST(n2 != nullptr);
+  BOOST_TEST(b1 != nullptr);
+  BOOST_TEST(b1->getNet() == n1);
+  // test undo CONNECT_OBJECT / DISCONNECT_OBJECT
+  BOOST_TEST(i1->findITerm("o")->getNet() == n1);
+  BOOST_TEST(i2->findITerm("a")->getNet() == n1);
+  BOOST_TEST(i2->findITerm("b")->getNet() == n2);
+  BOOST_TEST(n1->getITermCount() == 2);
+  // test undo SWAP_OBJECT
+  BOOST_TEST(i1->getMaster()->getName() == "and2");
+  // test undo UPDATE_FIELD
+  int x, y;
+  i1->getLocation(x, y);
+  BOOST_TEST(x == 1000);
+  BOOST_TEST(y == 2000);
+  BOOST_TEST(i1->getOrient() == odb::dbOrientType::R0);
+  BOOST_TEST(i1->getPlacementStatus() == odb::dbPlacementStatus::PLACED);
+}
+BOOST_FIXTURE_TEST_CASE(test_rollback_ids, F_DEFAULT)
+{
+  auto iterm_ids = [](dbInst* inst) {
+    std::vector<uint> ids;
+    for (dbITerm* iterm : inst->getITerms())
+      ids.push_back(iterm->getId());
+    return ids;
+  };
+  odb::dbInst::create(block, lib->findMaster("and2"), "i1");
+  auto i2 = odb::dbInst::create(block, lib->findMaster("and2"), "i2");
+  auto n1 = odb::dbNet::create(block, "n1");
+  auto b1 = odb::dbBTerm::create(n1, "b1");
+  i2->findITerm("a")->connect(n1);
+  const uint i2_id = i2->getId();
+  const std::vector<uint> i2_iterm_ids = iterm_ids(i2);
+  const uint n1_id = n1->getId();
+  const uint b1_id = b1->getId();
+
+  // dbInst::destroy frees the iterms in mterm order, so re-creating the
+  // instance from the free list alone would reverse its iterm ids. A new
+  // net takes the freed net id in between.
+  db->beginTransaction(block);
+  odb::dbInst::destroy(i2);
+  odb::dbBTerm::destroy(b1);
+  odb::dbNet::destroy(n1);
+  auto n2 = odb::dbNet::create(block, "n2");
+  odb::dbBTerm::create(n2, "b2");
+  db->rollbackTransaction(block);
+
+  i2 = block->findInst("i2");
+  n1 = block->findNet("n1");
+  BOOST_TEST(i2->getId() == i2_id);
+  BOOST_TEST(iterm_ids(i2) == i2_iterm_ids);
+  BOOST_TEST(n1->getId() == n1_id);
+  BOOST_TEST(block->findBTerm("b1")->getId() == b1_id);
+  BOOST_TEST(i2->findITerm("a")->getNet() == n1);
+}
+BOOST_FIXTURE_TEST_CASE(test_nested_transactions, F_DEFAULT)
+{
+  auto i1 = odb::dbInst::create(block, lib->findMaster("and2"), "i1");
+  i1->setOrigin(0, 0);
+
+  db->beginTransaction(block);
+  i1->setOrigin(100, 100);
+  db->beginTransaction(block);
+  i1->setOrigin(200, 200);
+  db->rollbackTransaction(block);
+  int x, y;
+  i1->getOrigin(x, y);
+  BOOST_TEST(x == 100);
+
+  db->beginTransaction(block);
+  odb::dbInst::create(block, lib->findMaster("or2"), "i2");
+  db->commitTransaction(block);
+  BOOST_TEST(block->findInst("i2") != nullptr);
+  BOOST_TEST(db->transactionDepth(block) == 1);
+
+  // the committed inner transaction is reverted with the outer one
+  db->rollbackTransaction(block);
+  BOOST_TEST(block->findInst("i2") == nullptr);
+  i1->getOrigin(x, y);
+  BOOST_TEST(x == 0);
+  BOOST_TEST(db->transactionDepth(block) == 0);
+
+  db->beginTransaction(block);
+  i1->setOrigin(300, 300);
+  db->commitTransaction(block);
+  i1->getOrigin(x, y);
+  BOOST_TEST(x == 300);
+}
+BOOST_FIXTURE_TEST_CASE(test_read_unversioned, F_DEFAULT)
+{
+  // A log written before the format version was recorded: the debug flag
+  // of the log followed by its empty data.
+  std::string old_path = journal_path + ".old";
+  FILE* file = fopen(old_path.c_str(), "w");
+  const unsigned int old_log[2] = {0, 0};
+  fwrite(old_log, sizeof(old_log), 1, file);
+  fclose(file);
+  db->beginEco(block);
+  BOOST_CHECK_THROW(db->readEco(block, old_path.c_str()), std::exception);
+  db->endEco(block);
+}
+BOOST_FIXTURE_TEST_CASE(test_wire_encode, F_DEFAULT)
+{
+  auto layer = odb::dbTechLayer::create(
+      db->getTech(), "M1", dbTechLayerType::ROUTING);
+  auto n1 = odb::dbNet::create(block, "n1");
+  auto wire = odb::dbWire::create(n1);
+  auto encode = [&](int length) {
+    odb::dbWireEncoder encoder;
+    encoder.begin(wire);
+    encoder.newPath(layer, odb::dbWireType::ROUTED);
+    encoder.addPoint(0, 0);
+    encoder.addPoint(length, 0);
+    encoder.end();
+  };
+  encode(1000);
+
+  // encoding outside of a transaction is not journaled
+  db->beginEco(block);
+  encode(2000);
+  BOOST_TEST(db->checkEco(block) == 0);
+  db->endEco(block);
+
+  // inside one it is, so that it can be rolled back
+  db->beginTransaction(block);
+  encode(3000);
+  db->rollbackTransaction(block);
+  BOOST_TEST(wire->getLength() == 2000);
+}
 BOOST_AUTO_TEST_SUITE_END()
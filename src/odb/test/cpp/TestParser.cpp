@@ -0,0 +1,122 @@
+#define BOOST_TEST_MODULE TestParser
+#include <boost/test/included/unit_test.hpp>
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "parse.h"
+
+using namespace std;
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+using Lines = vector<vector<string>>;
+
+static string writeSpef(const string& name, int netCnt)
+{
+  string path = string(std::getenv("BASE_DIR")) + "/results/" + name;
+  FILE* fp = fopen(path.c_str(), "w");
+  fprintf(fp, "*SPEF \"IEEE 1481-1998\"\n*DESIGN \"test\"\n\n");
+  fprintf(fp, "# comment line\n*NAME_MAP\n");
+  for (int i = 1; i <= netCnt; i++)
+    fprintf(fp, "*%d n%d\n", i, i);
+  for (int i = 1; i <= netCnt; i++) {
+    fprintf(fp, "\n*D_NET *%d %d.5\n*CONN\n", i, i % 7);
+    fprintf(fp, "*I *%d:A I *C 1.0 2.0 *L 0.1\n", i);
+    fprintf(fp, "*CAP\n1 *%d:1 0.5 # trailing comment\n", i);
+    fprintf(fp, "2 *%d:1\t*%d:2  0.25\n", i, i + 1);
+    fprintf(fp, "*RES\n1 *%d:1 *%d:2 12.5\n*END\n", i, i);
+    if (i % 1000 == 0) {
+      // longer than the parser line size
+      fprintf(fp, "*L");
+      for (int j = 0; j < 40; j++)
+        fprintf(fp, " word%d", j);
+      fprintf(fp, "\n");
+    }
+  }
+  fprintf(fp, "*D_NET *0 0 no trailing newline");
+  fclose(fp);
+  return path;
+}
+
+static vector<string> words(Ath__parser& parser)
+{
+  vector<string> line;
+  for (int ii = 0; ii < parser.getWordCnt(); ii++)
+    line.push_back(parser.get(ii));
+  return line;
+}
+
+// Every line, including blank and comment lines.
+static Lines readLines(Ath__parser& parser, int maxLines = -1)
+{
+  Lines lines;
+  while ((maxLines < 0 || (int) lines.size() < maxLines)
+         && parser.readLineAndBreak() >= 0)
+    lines.push_back(words(parser));
+  return lines;
+}
+
+static void threadedFor(int begin,
+                        int end,
+                        const std::function<void(int)>& body)
+{
+  vector<thread> threads;
+  for (int i = begin; i < end; i++)
+    threads.emplace_back(body, i);
+  for (thread& t : threads)
+    t.join();
+}
+
+BOOST_AUTO_TEST_CASE(test_mapped_lines)
+{
+  // large enough for several 4MB chunks
+  string path = writeSpef("parser_mapped.spef", 60000);
+
+  Ath__parser streamed(128, 100, 512);
+  streamed.openFile((char*) path.c_str());
+  Lines expected = readLines(streamed);
+  BOOST_TEST(expected.size() > 60000 * 10);
+
+  Ath__parser mapped(128, 100, 512);
+  BOOST_TEST(mapped.mapFile((char*) path.c_str()));
+  BOOST_TEST((readLines(mapped) == expected));
+  BOOST_TEST(mapped.getLineNum() == streamed.getLineNum());
+
+  Ath__parser split(128, 100, 512);
+  split.mapFile((char*) path.c_str());
+  split.setParallelFor(4, threadedFor);
+  BOOST_TEST((readLines(split) == expected));
+  BOOST_TEST(split.getLineNum() == streamed.getLineNum());
+}
+
+BOOST_AUTO_TEST_CASE(test_mapped_rewind)
+{
+  string path = writeSpef("parser_rewind.spef", 100);
+
+  Ath__parser streamed;
+  streamed.openFile((char*) path.c_str());
+  Lines expected = readLines(streamed);
+
+  Ath__parser split;
+  split.mapFile((char*) path.c_str());
+  split.setParallelFor(3, threadedFor);
+  Lines head = readLines(split, 20);
+  BOOST_TEST((head == Lines(expected.begin(), expected.begin() + 20)));
+
+  // new separators apply to the lines not read yet
+  split.resetSeparator(" \n\t:");
+  Ath__parser colons;
+  colons.openFile((char*) path.c_str());
+  readLines(colons, 20);
+  colons.resetSeparator(" \n\t:");
+  BOOST_TEST((readLines(split, 50) == readLines(colons, 50)));
+
+  // openFile() starts over
+  split.resetSeparator(" \n\t");
+  split.openFile();
+  BOOST_TEST((readLines(split) == expected));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,97 @@
+#define BOOST_TEST_MODULE TestSpatialIndex
+#include <boost/test/included/unit_test.hpp>
+
+#include "db.h"
+#include "dbSpatialIndex.h"
+#include "helper.cpp"
+using namespace odb;
+using namespace std;
+BOOST_AUTO_TEST_SUITE(test_suite)
+BOOST_AUTO_TEST_CASE(test_insts)
+{
+  dbDatabase* db    = createSimpleDB();
+  dbBlock*    block = db->getChip()->getBlock();
+  dbInst* i1 = dbInst::create(block, db->findMaster("and2"), "i1");
+  dbInst* i2 = dbInst::create(block, db->findMaster("and2"), "i2");
+  i1->setLocation(0, 0);
+  i1->setPlacementStatus(dbPlacementStatus::PLACED);
+  i2->setLocation(5000, 5000);
+  i2->setPlacementStatus(dbPlacementStatus::PLACED);
+
+  dbSpatialIndex* index = block->getSpatialIndex();
+  BOOST_TEST(index == block->getSpatialIndex());
+  auto found = index->findInsts(Rect(100, 100, 200, 200));
+  BOOST_TEST(found.size() == 1);
+  BOOST_TEST(found[0] == i1);
+  BOOST_TEST(index->findInsts(Rect(0, 0, 10000, 10000)).size() == 2);
+
+  // moves are tracked through the block callbacks
+  i1->setLocation(20000, 20000);
+  BOOST_TEST(index->findInsts(Rect(100, 100, 200, 200)).empty());
+  found = index->findInsts(Rect(20100, 20100, 20200, 20200));
+  BOOST_TEST(found.size() == 1);
+  BOOST_TEST(found[0] == i1);
+
+  // new placed instances are picked up
+  dbInst* i3 = dbInst::create(block, db->findMaster("or2"), "i3");
+  i3->setLocation(100, 100);
+  i3->setPlacementStatus(dbPlacementStatus::PLACED);
+  found = index->findInsts(Rect(200, 200, 300, 300));
+  BOOST_TEST(found.size() == 1);
+  BOOST_TEST(found[0] == i3);
+
+  // unplaced and destroyed instances drop out
+  i3->setPlacementStatus(dbPlacementStatus::NONE);
+  BOOST_TEST(index->findInsts(Rect(200, 200, 300, 300)).empty());
+  dbInst::destroy(i2);
+  BOOST_TEST(index->findInsts(Rect(0, 0, 10000, 10000)).empty());
+
+  dbDatabase::destroy(db);
+}
+BOOST_AUTO_TEST_CASE(test_obstructions)
+{
+  dbDatabase*  db    = createSimpleDB();
+  dbBlock*     block = db->getChip()->getBlock();
+  dbTechLayer* layer = db->getTech()->findLayer("L1");
+
+  dbSpatialIndex* index = block->getSpatialIndex();
+  BOOST_TEST(index->findObstructions(layer, Rect(0, 0, 100, 100)).empty());
+  dbObstruction* obs = dbObstruction::create(block, layer, 0, 0, 50, 50);
+  auto found = index->findObstructions(layer, Rect(10, 10, 20, 20));
+  BOOST_TEST(found.size() == 1);
+  BOOST_TEST(found[0].second == obs);
+  BOOST_TEST((found[0].first == Rect(0, 0, 50, 50)));
+  dbObstruction::destroy(obs);
+  BOOST_TEST(index->findObstructions(layer, Rect(10, 10, 20, 20)).empty());
+
+  dbDatabase::destroy(db);
+}
+BOOST_AUTO_TEST_CASE(test_bpins)
+{
+  dbDatabase*  db    = create2LevetDbWithBTerms();
+  dbBlock*     block = db->getChip()->getBlock();
+  dbTechLayer* layer = db->getTech()->findLayer("L1");
+  dbBPin*      pin   = dbBPin::create(block->findBTerm("IN1"));
+  dbBox::create(pin, layer, 0, 0, 100, 100);
+
+  // only placed pins are indexed
+  dbSpatialIndex* index = block->getSpatialIndex();
+  BOOST_TEST(index->findBPins(layer, Rect(10, 10, 20, 20)).empty());
+
+  // status changes are tracked through the block callbacks
+  pin->setPlacementStatus(dbPlacementStatus::PLACED);
+  auto found = index->findBPins(layer, Rect(10, 10, 20, 20));
+  BOOST_TEST(found.size() == 1);
+  BOOST_TEST(found[0].second == pin);
+  BOOST_TEST((found[0].first == Rect(0, 0, 100, 100)));
+  pin->setPlacementStatus(dbPlacementStatus::NONE);
+  BOOST_TEST(index->findBPins(layer, Rect(10, 10, 20, 20)).empty());
+  pin->setPlacementStatus(dbPlacementStatus::FIRM);
+  BOOST_TEST(index->findBPins(layer, Rect(10, 10, 20, 20)).size() == 1);
+
+  dbBPin::destroy(pin);
+  BOOST_TEST(index->findBPins(layer, Rect(10, 10, 20, 20)).empty());
+
+  dbDatabase::destroy(db);
+}
+BOOST_AUTO_TEST_SUITE_END()
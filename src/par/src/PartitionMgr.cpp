@@ -310,11 +310,9 @@ void PartitionMgr::runGpMetis()
   currentResults.setPartitionId(partitionId);
   const std::string evaluationFunction = options_.getEvaluationFunction();
 
-  idx_t edgeCut;
-  idx_t nPartitions = options_.getTargetPartitions();
-  int numVertices = graph_->getNumVertex();
+  const idx_t nPartitions = options_.getTargetPartitions();
+  const int numVertices = graph_->getNumVertex();
   const int numEdges = graph_->getNumEdges();
-  idx_t constraints = 1;
   idx_t options[METIS_NOPTIONS];
   METIS_SetDefaultOptions(options);
 
@@ -323,63 +321,59 @@ void PartitionMgr::runGpMetis()
   options[METIS_OPTION_NUMBERING] = 0;
   options[METIS_OPTION_UFACTOR] = options_.getBalanceConstraint() * 10;
 
-  idx_t* vertexWeights
-      = (idx_t*) malloc((unsigned) numVertices * sizeof(idx_t));
-  idx_t* rowPtr = (idx_t*) malloc((unsigned) (numVertices + 1) * sizeof(idx_t));
-  idx_t* colIdx = (idx_t*) malloc((unsigned) numEdges * sizeof(idx_t));
-  idx_t* edgeWeights = (idx_t*) malloc((unsigned) numEdges * sizeof(idx_t));
+  // The CSR arrays are built once and only read by METIS, so every seed
+  // reuses them.
+  std::vector<idx_t> vertexWeights(numVertices);
+  std::vector<idx_t> rowPtr(numVertices + 1);
+  std::vector<idx_t> colIdx(numEdges);
+  std::vector<idx_t> edgeWeights(numEdges);
   for (int i = 0; i < numVertices; i++) {
     vertexWeights[i] = graph_->getVertexWeight(i);
-    edgeWeights[i] = graph_->getEdgeWeight(i);
     rowPtr[i] = graph_->getRowPtr(i);
-    colIdx[i] = graph_->getColIdx(i);
   }
   rowPtr[numVertices] = numEdges;
-
-  for (int i = numVertices; i < numEdges; i++) {
+  for (int i = 0; i < numEdges; i++) {
     edgeWeights[i] = graph_->getEdgeWeight(i);
     colIdx[i] = graph_->getColIdx(i);
   }
+
+  // GKlib keeps its random number generator in process globals that
+  // METIS_PartGraph* reseeds, so the seeds run one at a time.
   for (int seed : options_.getSeeds()) {
     const auto start = std::chrono::system_clock::now();
     options[METIS_OPTION_SEED] = seed;
-    idx_t* parts = (idx_t*) malloc((unsigned) numVertices * sizeof(idx_t));
+    idx_t nvtxs = numVertices;
+    idx_t constraints = 1;
+    idx_t nparts = nPartitions;
+    idx_t edgeCut;
+    std::vector<idx_t> parts(numVertices);
 
-    METIS_PartGraphRecursive(&numVertices,
+    METIS_PartGraphRecursive(&nvtxs,
                              &constraints,
-                             rowPtr,
-                             colIdx,
-                             vertexWeights,
+                             rowPtr.data(),
+                             colIdx.data(),
+                             vertexWeights.data(),
                              NULL,
-                             edgeWeights,
-                             &nPartitions,
+                             edgeWeights.data(),
+                             &nparts,
                              NULL,
                              NULL,
                              options,
                              &edgeCut,
-                             parts);
+                             parts.data());
 
-    std::vector<unsigned long> gpmetisResults;
-    for (int i = 0; i < numVertices; i++)
-      gpmetisResults.push_back(parts[i]);
     const auto end = std::chrono::system_clock::now();
     const unsigned long runtime
         = std::chrono::duration_cast<std::chrono::milliseconds>(end - start)
               .count();
-
-    currentResults.addAssignment(gpmetisResults, runtime, seed);
-    free(parts);
-
+    currentResults.addAssignment(
+        std::vector<unsigned long>(parts.begin(), parts.end()), runtime, seed);
     logger_->info(PAR,
                   56,
                   "[GPMetis] Partitioned graph for seed {} in {} ms.",
                   seed,
                   runtime);
   }
-  free(vertexWeights);
-  free(rowPtr);
-  free(colIdx);
-  free(edgeWeights);
 
   results_.push_back(currentResults);
 
@@ -1366,6 +1360,17 @@ void PartitionMgr::partitionDesign(unsigned int max_num_macro,
                                    const char* report_directory,
                                    const char* file_name)
 {
+  if (network_->isReleased()) {
+    logger_->error(PAR,
+                   491,
+                   "partition_design needs the Verilog network, which was "
+                   "deleted by link_design -release_verilog.");
+  }
+  if (network_->topInstance() == nullptr) {
+    logger_->error(PAR,
+                   492,
+                   "partition_design needs a design linked with link_design.");
+  }
   auto clusterer
       = std::make_unique<AutoClusterMgr>(network_, db_, _sta, logger_);
   clusterer->partitionDesign(max_num_macro,
@@ -0,0 +1,23 @@
+# partition_design walks the verilog network, so it must refuse to run
+# after link_design -release_verilog deleted it.
+source "helpers.tcl"
+read_lef "Nangate45/Nangate45.lef"
+read_liberty "Nangate45/Nangate45_typ.lib"
+read_verilog "gcd.v"
+link_design -release_verilog gcd
+read_def -floorplan_initialize "gcd.def"
+
+set report_dir [make_result_file partition_design_released]
+file mkdir $report_dir
+if { [catch {partition_design -max_num_inst 100 -min_num_inst 20 \
+               -report_directory $report_dir \
+               -report_file gcd} error] } {
+  puts $error
+  if { $error == "PAR-0491" } {
+    puts "pass"
+  } else {
+    puts "fail: unexpected error"
+  }
+} else {
+  puts "fail: partition_design ran without the verilog network"
+}
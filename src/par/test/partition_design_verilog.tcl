@@ -0,0 +1,19 @@
+# partition_design on a design linked without -release_verilog.
+source "helpers.tcl"
+read_lef "Nangate45/Nangate45.lef"
+read_liberty "Nangate45/Nangate45_typ.lib"
+read_verilog "gcd.v"
+link_design gcd
+read_def -floorplan_initialize "gcd.def"
+
+set report_dir [make_result_file partition_design_verilog]
+file mkdir $report_dir
+partition_design -max_num_inst 100 -min_num_inst 20 \
+  -report_directory $report_dir \
+  -report_file gcd
+
+if { [file exists [file join $report_dir gcd.block]] } {
+  puts "pass"
+} else {
+  puts "fail: no cluster report written"
+}
@@ -4,3 +4,8 @@ record_tests {
   graph_clique
   graph_hybrid
 }
+
+record_pass_fail_tests {
+  partition_design_released
+  partition_design_verilog
+}
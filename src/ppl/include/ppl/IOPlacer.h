@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #include "Core.h"
@@ -59,6 +60,8 @@ class dbBlock;
 
 namespace ppl {
 
+class HungarianMatching;
+
 using odb::Point;
 using odb::Rect;
 
@@ -268,6 +271,10 @@ class IOPlacer
                                          Netlist& netlist);
   int returnIONetsHPWL(Netlist&);
   void findPinAssignment(std::vector<Section>& sections);
+  void solveSections(
+      std::vector<HungarianMatching>& hg_vec,
+      int threads,
+      const std::function<void(HungarianMatching&, int)>& solve);
   void updateSlots();
 
   void updateOrientation(IOPin& pin);
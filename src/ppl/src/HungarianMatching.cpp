@@ -36,6 +36,7 @@
 #include "HungarianMatching.h"
 
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 
 namespace ppl {
 
@@ -60,33 +61,47 @@ HungarianMatching::HungarianMatching(Section& section,
   logger_ = logger;
 }
 
-void HungarianMatching::findAssignment()
+// Run fill_row(row) for rows [0, rows) on up to threads threads.
+template <typename Func>
+static void parallelRows(int rows, int threads, Func fill_row)
 {
-  createMatrix();
+  utl::ThreadPool::get().parallelFor(0, rows, fill_row, threads);
+}
+
+void HungarianMatching::findAssignment(int threads)
+{
+  createMatrix(threads);
   hungarian_solver_.solve(hungarian_matrix_, assignment_);
 }
 
-void HungarianMatching::createMatrix()
+void HungarianMatching::createMatrix(int threads)
 {
-  hungarian_matrix_.resize(non_blocked_slots_);
-  int slot_index = 0;
+  std::vector<int> slot_rows;
   for (int i = begin_slot_; i <= end_slot_; ++i) {
-    int pinIndex = 0;
-    Point newPos = slots_[i].pos;
-    if (slots_[i].blocked) {
-      continue;
+    if (!slots_[i].blocked) {
+      slot_rows.push_back(i);
     }
-    hungarian_matrix_[slot_index].resize(num_io_pins_);
-    for (int idx : pin_indices_) {
-      const IOPin& io_pin = netlist_.getIoPin(idx);
-      if (!io_pin.isInGroup()) {
-        int hpwl = netlist_.computeIONetHPWL(idx, newPos);
-        hungarian_matrix_[slot_index][pinIndex] = hpwl;
-        pinIndex++;
-      }
+  }
+  std::vector<int> pin_cols;
+  for (int idx : pin_indices_) {
+    if (!netlist_.getIoPin(idx).isInGroup()) {
+      pin_cols.push_back(idx);
     }
-    slot_index++;
   }
+
+  hungarian_matrix_.resize(non_blocked_slots_);
+  // Rows only read the netlist and slots, so they are filled independently.
+  const int rows = std::min(non_blocked_slots_, static_cast<int>(slot_rows.size()));
+  parallelRows(rows, threads, [&](int slot_index) {
+    Point newPos = slots_[slot_rows[slot_index]].pos;
+    std::vector<int>& costs = hungarian_matrix_[slot_index];
+    costs.resize(num_io_pins_);
+    int pinIndex = 0;
+    for (int idx : pin_cols) {
+      costs[pinIndex] = netlist_.computeIONetHPWL(idx, newPos);
+      pinIndex++;
+    }
+  });
 }
 
 inline bool samePos(Point& a, Point& b)
@@ -128,21 +143,22 @@ void HungarianMatching::getFinalAssignment(std::vector<IOPin>& assigment) const
   }
 }
 
-void HungarianMatching::findAssignmentForGroups()
+void HungarianMatching::findAssignmentForGroups(int threads)
 {
-  createMatrixForGroups();
+  createMatrixForGroups(threads);
 
   if (hungarian_matrix_.size() > 0)
     hungarian_solver_.solve(hungarian_matrix_, assignment_);
 }
 
-void HungarianMatching::createMatrixForGroups()
+void HungarianMatching::createMatrixForGroups(int threads)
 {
   for (const std::vector<int>& io_group : pin_groups_) {
     group_size_ = std::max(static_cast<int>(io_group.size()), group_size_);
   }
 
   if (group_size_ > 0) {
+    std::vector<int> slot_rows;
     for (int i = begin_slot_; i < end_slot_; i += group_size_) {
       bool blocked = false;
       for (int pin_cnt = 0; pin_cnt < group_size_; pin_cnt++) {
@@ -151,27 +167,17 @@ void HungarianMatching::createMatrixForGroups()
         }
       }
       if (!blocked) {
-        group_slots_++;
+        slot_rows.push_back(i);
       }
     }
+    group_slots_ = slot_rows.size();
 
     hungarian_matrix_.resize(group_slots_);
-    int slot_index = 0;
-    for (int i = begin_slot_; i < end_slot_; i += group_size_) {
+    parallelRows(group_slots_, threads, [&](int slot_index) {
+      Point newPos = slots_[slot_rows[slot_index]].pos;
+      std::vector<int>& costs = hungarian_matrix_[slot_index];
+      costs.resize(num_pin_groups_);
       int groupIndex = 0;
-      Point newPos = slots_[i].pos;
-
-      bool blocked = false;
-      for (int pin_cnt = 0; pin_cnt < group_size_; pin_cnt++) {
-        if (slots_[i + pin_cnt].blocked) {
-          blocked = true;
-        }
-      }
-      if (blocked) {
-        continue;
-      }
-
-      hungarian_matrix_[slot_index].resize(num_pin_groups_);
       for (const std::vector<int>& io_group : pin_groups_) {
         int group_hpwl = 0;
         for (const int io_idx : io_group) {
@@ -183,11 +189,10 @@ void HungarianMatching::createMatrixForGroups()
             group_hpwl += pin_hpwl;
           }
         }
-        hungarian_matrix_[slot_index][groupIndex] = group_hpwl;
+        costs[groupIndex] = group_hpwl;
         groupIndex++;
       }
-      slot_index++;
-    }
+    });
   }
 }
 
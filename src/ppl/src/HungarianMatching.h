@@ -65,8 +65,9 @@ class HungarianMatching
                     std::vector<Slot>& slots,
                     Logger* logger);
   virtual ~HungarianMatching() = default;
-  void findAssignment();
-  void findAssignmentForGroups();
+  // threads is the number of threads used to fill the cost matrix.
+  void findAssignment(int threads = 1);
+  void findAssignmentForGroups(int threads = 1);
   void getFinalAssignment(std::vector<IOPin>& assigment) const;
   void getAssignmentForGroups(std::vector<IOPin>& assigment);
 
@@ -90,8 +91,8 @@ class HungarianMatching
   const int hungarian_fail = std::numeric_limits<int>::max();
   Logger* logger_;
 
-  void createMatrix();
-  void createMatrixForGroups();
+  void createMatrix(int threads);
+  void createMatrixForGroups(int threads);
 };
 
 }  // namespace ppl
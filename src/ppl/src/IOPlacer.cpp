@@ -42,6 +42,8 @@
 #include "odb/db.h"
 #include "ord/OpenRoad.hh"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
+#include "utl/Tracer.h"
 #include "utl/algorithms.h"
 
 namespace ppl {
@@ -1138,23 +1140,44 @@ void IOPlacer::findPinAssignment(std::vector<Section>& sections)
     }
   }
 
-  for (int idx = 0; idx < hg_vec.size(); idx++) {
-    hg_vec[idx].findAssignmentForGroups();
-  }
+  // Building and solving a matching only reads the netlist and slots, so
+  // sections are solved concurrently. Assignments update the slots and are
+  // collected serially in section order.
+  const int threads = utl::ThreadPool::get().threadCount();
+  solveSections(hg_vec, threads, [](HungarianMatching& hg, int threads) {
+    hg.findAssignmentForGroups(threads);
+  });
 
   for (int idx = 0; idx < hg_vec.size(); idx++) {
     hg_vec[idx].getAssignmentForGroups(assignment_);
   }
 
-  for (int idx = 0; idx < hg_vec.size(); idx++) {
-    hg_vec[idx].findAssignment();
-  }
+  solveSections(hg_vec, threads, [](HungarianMatching& hg, int threads) {
+    hg.findAssignment(threads);
+  });
 
   for (int idx = 0; idx < hg_vec.size(); idx++) {
     hg_vec[idx].getFinalAssignment(assignment_);
   }
 }
 
+void IOPlacer::solveSections(
+    std::vector<HungarianMatching>& hg_vec,
+    int threads,
+    const std::function<void(HungarianMatching&, int)>& solve)
+{
+  const int section_threads
+      = std::max(1, std::min(threads, static_cast<int>(hg_vec.size())));
+  // Threads left over when there are fewer sections than threads fill the
+  // cost matrices.
+  const int matrix_threads = std::max(1, threads / section_threads);
+  utl::ThreadPool::get().parallelFor(
+      0,
+      hg_vec.size(),
+      [&](int idx) { solve(hg_vec[idx], matrix_threads); },
+      section_threads);
+}
+
 void IOPlacer::updateSlots()
 {
   for (Slot& slot : slots_) {
@@ -1167,6 +1190,7 @@ void IOPlacer::updateSlots()
 
 void IOPlacer::run(bool random_mode)
 {
+  utl::TraceScope trace(PPL, "place_pins");
   initParms();
 
   initNetlistAndCore(hor_layers_, ver_layers_);
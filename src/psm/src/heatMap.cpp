@@ -39,7 +39,9 @@ IRDropDataSource::IRDropDataSource(PDNSim* psm, utl::Logger* logger) :
     gui::RealValueHeatMapDataSource(logger, "V", "IR Drop", "IRDrop", "IRDrop"),
     psm_(psm),
     tech_(nullptr),
-    layer_(nullptr)
+    layer_(nullptr),
+    min_drop_(0.0),
+    max_drop_(0.0)
 {
   addMultipleChoiceSetting(
       "Layer",
@@ -120,8 +122,8 @@ bool IRDropDataSource::populateMap()
       max = std::max(max, drop);
     }
   }
-  setMinValue(min);
-  setMaxValue(max);
+  min_drop_ = min;
+  max_drop_ = max;
 
   auto& ir_drop = ir_drops[layer_];
   for (const auto& [point, drop] : ir_drop) {
@@ -133,7 +135,10 @@ bool IRDropDataSource::populateMap()
 
 void IRDropDataSource::determineMinMax(const HeatMapDataSource::Map& map)
 {
-  // do nothing handled in populateMap
+  // range is determined in populateMap, the map may be rescaled without
+  // populating it again when the grid changes
+  setMinValue(min_drop_);
+  setMaxValue(max_drop_);
 }
 
 void IRDropDataSource::combineMapData(bool base_has_value,
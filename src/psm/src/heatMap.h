@@ -64,6 +64,9 @@ class IRDropDataSource : public gui::RealValueHeatMapDataSource
 
   odb::dbTechLayer* layer_;
 
+  double min_drop_;
+  double max_drop_;
+
   void ensureLayer();
   void setLayer(const std::string& name);
 };
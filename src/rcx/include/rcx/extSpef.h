@@ -45,6 +45,7 @@
 //#define AFILE FILE
 
 #include <map>
+#include <vector>
 
 namespace utl {
 class Logger;
@@ -130,6 +131,9 @@ class extSpef
   Ath__array1D<uint>* _idMapTable;
   Ath__array1D<char*>* _nameMapTable;
   uint _lastNameMapIndex;
+  // db objects resolved from *NAME_MAP entries, indexed by map id
+  std::vector<odb::dbNet*> _mapIdNet;
+  std::vector<odb::dbInst*> _mapIdInst;
 
   uint _cCnt;
   uint _rCnt;
@@ -575,8 +579,11 @@ class extSpef
   void resetNameTable(uint n);
   void createName(uint n, char* name);
   char* makeName(char* name);
+  void buildNameMapCache();
   odb::dbNet* getDbNet(uint* id, uint spefId = 0);
   odb::dbInst* getDbInst(uint id);
+  odb::dbNet* findDbNet(uint* id);
+  odb::dbInst* findDbInst();
   odb::dbCapNode* createCapNode(uint nodeId, char* capWord = NULL);
   void addCouplingCaps(odb::dbNet* net, double* totCap);
   void addCouplingCaps(odb::dbSet<odb::dbCCSeg>& capSet, double* totCap);
@@ -1356,7 +1356,7 @@ bool extSpef::setInSpef(char* filename, bool onlyOpen) {
     _nodeParser = new Ath__parser();
     _parser = new Ath__parser();
   }
-  _parser->openFile(filename);
+  _parser->mapFile(filename);
 
   return true;
 }
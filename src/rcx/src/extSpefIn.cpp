@@ -33,9 +33,12 @@
 #include <math.h>
 #include <wire.h>
 
+#include <algorithm>
+
 #include "rcx/extRCap.h"
 #include "rcx/extSpef.h"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 
 namespace rcx {
 
@@ -46,6 +49,15 @@ dbInst* extSpef::getDbInst(uint id) {
     uint instId = getNameMapId(id);
     return dbInst::getInst(_block, instId);
   }
+  if (id > 0 && id < _mapIdInst.size() && _mapIdInst[id])
+    return _mapIdInst[id];
+  dbInst* inst = findDbInst();
+  if (inst && id > 0 && id < _mapIdInst.size())
+    _mapIdInst[id] = inst;
+  return inst;
+}
+
+dbInst* extSpef::findDbInst() {
   dbInst* inst;
   uint ii = 0;
   uint jj = 0;
@@ -724,6 +736,18 @@ dbNet* extSpef::getDbNet(uint* id, uint spefId) {
     *id = getNameMapId(spefId);
     return dbNet::getNet(_block, *id);
   }
+  if (spefId > 0 && spefId < _mapIdNet.size() && _mapIdNet[spefId]) {
+    dbNet* net = _mapIdNet[spefId];
+    *id = net->getId();
+    return net;
+  }
+  dbNet* net = findDbNet(id);
+  if (net && spefId > 0 && spefId < _mapIdNet.size())
+    _mapIdNet[spefId] = net;
+  return net;
+}
+
+dbNet* extSpef::findDbNet(uint* id) {
   char hierD = _block->getHierarchyDelimeter();
   char* netName = _spefName;
   char* nName;
@@ -2072,6 +2096,7 @@ void extSpef::setupMapping(uint itermCnt) {
 void extSpef::resetNameTable(uint n) {
   _nameMapTable = new Ath__array1D<char*>(128000);
   _nameMapTable->reSize(n);
+  _nameMapTable->clear(NULL);
   _lastNameMapIndex = 0;
 }
 char* extSpef::makeName(char* name) {
@@ -2085,6 +2110,44 @@ void extSpef::createName(uint n, char* name) {
   _nameMapTable->set(n, newName);
   _lastNameMapIndex = n;
 }
+// Resolves every *NAME_MAP entry to its db net/instance up front so the
+// *D_NET section does a vector lookup per node instead of a name search.
+// Lookups in the block name hash tables are read only, so the entries are
+// split across threads.  The -m_map name variants are resolved lazily by
+// getDbNet/getDbInst and memoized there.
+void extSpef::buildNameMapCache() {
+  _mapIdNet.clear();
+  _mapIdInst.clear();
+  if (!_maxMapId || _useIds || _testParsing || _statsOnly
+      || _nameMapTable == NULL)
+    return;
+  _mapIdNet.resize(_maxMapId + 1, nullptr);
+  _mapIdInst.resize(_maxMapId + 1, nullptr);
+  if (_mMap || _rRun != 1)
+    return;
+
+  char** names = _nameMapTable->getTable();
+  const char hierD = _block->getHierarchyDelimeter();
+  const char divider = _divider[0];
+  // Ids are resolved in chunks so each task reuses its name buffer.
+  const uint chunk_size = 1024;
+  const int chunks = _maxMapId / chunk_size + 1;
+  utl::ThreadPool::get().parallelFor(0, chunks, [&](int chunk) {
+    const uint first = std::max(chunk * chunk_size, 1U);
+    const uint last = std::min((chunk + 1) * chunk_size - 1, _maxMapId);
+    std::string name;
+    for (uint id = first; id <= last; id++) {
+      if (names[id] == NULL)
+        continue;
+      name = names[id];
+      if (divider != hierD)
+        std::replace(name.begin(), name.end(), divider, hierD);
+      _mapIdNet[id] = _block->findNet(name.c_str());
+      _mapIdInst[id] = _block->findInst(name.c_str());
+    }
+  });
+}
+
 void extSpef::addNetNodeHash(dbNet* net) {
   char nodeWord[100];
   uint netId = net->getId();
@@ -2430,6 +2493,7 @@ uint extSpef::readBlock(uint debug, std::vector<dbNet*> tnets, bool force,
     _parser->syntaxError("Ports Section");
   else {
     _nodeParser->resetSeparator(_delimiter);
+    buildNameMapCache();
 
     if (_rRun == 1)
       setSpefFlag(false);
@@ -2451,6 +2515,14 @@ uint extSpef::readBlock(uint debug, std::vector<dbNet*> tnets, bool force,
     _multipleLoop = 0;
     _breakLoopNet = 0;
     bool doSortingRSeg = false;
+    // The *D_NET lines are split into words on the thread pool ahead of
+    // readDNet, which creates the db objects serially.
+    utl::ThreadPool& pool = utl::ThreadPool::get();
+    _parser->setParallelFor(
+        pool.threadCount(),
+        [&pool](int begin, int end, const std::function<void(int)>& body) {
+          pool.parallelFor(begin, end, body);
+        });
     do {
       cnt++;
       readDNet(debug);
@@ -2475,6 +2547,7 @@ uint extSpef::readBlock(uint debug, std::vector<dbNet*> tnets, bool force,
         }
       }
     } while (_parser->parseNextLine() > 0);
+    _parser->setParallelFor(1, nullptr);
     if (doSortingRSeg)
       _cornerBlock->preExttreeMergeRC(0.0, 0);
     if (_stampWire)
@@ -35,6 +35,8 @@
 
 #pragma once
 
+#include <sys/types.h>
+
 #include <functional>
 #include <string>
 
@@ -96,11 +98,20 @@ class Restructure
   void setMode(const char* mode_name);
   void setTieLoPort(sta::LibertyPort* loport);
   void setTieHiPort(sta::LibertyPort* hiport);
+  // Run an ABC script in this process with the linked ABC.
+  int runAbcScript(const std::string& abc_script_file);
 
  private:
   void deleteComponents();
   void getBlob(unsigned max_depth);
   void runABC();
+  void runAbcScripts(const std::vector<std::string>& abc_scripts,
+                     std::vector<int>& abc_status,
+                     std::vector<std::string>& files_to_remove);
+  pid_t spawnAbcScript(const char* openroad,
+                       const std::string& abc_script_file,
+                       const std::string& run_file,
+                       const std::string& log_file);
   void postABC(float worst_slack);
   bool writeAbcScript(std::string file_name);
   void writeOptCommands(std::ofstream& script);
@@ -34,11 +34,15 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "rmp/Restructure.h"
+#include <fcntl.h>
+#include <spawn.h>
+#include <tcl.h>
 #include <time.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -64,6 +68,8 @@
 #include "sta/Sta.hh"
 #include "utl/Logger.h"
 
+extern char** environ;
+
 using utl::RMP;
 using namespace abc;
 
@@ -171,7 +177,6 @@ void Restructure::runABC()
 
   // abc optimization
   std::vector<Mode> modes;
-  std::vector<pid_t> child_proc;
 
   if (is_area_mode_) {
     // Area Mode
@@ -181,7 +186,8 @@ void Restructure::runABC()
     modes = {Mode::DELAY_1, Mode::DELAY_2, Mode::DELAY_3, Mode::DELAY_4};
   }
 
-  child_proc.resize(modes.size(), 0);
+  std::vector<std::string> abc_scripts(modes.size());
+  std::vector<int> child_proc(modes.size(), 0);
 
   std::string best_blif;
   int best_inst_count = std::numeric_limits<int>::max();
@@ -211,22 +217,21 @@ void Restructure::runABC()
 	       abc_script_file);
 
     if (writeAbcScript(abc_script_file)) {
-      // call linked abc
-      Abc_Start();
-      Abc_Frame_t * abc_frame = Abc_FrameGetGlobalFrame();
-      const std::string command = "source " + abc_script_file;
-      child_proc[curr_mode_idx] = Cmd_CommandExecute( abc_frame, command.c_str() );
-      if ( child_proc[curr_mode_idx] )
-	{
-	  logger_->error(RMP, 26, "Error executing ABC command {}.", command);
-	  return;
-	}
-      Abc_Stop();
-      // exit linked abc
+      abc_scripts[curr_mode_idx] = abc_script_file;
       files_to_remove.emplace_back(abc_script_file);
     }
   }  // end modes
 
+  runAbcScripts(abc_scripts, child_proc, files_to_remove);
+
+  for (size_t curr_mode_idx = 0; curr_mode_idx < modes.size(); curr_mode_idx++) {
+    if (child_proc[curr_mode_idx]) {
+      const std::string command = "source " + abc_scripts[curr_mode_idx];
+      logger_->error(RMP, 26, "Error executing ABC command {}.", command);
+      return;
+    }
+  }
+
   // Inspect ABC results to choose blif with least instance count
   for (int curr_mode_idx = 0; curr_mode_idx < modes.size(); curr_mode_idx++) {
     // Skip failed ABC runs
@@ -290,6 +295,116 @@ void Restructure::runABC()
   }
 }
 
+// ABC keeps its state in globals, so only one mode can run in this
+// process at a time. With more than one thread the modes run in new
+// openroad processes started with posix_spawn, up to the thread count at
+// once. This process has threads of its own, so forking it is not safe.
+// Each child writes its ABC output to its own log file, and the logs are
+// reported in mode order when all the children are done, as they would
+// have been by a serial run. The status of each script is returned in
+// abc_status.
+void Restructure::runAbcScripts(const std::vector<std::string>& abc_scripts,
+                                std::vector<int>& abc_status,
+                                std::vector<std::string>& files_to_remove)
+{
+  const size_t max_procs
+      = std::max(ord::OpenRoad::openRoad()->getThreadCount(), 1);
+  const char* openroad = Tcl_GetNameOfExecutable();
+  std::vector<std::string> abc_logs(abc_scripts.size());
+  std::vector<std::pair<pid_t, size_t>> running;
+  auto wait_running = [&]() {
+    for (auto [pid, idx] : running) {
+      int wstatus;
+      if (waitpid(pid, &wstatus, 0) == pid && WIFEXITED(wstatus))
+        abc_status[idx] = WEXITSTATUS(wstatus);
+      else
+        abc_status[idx] = 1;
+    }
+    running.clear();
+  };
+
+  for (size_t idx = 0; idx < abc_scripts.size(); idx++) {
+    if (abc_scripts[idx].empty())
+      continue;
+
+    pid_t pid = -1;
+    if (max_procs > 1 && openroad != nullptr) {
+      const std::string run_file = abc_scripts[idx] + ".run";
+      abc_logs[idx] = abc_scripts[idx] + ".log";
+      files_to_remove.emplace_back(run_file);
+      files_to_remove.emplace_back(abc_logs[idx]);
+      pid = spawnAbcScript(openroad, abc_scripts[idx], run_file, abc_logs[idx]);
+      if (pid <= 0)
+        abc_logs[idx].clear();
+    }
+    if (pid > 0)
+      running.emplace_back(pid, idx);
+    else
+      // Single thread or the spawn failed.
+      abc_status[idx] = runAbcScript(abc_scripts[idx]);
+
+    if (running.size() == max_procs)
+      wait_running();
+  }
+  wait_running();
+
+  for (const std::string& abc_log : abc_logs) {
+    if (abc_log.empty())
+      continue;
+    std::ifstream log(abc_log);
+    std::string line;
+    while (std::getline(log, line))
+      logger_->report("{}", line);
+  }
+}
+
+// Start a new openroad that runs abc_script_file and writes its output to
+// log_file. Returns the pid of the child, or -1 if it could not be started.
+pid_t Restructure::spawnAbcScript(const char* openroad,
+                                  const std::string& abc_script_file,
+                                  const std::string& run_file,
+                                  const std::string& log_file)
+{
+  std::ofstream run(run_file.c_str());
+  if (!run.is_open())
+    return -1;
+  run << "rmp::run_abc_script_cmd {" << abc_script_file << "}" << std::endl;
+  run.close();
+
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_addopen(&actions,
+                                   STDOUT_FILENO,
+                                   log_file.c_str(),
+                                   O_WRONLY | O_CREAT | O_TRUNC,
+                                   0644);
+  posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+
+  std::vector<std::string> args
+      = {openroad, "-no_init", "-no_splash", "-exit", run_file};
+  std::vector<char*> argv;
+  for (std::string& arg : args)
+    argv.push_back(arg.data());
+  argv.push_back(nullptr);
+
+  pid_t pid;
+  int err = posix_spawn(&pid, openroad, &actions, nullptr, argv.data(), environ);
+  posix_spawn_file_actions_destroy(&actions);
+  return err == 0 ? pid : -1;
+}
+
+int Restructure::runAbcScript(const std::string& abc_script_file)
+{
+  // call linked abc
+  Abc_Start();
+  Abc_Frame_t* abc_frame = Abc_FrameGetGlobalFrame();
+  const std::string command = "source " + abc_script_file;
+  int status = Cmd_CommandExecute(abc_frame, command.c_str());
+  Abc_Stop();
+  // exit linked abc
+  return status;
+}
+
 void Restructure::postABC(float worst_slack)
 {
   // Leave the parasitics up to date.
@@ -81,6 +81,17 @@ restructure_cmd(char* liberty_file_name, char* target, float slack_threshold,
                         workdir_name, abc_logfile);
 }
 
+// Runs one ABC script for restructure in a child openroad.
+void
+run_abc_script_cmd(const char* abc_script_file)
+{
+  if (getRestructure()->runAbcScript(abc_script_file) != 0) {
+    getOpenRoad()->getLogger()->error(utl::RMP, 37,
+                                      "Error executing ABC script {}.",
+                                      abc_script_file);
+  }
+}
+
 // Locally Exposed for testing only..
 Blif* create_blif(const char* hicell, const char* hiport, const char* locell, const char* loport){
   return new rmp::Blif(getOpenRoad()->getLogger(), getOpenRoad()->getSta(), locell, loport, hicell, hiport);
@@ -0,0 +1,34 @@
+# restructure with several threads runs the ABC modes in child processes.
+# The netlist and the report must be the ones of a single thread run.
+source "helpers.tcl"
+
+proc run_restructure { threads } {
+  set ::env(RESTRUCTURE_THREADS) $threads
+  set ::env(RESTRUCTURE_DEF) \
+    [make_result_file gcd_restructure_threads_$threads.def]
+  set log [exec [info nameofexecutable] -no_init -no_splash -exit \
+             gcd_restructure_threads_run.tcl 2>@1]
+  # Only the thread count report differs.
+  set lines {}
+  foreach line [split $log "\n"] {
+    if { ![string match "*ORD-0030*" $line] } {
+      lappend lines $line
+    }
+  }
+  return $lines
+}
+
+set log1 [run_restructure 1]
+set log4 [run_restructure 4]
+
+if { $log1 != $log4 } {
+  puts "fail: restructure reports differ between 1 and 4 threads"
+  exit 1
+}
+if { [diff_files [make_result_file gcd_restructure_threads_1.def] \
+        [make_result_file gcd_restructure_threads_4.def]] } {
+  puts "fail: restructure netlists differ between 1 and 4 threads"
+  exit 1
+}
+puts "pass"
+exit 0
@@ -0,0 +1,21 @@
+# restructure gcd with $env(RESTRUCTURE_THREADS) threads for
+# gcd_restructure_threads.tcl.
+source "helpers.tcl"
+read_liberty Nangate45/Nangate45_typ.lib
+read_lef Nangate45/Nangate45.lef
+read_def gcd_placed.def
+read_sdc gcd.sdc
+
+set_wire_rc -layer metal3
+estimate_parasitics -placement
+
+set tiehi "LOGIC1_X1/Z"
+set tielo "LOGIC0_X1/Z"
+
+ord::set_thread_count $env(RESTRUCTURE_THREADS)
+restructure -liberty_file Nangate45/Nangate45_typ.lib -target area \
+  -abc_logfile results/abc_threads.log -tielo_port $tielo -tiehi_port $tiehi \
+  -work_dir ./results
+
+report_design_area
+write_def $env(RESTRUCTURE_DEF)
@@ -10,3 +10,7 @@ record_tests {
   blif_reader_const
   blif_reader_sequential
 }
+
+record_pass_fail_tests {
+  gcd_restructure_threads
+}
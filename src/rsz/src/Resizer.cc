@@ -39,6 +39,7 @@
 
 #include "gui/gui.h"
 #include "utl/Logger.h"
+#include "utl/Tracer.h"
 
 #include "sta/Report.hh"
 #include "sta/FuncExpr.hh"
@@ -685,6 +686,7 @@ Resizer::repairDesign(double max_wire_length, // zero for none (meters)
                       int &fanout_violations,
                       int &length_violations)
 {
+  utl::TraceScope trace(RSZ, "repair_design");
   repair_count = 0;
   slew_violations = 0;
   cap_violations = 0;
@@ -2325,6 +2327,7 @@ void
 Resizer::repairSetup(float slack_margin,
                      int max_passes)
 {
+  utl::TraceScope trace(RSZ, "repair_setup");
   inserted_buffer_count_ = 0;
   resize_count_ = 0;
   Slack worst_slack;
@@ -2666,6 +2669,7 @@ Resizer::repairHold(float slack_margin,
                     // Max buffer count as percent of design instance count.
                     float max_buffer_percent)
 {
+  utl::TraceScope trace(RSZ, "repair_hold");
   init();
   LibertyCell *buffer_cell = findHoldBuffer();
   sta_->findRequireds();
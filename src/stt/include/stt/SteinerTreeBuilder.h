@@ -93,6 +93,17 @@ class SteinerTreeBuilder
                        std::vector<int>& x,
                        std::vector<int>& y,
                        int drvr_index);
+  // Build the trees for a batch of nets concurrently.
+  // xs[i], ys[i] and drvr_indices[i] are the pins of net i and the tree
+  // for net i is returned in position i.
+  std::vector<Tree> makeSteinerTrees(std::vector<std::vector<int>>& xs,
+                                     std::vector<std::vector<int>>& ys,
+                                     const std::vector<int>& drvr_indices);
+  // Same as above using the alpha for each of nets.
+  std::vector<Tree> makeSteinerTrees(const std::vector<odb::dbNet*>& nets,
+                                     std::vector<std::vector<int>>& xs,
+                                     std::vector<std::vector<int>>& ys,
+                                     const std::vector<int>& drvr_indices);
   // API only for FastRoute, that requires the use of flutes in its
   // internal flute implementation
   Tree makeSteinerTree(const std::vector<int>& x,
@@ -109,6 +120,11 @@ class SteinerTreeBuilder
 
  private:
   int computeHPWL(odb::dbNet* net);
+  float netAlpha(odb::dbNet* net);
+  std::vector<Tree> makeSteinerTrees(const std::vector<float>& alphas,
+                                     std::vector<std::vector<int>>& xs,
+                                     std::vector<std::vector<int>>& ys,
+                                     const std::vector<int>& drvr_indices);
 
   const int flute_accuracy = 3;
   float alpha_;
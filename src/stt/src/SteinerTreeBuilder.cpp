@@ -38,11 +38,13 @@
 #include "stt/flute.h"
 #include "stt/pdrev.h"
 
+#include <algorithm>
 #include <map>
 #include <vector>
 
 #include "ord/OpenRoad.hh"
 #include "odb/db.h"
+#include "utl/ThreadPool.h"
 
 namespace stt {
 
@@ -78,13 +80,19 @@ Tree SteinerTreeBuilder::makeSteinerTree(odb::dbNet* net,
                                          std::vector<int>& x,
                                          std::vector<int>& y,
                                          int drvr_index)
+{
+  return makeSteinerTree(x, y, drvr_index, netAlpha(net));
+}
+
+float SteinerTreeBuilder::netAlpha(odb::dbNet* net)
 {
   float net_alpha = alpha_;
   int min_fanout = min_fanout_alpha_.first;
   int min_hpwl = min_hpwl_alpha_.first;
 
-  if (net_alpha_map_.find(net) != net_alpha_map_.end()) {
-    net_alpha = net_alpha_map_[net];
+  auto itr = net_alpha_map_.find(net);
+  if (itr != net_alpha_map_.end()) {
+    net_alpha = itr->second;
   } else if (min_hpwl > 0) {
     if (computeHPWL(net) >= min_hpwl) {
       net_alpha = min_hpwl_alpha_.second;
@@ -95,7 +103,47 @@ Tree SteinerTreeBuilder::makeSteinerTree(odb::dbNet* net,
     }
   }
 
-  return makeSteinerTree(x, y, drvr_index, net_alpha);
+  return net_alpha;
+}
+
+std::vector<Tree>
+SteinerTreeBuilder::makeSteinerTrees(std::vector<std::vector<int>>& xs,
+                                     std::vector<std::vector<int>>& ys,
+                                     const std::vector<int>& drvr_indices)
+{
+  std::vector<float> alphas(xs.size(), alpha_);
+  return makeSteinerTrees(alphas, xs, ys, drvr_indices);
+}
+
+std::vector<Tree>
+SteinerTreeBuilder::makeSteinerTrees(const std::vector<odb::dbNet*>& nets,
+                                     std::vector<std::vector<int>>& xs,
+                                     std::vector<std::vector<int>>& ys,
+                                     const std::vector<int>& drvr_indices)
+{
+  // Alphas are found up front because computeHPWL can report errors.
+  std::vector<float> alphas;
+  alphas.reserve(nets.size());
+  for (odb::dbNet* net : nets) {
+    alphas.push_back(netAlpha(net));
+  }
+  return makeSteinerTrees(alphas, xs, ys, drvr_indices);
+}
+
+std::vector<Tree>
+SteinerTreeBuilder::makeSteinerTrees(const std::vector<float>& alphas,
+                                     std::vector<std::vector<int>>& xs,
+                                     std::vector<std::vector<int>>& ys,
+                                     const std::vector<int>& drvr_indices)
+{
+  const int net_count = xs.size();
+  std::vector<Tree> trees(net_count);
+  // Each tree only depends on its own net so the trees are built
+  // independently. The FLUTE LUTs are shared read-only.
+  utl::ThreadPool::get().parallelFor(0, net_count, [&](int i) {
+    trees[i] = makeSteinerTree(xs[i], ys[i], drvr_indices[i], alphas[i]);
+  });
+  return trees;
 }
 
 Tree SteinerTreeBuilder::makeSteinerTree(std::vector<int>& x,
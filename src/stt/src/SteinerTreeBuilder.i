@@ -133,6 +133,56 @@ report_stt_tree(std::vector<int> x,
   stt::reportSteinerTree(tree, x[drvr_index], y[drvr_index], logger);
 }
 
+// Nets queued by add_batch_net for check_batch_trees.
+static std::vector<std::vector<int>> batch_xs;
+static std::vector<std::vector<int>> batch_ys;
+static std::vector<int> batch_drvr_indices;
+
+void
+add_batch_net(std::vector<int> x,
+              std::vector<int> y,
+              int drvr_index)
+{
+  batch_xs.push_back(x);
+  batch_ys.push_back(y);
+  batch_drvr_indices.push_back(drvr_index);
+}
+
+// Build the queued nets with makeSteinerTrees and with makeSteinerTree
+// one net at a time. Returns the number of nets whose trees differ.
+int
+check_batch_trees(float alpha)
+{
+  auto builder = getSteinerTreeBuilder();
+  const float prev_alpha = builder->getAlpha();
+  builder->setAlpha(alpha);
+  std::vector<stt::Tree> trees = builder->makeSteinerTrees(batch_xs,
+                                                           batch_ys,
+                                                           batch_drvr_indices);
+  int diff_count = 0;
+  for (int i = 0; i < trees.size(); i++) {
+    stt::Tree tree = builder->makeSteinerTree(batch_xs[i],
+                                              batch_ys[i],
+                                              batch_drvr_indices[i]);
+    const stt::Tree& batch_tree = trees[i];
+    bool same = tree.deg == batch_tree.deg
+      && tree.length == batch_tree.length
+      && tree.branch.size() == batch_tree.branch.size();
+    for (int j = 0; same && j < tree.branch.size(); j++) {
+      const stt::Branch& b1 = tree.branch[j];
+      const stt::Branch& b2 = batch_tree.branch[j];
+      same = b1.x == b2.x && b1.y == b2.y && b1.n == b2.n;
+    }
+    if (!same)
+      diff_count++;
+  }
+  builder->setAlpha(prev_alpha);
+  batch_xs.clear();
+  batch_ys.clear();
+  batch_drvr_indices.clear();
+  return diff_count;
+}
+
 void
 highlight_stt_tree(std::vector<int> x,
                    std::vector<int> y,
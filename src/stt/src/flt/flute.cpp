@@ -37,6 +37,8 @@
 #include <math.h>
 #include <string>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include "stt/flute.h"
 
 // Use flute LUT file reader.
@@ -205,7 +207,8 @@ static void
 deleteLUT(LUT_TYPE &LUT,
 	  NUMSOLN_TYPE &numsoln);
 static void
-initLUT(int to_d,
+initLUT(int from_d,
+        int to_d,
         LUT_TYPE LUT,
 	NUMSOLN_TYPE numsoln);
 static void
@@ -222,7 +225,11 @@ checkLUT(LUT_TYPE LUT1,
 
 // LUTs are initialized to this order at startup.
 static constexpr int lut_initial_d = 8;
-static int lut_valid_d = 0;
+// LUT entries for degrees <= lut_valid_d are complete and never change
+// again, so they are read without locking. lut_mutex serializes loading
+// and extending the LUTs.
+static std::atomic<int> lut_valid_d(0);
+static std::mutex lut_mutex;
 
 extern std::string post9;
 extern std::string powv9;
@@ -236,7 +243,8 @@ static void readLUT() {
 
 #elif LUT_SOURCE==LUT_VAR
   // Only init to d=8 on startup because d=9 is big and slow.
-  initLUT(lut_initial_d, LUT, numsoln);
+  initLUT(4, lut_initial_d, LUT, numsoln);
+  lut_valid_d = lut_initial_d;
 
 #elif LUT_SOURCE==LUT_VAR_CHECK
   readLUTfiles(LUT, numsoln);
@@ -244,8 +252,9 @@ static void readLUT() {
   LUT_TYPE LUT_;
   NUMSOLN_TYPE numsoln_;
   makeLUT(LUT_, numsoln_);
-  initLUT(FLUTE_D, LUT_, numsoln_);
+  initLUT(4, FLUTE_D, LUT_, numsoln_);
   checkLUT(LUT, numsoln, LUT_, numsoln_);
+  lut_valid_d = FLUTE_D;
 #endif
 }
 
@@ -264,7 +273,11 @@ makeLUT(LUT_TYPE &LUT,
 void
 deleteLUT()
 {
+  std::lock_guard<std::mutex> lock(lut_mutex);
   deleteLUT(LUT, numsoln);
+  LUT = nullptr;
+  numsoln = nullptr;
+  lut_valid_d = 0;
 }
 
 static void
@@ -292,9 +305,12 @@ charNum(unsigned char c)
     return 0;
 }
 
-// Init LUTs from base64 encoded string variables.
+// Init LUTs for degrees from_d..to_d from base64 encoded string variables.
+// Lower degrees are parsed to find the start of from_d but not stored so
+// that existing entries are left untouched for concurrent readers.
 static void
-initLUT(int to_d,
+initLUT(int from_d,
+        int to_d,
         LUT_TYPE LUT,
 	NUMSOLN_TYPE numsoln) {
   std::string pwv_string = base64_decode(powv9);
@@ -313,19 +329,26 @@ initLUT(int to_d,
     sscanf(prt, "d=%d%n", &d, &char_cnt);
     prt += char_cnt + 1;
 #endif
+    const bool store = d >= from_d;
     for (int k = 0; k < numgrp[d]; k++) {
       int ns = charNum(*pwv++);
       if (ns == 0) {  // same as some previous group
 	int kk;
 	sscanf(pwv, "%d%n", &kk, &char_cnt);
 	pwv += char_cnt + 1;
-	numsoln[d][k] = numsoln[d][kk];
-	LUT[d][k] = LUT[d][kk];
+	if (store) {
+	  numsoln[d][k] = numsoln[d][kk];
+	  LUT[d][k] = LUT[d][kk];
+	}
       } else {
 	pwv++;   // '\n'
-	numsoln[d][k] = ns;
-	struct csoln *p = new struct csoln[ns];
-	LUT[d][k] = p;
+	struct csoln skipped;
+	struct csoln *p = &skipped;
+	if (store) {
+	  numsoln[d][k] = ns;
+	  p = new struct csoln[ns];
+	  LUT[d][k] = p;
+	}
 	for (int i = 1; i <= ns; i++) {
 	  p->parent = charNum(*pwv++);
 
@@ -360,20 +383,26 @@ initLUT(int to_d,
 	  }
 	  prt++;  // \n
 #endif
-	  p++;
+	  if (store)
+	    p++;
 	}
       }
     }
   }
-  lut_valid_d = to_d;
 }
 
 static void
 ensureLUT(int d) {
+  int valid_d = lut_valid_d.load(std::memory_order_acquire);
+  if (valid_d > 0 && (d <= valid_d || d > FLUTE_D))
+    return;
+  std::lock_guard<std::mutex> lock(lut_mutex);
   if (LUT == nullptr)
     readLUT();
-  if (d > lut_valid_d && d <= FLUTE_D) {
-    initLUT(FLUTE_D, LUT, numsoln);
+  valid_d = lut_valid_d;
+  if (d > valid_d && d <= FLUTE_D) {
+    initLUT(valid_d + 1, FLUTE_D, LUT, numsoln);
+    lut_valid_d.store(FLUTE_D, std::memory_order_release);
   }
 }
 
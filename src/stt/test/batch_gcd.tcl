@@ -0,0 +1,22 @@
+# makeSteinerTrees on gcd should match makeSteinerTree one net at a time
+source "stt_helpers.tcl"
+
+set_thread_count 4
+set nets [read_nets "gcd.nets"]
+set fail 0
+foreach alpha {0.0 0.3 0.8} {
+  foreach net $nets {
+    add_batch_net $net
+  }
+  set diff_count [stt::check_batch_trees $alpha]
+  puts "alpha $alpha: $diff_count of [llength $nets] trees differ"
+  if { $diff_count != 0 } {
+    set fail 1
+  }
+}
+
+if { $fail } {
+  puts "fail"
+} else {
+  puts "pass"
+}
@@ -7,3 +7,7 @@ record_tests {
   pd_gcd
   pdrev_gcd
 }
+
+record_pass_fail_tests {
+  batch_gcd
+}
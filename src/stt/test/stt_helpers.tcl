@@ -138,6 +138,18 @@ proc report_flute_net { net } {
   stt::report_flute_tree $xs $ys $drvr_index
 }
 
+proc add_batch_net { net } {
+  set pins [lassign $net net_name drvr_index]
+  set xs {}
+  set ys {}
+  foreach pin $pins {
+    lassign $pin pin_name x y
+    lappend xs $x
+    lappend ys $y
+  }
+  stt::add_batch_net $xs $ys $drvr_index
+}
+
 proc find_net { nets net_name } {
   foreach net $nets {
   set pins [lassign $net name drvr_index]
@@ -38,7 +38,9 @@
 #include <string>
 #include <vector>
 #include <array>
+#include <atomic>
 #include <map>
+#include <memory>
 #include <string_view>
 #include <cstdlib>
 #include <type_traits>
@@ -88,6 +90,8 @@ enum ToolId
  SIZE // the number of tools, do not put anything after this
 };
 
+class MessageBuffer;
+
 class Logger
 {
  public:
@@ -96,12 +100,13 @@ class Logger
          const char *metrics_filename = nullptr);
   ~Logger();
   static ToolId findToolId(const char *tool_name);
+  static const char *toolName(ToolId tool) { return tool_names_[tool]; }
 
   template <typename... Args>
     inline void report(const std::string& message,
                        const Args&... args)
     {
-      logger_->log(spdlog::level::level_enum::off, message, args...);
+      activeLogger()->log(spdlog::level::level_enum::off, message, args...);
     }
 
   // Do NOT call this directly, use the debugPrint macro  instead (defined below)
@@ -112,13 +117,13 @@ class Logger
                       const Args&... args)
     {
       // Message counters do NOT apply to debug messages.
-      logger_->log(spdlog::level::level_enum::debug,
-                   "[{} {}-{:04d}] " + message,
-                   level_names[spdlog::level::level_enum::debug],
-                   tool_names_[tool],
-                   level,
-                   args...);
-      logger_->flush();
+      activeLogger()->log(spdlog::level::level_enum::debug,
+                          "[{} {}-{:04d}] " + message,
+                          level_names[spdlog::level::level_enum::debug],
+                          tool_names_[tool],
+                          level,
+                          args...);
+      activeLogger()->flush();
     }
 
   template <typename... Args>
@@ -206,30 +211,62 @@ class Logger
                     const Args&... args)
     {
       assert(id >= 0 && id <= max_message_id);
-      auto& counter = message_counters_[tool][id];
-      auto count = counter++;
-      if (count < max_message_print) {
+      if (thread_buffer_ != nullptr) {
+        // Counted when the buffer is flushed so the message limit
+        // applies in the same order as in a serial run.
+        bufferMessage(tool,
+                      level,
+                      id,
+                      fmt::format("[{} {}-{:04d}] " + message,
+                                  level_names[level],
+                                  tool_names_[tool],
+                                  id,
+                                  args...));
+        return;
+      }
+      if (countMessage(tool, level, id)) {
         logger_->log(level,
                      "[{} {}-{:04d}] " + message,
                      level_names[level],
                      tool_names_[tool],
                      id,
                      args...);
-        return;
       }
+    }
 
-      if (count == max_message_print) {
-        logger_->log(level,
-                     "[{} {}-{:04d}] message limit reached, "
-                     "this message will no longer print",
-                     level_names[level],
-                     tool_names_[tool],
-                     id);
-      } else {
-        counter--; // to avoid counter overflow
-      }
+  // Returns true if the message is under the print limit.
+  bool countMessage(ToolId tool, spdlog::level::level_enum level, int id)
+  {
+    auto& counter = message_counters_[tool][id];
+    auto count = counter++;
+    if (count < max_message_print) {
+      return true;
     }
 
+    if (count == max_message_print) {
+      logger_->log(level,
+                   "[{} {}-{:04d}] message limit reached, "
+                   "this message will no longer print",
+                   level_names[level],
+                   tool_names_[tool],
+                   id);
+    } else {
+      counter--; // to avoid counter overflow
+    }
+    return false;
+  }
+
+  static void bufferMessage(ToolId tool,
+                            spdlog::level::level_enum level,
+                            int id,
+                            const std::string& message);
+
+  // Messages go to the calling thread's MessageBuffer when it has one.
+  spdlog::logger* activeLogger() const
+  {
+    return thread_logger_ ? thread_logger_ : logger_.get();
+  }
+
   template <typename Value>
     inline void log_metric(const std::string_view metric,
                            const Value& value)
@@ -262,7 +299,7 @@ class Logger
 
   // This matrix is pre-allocated so it can be safely updated
   // from multiple threads without locks.
-  using MessageCounter = std::array<short, max_message_id + 1>;
+  using MessageCounter = std::array<std::atomic<short>, max_message_id + 1>;
   std::array<MessageCounter, ToolId::SIZE> message_counters_;
   std::array<DebugGroups, ToolId::SIZE> debug_group_level_;
   bool debug_on_;
@@ -276,6 +313,34 @@ class Logger
                                                 "OFF"};
   static constexpr const char *pattern_ = "%v";
   static constexpr const char* tool_names_[] = { FOREACH_TOOL(GENERATE_STRING) };
+  static thread_local spdlog::logger* thread_logger_;
+  static thread_local MessageBuffer* thread_buffer_;
+
+  friend class MessageBuffer;
+};
+
+// Holds back the messages logged by a thread so work that runs
+// concurrently can report in a deterministic order.  Messages logged
+// by the thread that calls begin() are kept until end(), and flush()
+// prints them through the logger in the order they were logged.
+class MessageBuffer
+{
+ public:
+  MessageBuffer();
+
+  void begin();
+  void end();
+  void flush(Logger* logger);
+
+ private:
+  class Sink;
+
+  std::shared_ptr<Sink> sink_;
+  std::shared_ptr<spdlog::logger> logger_;
+  spdlog::logger* previous_;
+  MessageBuffer* previous_buffer_;
+
+  friend class Logger;
 };
 
 // Use this macro for any debug messages.  It avoids evaluating message and varargs
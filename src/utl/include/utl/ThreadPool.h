@@ -0,0 +1,126 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utl {
+
+// Process wide pool of worker threads shared by all tools so that they
+// stay within the set_thread_count budget together. The pool owns
+// threadCount() - 1 workers. A thread that waits for work (parallelFor,
+// TaskGroup::wait) runs queued tasks while it waits, so nested parallel
+// work neither deadlocks nor starts more threads.
+class ThreadPool
+{
+ public:
+  static ThreadPool& get();
+
+  // Called by set_thread_count. Must not be called while work is queued.
+  void setThreadCount(int threads);
+  int threadCount() const { return threads_; }
+
+  // Index of the calling thread in [0, threadCount()). Threads that are
+  // not pool workers (the main thread) are 0. Use it to select per-thread
+  // scratch data. Scratch must not be held across a nested wait because
+  // the waiting thread may run other tasks.
+  static int threadIndex();
+
+  // Call body(i) for each i in [begin, end) on up to max_threads threads
+  // (threadCount() if max_threads is 0). The calling thread takes part.
+  // The first exception thrown by body stops the remaining iterations and
+  // is rethrown here.
+  void parallelFor(int begin,
+                   int end,
+                   const std::function<void(int)>& body,
+                   int max_threads = 0);
+
+ private:
+  ThreadPool();
+  ~ThreadPool();
+
+  void startWorkers();
+  void stopWorkers();
+  void workerLoop(int index);
+  void enqueue(std::function<void()> task);
+  // Run one queued task. Returns false if the queue is empty.
+  bool runOne();
+  // Run queued tasks until done() is true.
+  void waitUntil(const std::function<bool()>& done);
+  void notifyDone();
+
+  int threads_;
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> queue_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_;
+
+  friend class TaskGroup;
+};
+
+// A set of tasks run on the thread pool that can be waited for as a
+// group. Tasks that have not started when the group is canceled are
+// skipped; running tasks can poll isCanceled(). The first exception
+// thrown by a task cancels the group and is rethrown by wait().
+class TaskGroup
+{
+ public:
+  explicit TaskGroup(ThreadPool& pool = ThreadPool::get());
+  // Waits for the tasks; exceptions are dropped.
+  ~TaskGroup();
+
+  void run(std::function<void()> task);
+  void wait();
+  void cancel() { canceled_ = true; }
+  bool isCanceled() const { return canceled_; }
+
+ private:
+  ThreadPool& pool_;
+  std::atomic<int> pending_;
+  std::atomic<bool> canceled_;
+  std::mutex exception_mutex_;
+  std::exception_ptr exception_;
+};
+
+}  // namespace utl
@@ -0,0 +1,172 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "utl/Logger.h"
+
+namespace utl {
+
+// Process wide recorder of timed spans and counters for runtime
+// attribution. Recording is off by default and a disabled trace point
+// costs one relaxed atomic load. Each thread appends to its own buffer
+// under the buffer's own lock, so enabled trace points only contend with
+// enable() and the writers, which lock every buffer they touch.
+//
+// Span and counter names must outlive the tracer (string literals); use
+// intern() for names built at run time.
+class Tracer
+{
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  static Tracer& get();
+
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+  // Enabling drops previously recorded events.
+  void enable();
+  void disable();
+
+  void addSpan(ToolId tool,
+               const char* name,
+               Clock::time_point start,
+               Clock::time_point end);
+  void addCounter(ToolId tool, const char* name, double value);
+  const char* intern(const std::string& name);
+
+  // Spans opened from scripts to mark flow stages. They nest.
+  void beginStage(const std::string& name);
+  void endStage();
+
+  // Chrome trace event format, readable by chrome://tracing and Perfetto.
+  bool writeChromeTrace(const char* filename) const;
+  // Total runtime and calls per span name and the peak memory.
+  void reportSummary(Logger* logger) const;
+  void writeMetrics(Logger* logger) const;
+
+  // Peak resident set size of the process in KB.
+  static long peakMemory();
+
+ private:
+  struct Event
+  {
+    ToolId tool;
+    const char* name;
+    // Microseconds since enable().
+    double start;
+    double duration;  // < 0 for counters
+    double value;     // counter value or peak memory for spans
+  };
+
+  struct ThreadBuffer
+  {
+    int id;
+    std::mutex mutex;
+    std::vector<Event> events;
+  };
+
+  struct SpanTotal
+  {
+    double duration = 0;
+    int count = 0;
+    double peak_memory = 0;
+  };
+  using SpanTotals = std::map<std::pair<ToolId, std::string>, SpanTotal>;
+
+  Tracer();
+
+  ThreadBuffer* threadBuffer();
+  SpanTotals spanTotals() const;
+  double sinceEpoch(Clock::time_point time) const;
+
+  static std::atomic<bool> enabled_;
+  static thread_local ThreadBuffer* thread_buffer_;
+  // Only changed by enable() while every buffer is locked.
+  Clock::time_point epoch_;
+  // Guards the buffer list and names_. Taken before any buffer lock.
+  mutable std::mutex mutex_;
+  // Buffers are never freed so thread_local pointers to them stay valid
+  // after enable() clears them.
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+  std::set<std::string> names_;
+  // Stages are only used by the script thread.
+  std::vector<std::pair<const char*, Clock::time_point>> stages_;
+};
+
+// Records a span from construction to destruction (or end()).
+class TraceScope
+{
+ public:
+  TraceScope(ToolId tool, const char* name)
+      : tool_(tool), name_(Tracer::enabled() ? name : nullptr)
+  {
+    if (name_)
+      start_ = Tracer::Clock::now();
+  }
+  ~TraceScope() { end(); }
+
+  void end()
+  {
+    if (name_) {
+      Tracer::get().addSpan(tool_, name_, start_, Tracer::Clock::now());
+      name_ = nullptr;
+    }
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+  ToolId tool_;
+  const char* name_;
+  Tracer::Clock::time_point start_;
+};
+
+inline void traceCounter(ToolId tool, const char* name, double value)
+{
+  if (Tracer::enabled())
+    Tracer::get().addCounter(tool, name, value);
+}
+
+}  // namespace utl
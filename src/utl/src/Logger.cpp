@@ -38,6 +38,7 @@
 #include <mutex>
 #include <atomic>
 
+#include "spdlog/sinks/base_sink.h"
 #include "spdlog/sinks/basic_file_sink.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 #include "spdlog/spdlog.h"
@@ -45,6 +46,8 @@
 namespace utl {
 
 int Logger::max_message_print = 1000;
+thread_local spdlog::logger* Logger::thread_logger_ = nullptr;
+thread_local MessageBuffer* Logger::thread_buffer_ = nullptr;
 
 Logger::Logger(const char* log_filename, const char *metrics_filename)
   : debug_on_(false),
@@ -52,8 +55,8 @@ Logger::Logger(const char* log_filename, const char *metrics_filename)
 {
   // This ensures it is safe to update the message counters
   // without using locks.
-  static_assert(std::atomic<MessageCounter::value_type>::is_always_lock_free,
-                "message counter should be atomic");
+  static_assert(MessageCounter::value_type::is_always_lock_free,
+                "message counter should be lock free");
 
  sinks_.push_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
   if (log_filename)
@@ -68,7 +71,9 @@ Logger::Logger(const char* log_filename, const char *metrics_filename)
     addMetricsSink(metrics_filename);
 
   for (auto& counters : message_counters_) {
-    counters.fill(0);
+    for (auto& counter : counters) {
+      counter = 0;
+    }
   }
 }
 
@@ -138,4 +143,75 @@ void Logger::removeSink(spdlog::sink_ptr sink)
   }
 }
 
+////////////////////////////////////////////////////////////////
+
+class MessageBuffer::Sink
+  : public spdlog::sinks::base_sink<spdlog::details::null_mutex>
+{
+ public:
+  struct Message
+  {
+    ToolId tool;
+    int id;  // -1 for messages that are not counted
+    spdlog::level::level_enum level;
+    std::string text;
+  };
+  std::vector<Message> messages_;
+
+ protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override
+  {
+    messages_.push_back(
+        {UKN,
+         -1,
+         msg.level,
+         std::string(msg.payload.begin(), msg.payload.end())});
+  }
+  void flush_() override {}
+};
+
+void Logger::bufferMessage(ToolId tool,
+                           spdlog::level::level_enum level,
+                           int id,
+                           const std::string& message)
+{
+  thread_buffer_->sink_->messages_.push_back({tool, id, level, message});
+}
+
+MessageBuffer::MessageBuffer()
+  : sink_(std::make_shared<Sink>()),
+    logger_(std::make_shared<spdlog::logger>("buffer", sink_)),
+    previous_(nullptr),
+    previous_buffer_(nullptr)
+{
+  logger_->set_level(spdlog::level::level_enum::debug);
+}
+
+void MessageBuffer::begin()
+{
+  // A thread waiting on the pool can pick up another buffered task.
+  previous_ = Logger::thread_logger_;
+  previous_buffer_ = Logger::thread_buffer_;
+  Logger::thread_logger_ = logger_.get();
+  Logger::thread_buffer_ = this;
+}
+
+void MessageBuffer::end()
+{
+  Logger::thread_logger_ = previous_;
+  Logger::thread_buffer_ = previous_buffer_;
+}
+
+void MessageBuffer::flush(Logger* logger)
+{
+  for (auto& message : sink_->messages_) {
+    if (message.id < 0
+        || logger->countMessage(message.tool, message.level, message.id)) {
+      logger->logger_->log(message.level, message.text);
+    }
+  }
+  logger->logger_->flush();
+  sink_->messages_.clear();
+}
+
 }  // namespace
@@ -36,6 +36,7 @@
 %{
 
 #include "utl/Logger.h"
+#include "utl/Tracer.h"
 
 namespace ord {
 // Defined in OpenRoad.i
@@ -45,6 +46,7 @@ getLogger();
 
 using utl::ToolId;
 using utl::Logger;
+using utl::Tracer;
 using ord::getLogger;
 
 %}
@@ -120,6 +122,47 @@ metric(const char *metric,
   logger->metric(metric, value);
 }
 
+void
+enable_trace()
+{
+  Tracer::get().enable();
+}
+
+void
+disable_trace()
+{
+  Tracer::get().disable();
+}
+
+void
+begin_trace_stage(const char *name)
+{
+  Tracer::get().beginStage(name);
+}
+
+void
+end_trace_stage()
+{
+  Tracer::get().endStage();
+}
+
+void
+report_trace()
+{
+  Tracer::get().reportSummary(getLogger());
+}
+
+// Writes the Chrome trace and the span totals to the metrics file.
+void
+write_trace(const char *filename)
+{
+  Logger *logger = getLogger();
+  Tracer &tracer = Tracer::get();
+  if (!tracer.writeChromeTrace(filename))
+    logger->error(FLW, 1, "Unable to write trace file {}.", filename);
+  tracer.writeMetrics(logger);
+}
+
 } // namespace
 
 %} // inline
@@ -0,0 +1,230 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "utl/ThreadPool.h"
+
+#include <algorithm>
+
+namespace utl {
+
+static thread_local int thread_index = 0;
+
+ThreadPool& ThreadPool::get()
+{
+  static ThreadPool pool;
+  return pool;
+}
+
+ThreadPool::ThreadPool() : threads_(1), stop_(false)
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+  stopWorkers();
+}
+
+void ThreadPool::setThreadCount(int threads)
+{
+  threads = std::max(threads, 1);
+  if (threads == threads_)
+    return;
+  stopWorkers();
+  threads_ = threads;
+  startWorkers();
+}
+
+int ThreadPool::threadIndex()
+{
+  return thread_index;
+}
+
+void ThreadPool::startWorkers()
+{
+  stop_ = false;
+  for (int i = 1; i < threads_; i++)
+    workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+void ThreadPool::stopWorkers()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (std::thread& worker : workers_)
+    worker.join();
+  workers_.clear();
+}
+
+void ThreadPool::workerLoop(int index)
+{
+  thread_index = index;
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+      if (queue_.empty())
+        return;
+      task = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    task();
+  }
+}
+
+void ThreadPool::enqueue(std::function<void()> task)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back(std::move(task));
+  }
+  cv_.notify_all();
+}
+
+bool ThreadPool::runOne()
+{
+  std::function<void()> task;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.empty())
+      return false;
+    task = std::move(queue_.back());
+    queue_.pop_back();
+  }
+  task();
+  return true;
+}
+
+void ThreadPool::waitUntil(const std::function<bool()>& done)
+{
+  while (!done()) {
+    if (!runOne()) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&] { return done() || !queue_.empty(); });
+    }
+  }
+}
+
+void ThreadPool::notifyDone()
+{
+  // Taking the lock orders the notification after a waiter's check of
+  // its predicate so the wakeup is not lost.
+  { std::lock_guard<std::mutex> lock(mutex_); }
+  cv_.notify_all();
+}
+
+void ThreadPool::parallelFor(int begin,
+                             int end,
+                             const std::function<void(int)>& body,
+                             int max_threads)
+{
+  int threads = threads_;
+  if (max_threads > 0)
+    threads = std::min(threads, max_threads);
+  threads = std::min(threads, end - begin);
+  if (threads <= 1) {
+    for (int i = begin; i < end; i++)
+      body(i);
+    return;
+  }
+
+  std::atomic<int> next(begin);
+  TaskGroup group(*this);
+  auto loop = [&]() {
+    for (int i = next++; i < end && !group.isCanceled(); i = next++)
+      body(i);
+  };
+  for (int t = 1; t < threads; t++)
+    group.run(loop);
+  try {
+    loop();
+  } catch (...) {
+    group.cancel();
+    throw;
+  }
+  group.wait();
+}
+
+////////////////////////////////////////////////////////////////
+
+TaskGroup::TaskGroup(ThreadPool& pool)
+    : pool_(pool), pending_(0), canceled_(false)
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+  pool_.waitUntil([this] { return pending_ == 0; });
+}
+
+void TaskGroup::run(std::function<void()> task)
+{
+  pending_++;
+  auto wrapper = [this, task = std::move(task)]() {
+    if (!canceled_) {
+      try {
+        task();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(exception_mutex_);
+        if (!exception_)
+          exception_ = std::current_exception();
+        canceled_ = true;
+      }
+    }
+    // The group may be destroyed as soon as pending_ reaches zero.
+    ThreadPool& pool = pool_;
+    pending_--;
+    pool.notifyDone();
+  };
+  if (pool_.threadCount() > 1)
+    pool_.enqueue(std::move(wrapper));
+  else
+    wrapper();
+}
+
+void TaskGroup::wait()
+{
+  pool_.waitUntil([this] { return pending_ == 0; });
+  if (exception_) {
+    std::exception_ptr exception = exception_;
+    exception_ = nullptr;
+    std::rethrow_exception(exception);
+  }
+}
+
+}  // namespace utl
@@ -0,0 +1,257 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "utl/Tracer.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+namespace utl {
+
+std::atomic<bool> Tracer::enabled_(false);
+
+thread_local Tracer::ThreadBuffer* Tracer::thread_buffer_ = nullptr;
+
+Tracer& Tracer::get()
+{
+  static Tracer tracer;
+  return tracer;
+}
+
+Tracer::Tracer() : epoch_(Clock::now())
+{
+}
+
+void Tracer::enable()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Threads still recording compute their times from epoch_ under their
+  // buffer lock, so hold all of them while it changes.
+  std::vector<std::unique_lock<std::mutex>> buffer_locks;
+  for (auto& buffer : buffers_)
+    buffer_locks.emplace_back(buffer->mutex);
+  for (auto& buffer : buffers_)
+    buffer->events.clear();
+  stages_.clear();
+  epoch_ = Clock::now();
+  enabled_ = true;
+}
+
+void Tracer::disable()
+{
+  enabled_ = false;
+}
+
+Tracer::ThreadBuffer* Tracer::threadBuffer()
+{
+  if (thread_buffer_ == nullptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffers_.push_back(std::make_unique<ThreadBuffer>());
+    thread_buffer_ = buffers_.back().get();
+    thread_buffer_->id = buffers_.size() - 1;
+  }
+  return thread_buffer_;
+}
+
+double Tracer::sinceEpoch(Clock::time_point time) const
+{
+  return std::chrono::duration<double, std::micro>(time - epoch_).count();
+}
+
+void Tracer::addSpan(ToolId tool,
+                     const char* name,
+                     Clock::time_point start,
+                     Clock::time_point end)
+{
+  const double peak_memory = peakMemory();
+  ThreadBuffer* buffer = threadBuffer();
+  std::lock_guard<std::mutex> lock(buffer->mutex);
+  const double begin = sinceEpoch(start);
+  buffer->events.push_back(
+      {tool, name, begin, sinceEpoch(end) - begin, peak_memory});
+}
+
+void Tracer::addCounter(ToolId tool, const char* name, double value)
+{
+  const Clock::time_point now = Clock::now();
+  ThreadBuffer* buffer = threadBuffer();
+  std::lock_guard<std::mutex> lock(buffer->mutex);
+  buffer->events.push_back({tool, name, sinceEpoch(now), -1, value});
+}
+
+const char* Tracer::intern(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return names_.insert(name).first->c_str();
+}
+
+void Tracer::beginStage(const std::string& name)
+{
+  if (enabled())
+    stages_.emplace_back(intern(name), Clock::now());
+}
+
+void Tracer::endStage()
+{
+  if (!stages_.empty()) {
+    auto [name, start] = stages_.back();
+    stages_.pop_back();
+    if (enabled())
+      addSpan(FLW, name, start, Clock::now());
+  }
+}
+
+long Tracer::peakMemory()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024;  // bytes
+#else
+  return usage.ru_maxrss;
+#endif
+}
+
+static void writeJsonString(std::ofstream& out, const char* str)
+{
+  out << '"';
+  for (const char* c = str; *c; c++) {
+    if (*c == '"' || *c == '\\')
+      out << '\\' << *c;
+    else if (std::iscntrl(static_cast<unsigned char>(*c)))
+      out << ' ';
+    else
+      out << *c;
+  }
+  out << '"';
+}
+
+bool Tracer::writeChromeTrace(const char* filename) const
+{
+  std::ofstream out(filename);
+  if (!out)
+    return false;
+  out << "{\"traceEvents\":[\n";
+  bool first = true;
+  auto separator = [&]() {
+    if (!first)
+      out << ",\n";
+    first = false;
+  };
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& buffer : buffers_) {
+    std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+    separator();
+    out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":"
+        << buffer->id << ",\"args\":{\"name\":\"thread " << buffer->id
+        << "\"}}";
+    for (const Event& event : buffer->events) {
+      separator();
+      out << "{\"name\":";
+      writeJsonString(out, event.name);
+      out << ",\"cat\":\"" << Logger::toolName(event.tool)
+          << "\",\"pid\":0,\"tid\":" << buffer->id << ",\"ts\":"
+          << event.start;
+      if (event.duration >= 0) {
+        out << ",\"ph\":\"X\",\"dur\":" << event.duration
+            << ",\"args\":{\"peak_memory_kb\":" << event.value << "}}";
+      } else {
+        out << ",\"ph\":\"C\",\"args\":{\"value\":" << event.value << "}}";
+      }
+    }
+  }
+  out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  return out.good();
+}
+
+Tracer::SpanTotals Tracer::spanTotals() const
+{
+  SpanTotals totals;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& buffer : buffers_) {
+    std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+    for (const auto& event : buffer->events) {
+      if (event.duration >= 0) {
+        SpanTotal& total = totals[{event.tool, event.name}];
+        total.duration += event.duration;
+        total.count++;
+        total.peak_memory = std::max(total.peak_memory, event.value);
+      }
+    }
+  }
+  return totals;
+}
+
+void Tracer::reportSummary(Logger* logger) const
+{
+  logger->report("{:<4} {:<32} {:>8} {:>12} {:>12}",
+                 "Tool",
+                 "Span",
+                 "Calls",
+                 "Time (s)",
+                 "Peak (MB)");
+  for (const auto& [key, total] : spanTotals()) {
+    logger->report("{:<4} {:<32} {:>8} {:>12.3f} {:>12.1f}",
+                   Logger::toolName(key.first),
+                   key.second,
+                   total.count,
+                   total.duration / 1e6,
+                   total.peak_memory / 1024);
+  }
+}
+
+void Tracer::writeMetrics(Logger* logger) const
+{
+  for (const auto& [key, total] : spanTotals()) {
+    std::string tool = Logger::toolName(key.first);
+    std::transform(tool.begin(), tool.end(), tool.begin(), ::tolower);
+    // Metric keys are not escaped by the logger.
+    std::string name = key.second;
+    std::replace_if(
+        name.begin(),
+        name.end(),
+        [](char c) { return c == '"' || c == '\\' || std::iscntrl(c); },
+        '_');
+    const std::string prefix = tool + "::trace::" + name;
+    logger->metric(prefix + "::runtime", total.duration / 1e6);
+    logger->metric(prefix + "::count", total.count);
+  }
+  logger->metric("trace::peak_memory_mb", peakMemory() / 1024.0);
+}
+
+}  // namespace utl
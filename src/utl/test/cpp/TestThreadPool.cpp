@@ -0,0 +1,152 @@
+#define BOOST_TEST_MODULE TestThreadPool
+#include <boost/test/included/unit_test.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "utl/ThreadPool.h"
+
+using namespace utl;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+// Ids of the threads that ran body while the pool has threads threads.
+static std::set<std::thread::id> runThreads(int threads,
+                                            int max_threads,
+                                            int count)
+{
+  ThreadPool& pool = ThreadPool::get();
+  pool.setThreadCount(threads);
+  std::mutex mutex;
+  std::set<std::thread::id> ids;
+  pool.parallelFor(
+      0,
+      count,
+      [&](int) {
+        // Give the other threads time to pick up iterations.
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::lock_guard<std::mutex> lock(mutex);
+        ids.insert(std::this_thread::get_id());
+      },
+      max_threads);
+  return ids;
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_for)
+{
+  ThreadPool& pool = ThreadPool::get();
+  pool.setThreadCount(4);
+  // Boost.Test checks are not thread safe, so only count in the body.
+  std::vector<std::atomic<int>> visits(1000);
+  std::atomic<int> bad_index(0);
+  pool.parallelFor(10, 1000, [&](int i) {
+    visits[i]++;
+    const int index = ThreadPool::threadIndex();
+    if (index < 0 || index >= pool.threadCount())
+      bad_index++;
+  });
+  for (int i = 0; i < 1000; i++)
+    BOOST_TEST(visits[i] == (i < 10 ? 0 : 1));
+  BOOST_TEST(bad_index == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_nested_parallel_for)
+{
+  ThreadPool& pool = ThreadPool::get();
+  pool.setThreadCount(4);
+  // More outer iterations than threads, so every worker waits on its
+  // own inner loop and has to run queued tasks meanwhile.
+  std::vector<std::atomic<int>> sums(16);
+  pool.parallelFor(0, 16, [&](int i) {
+    pool.parallelFor(0, 100, [&](int j) { sums[i] += j; });
+  });
+  for (int i = 0; i < 16; i++)
+    BOOST_TEST(sums[i] == 4950);
+}
+
+BOOST_AUTO_TEST_CASE(test_max_threads)
+{
+  BOOST_TEST(runThreads(4, 2, 64).size() <= 2);
+  // One thread runs the loop on the calling thread.
+  std::set<std::thread::id> ids = runThreads(4, 1, 16);
+  BOOST_TEST(ids.size() == 1);
+  BOOST_TEST((*ids.begin() == std::this_thread::get_id()));
+  BOOST_TEST(runThreads(4, 0, 64).size() <= 4);
+  BOOST_TEST(runThreads(3, 8, 64).size() <= 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_exception)
+{
+  ThreadPool& pool = ThreadPool::get();
+  pool.setThreadCount(4);
+  std::atomic<int> visits(0);
+  BOOST_CHECK_EXCEPTION(pool.parallelFor(0,
+                                         1000,
+                                         [&](int i) {
+                                           visits++;
+                                           if (i == 37)
+                                             throw std::runtime_error("37");
+                                         }),
+                        std::runtime_error,
+                        [](const std::runtime_error& e) {
+                          return std::string(e.what()) == "37";
+                        });
+  // The remaining iterations are stopped.
+  BOOST_TEST(visits < 1000);
+
+  // From a nested loop.
+  BOOST_CHECK_THROW(pool.parallelFor(0,
+                                     8,
+                                     [&](int) {
+                                       pool.parallelFor(0, 8, [](int j) {
+                                         if (j == 5)
+                                           throw std::out_of_range("5");
+                                       });
+                                     }),
+                    std::out_of_range);
+
+  // The pool is still usable.
+  std::atomic<int> count(0);
+  pool.parallelFor(0, 100, [&](int) { count++; });
+  BOOST_TEST(count == 100);
+}
+
+BOOST_AUTO_TEST_CASE(test_set_thread_count)
+{
+  ThreadPool& pool = ThreadPool::get();
+  for (int threads : {4, 2, 1, 3, 3, 8}) {
+    pool.setThreadCount(threads);
+    BOOST_TEST(pool.threadCount() == threads);
+    std::atomic<int> count(0);
+    pool.parallelFor(0, 500, [&](int) { count++; });
+    BOOST_TEST(count == 500);
+  }
+  pool.setThreadCount(1);
+  std::set<std::thread::id> ids = runThreads(1, 0, 16);
+  BOOST_TEST(ids.size() == 1);
+  BOOST_TEST((*ids.begin() == std::this_thread::get_id()));
+  pool.setThreadCount(0);
+  BOOST_TEST(pool.threadCount() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_task_group)
+{
+  ThreadPool& pool = ThreadPool::get();
+  pool.setThreadCount(4);
+  std::atomic<int> count(0);
+  TaskGroup group(pool);
+  for (int i = 0; i < 50; i++)
+    group.run([&] { count++; });
+  group.wait();
+  BOOST_TEST(count == 50);
+
+  TaskGroup failing(pool);
+  failing.run([] { throw std::runtime_error("task"); });
+  BOOST_CHECK_THROW(failing.wait(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
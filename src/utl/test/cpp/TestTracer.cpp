@@ -0,0 +1,111 @@
+#define BOOST_TEST_MODULE TestTracer
+#include <boost/test/included/unit_test.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utl/Tracer.h"
+
+using namespace utl;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+static std::string readFile(const std::string& filename)
+{
+  std::ifstream in(filename);
+  std::stringstream contents;
+  contents << in.rdbuf();
+  return contents.str();
+}
+
+static int countOf(const std::string& text, const std::string& pattern)
+{
+  int count = 0;
+  for (size_t pos = text.find(pattern); pos != std::string::npos;
+       pos = text.find(pattern, pos + 1))
+    count++;
+  return count;
+}
+
+BOOST_AUTO_TEST_CASE(test_spans_and_counters)
+{
+  Tracer& tracer = Tracer::get();
+  tracer.enable();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([] {
+      for (int i = 0; i < 10; i++) {
+        TraceScope scope(GRT, "span");
+        traceCounter(GRT, "counter", i);
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+  tracer.disable();
+  // Disabled trace points record nothing.
+  {
+    TraceScope scope(GRT, "span");
+  }
+
+  const std::string filename = "tracer_spans.json";
+  BOOST_TEST(tracer.writeChromeTrace(filename.c_str()));
+  const std::string trace = readFile(filename);
+  BOOST_TEST(countOf(trace, "\"ph\":\"X\"") == 40);
+  BOOST_TEST(countOf(trace, "\"ph\":\"C\"") == 40);
+
+  // Enabling again drops the events.
+  tracer.enable();
+  tracer.disable();
+  BOOST_TEST(tracer.writeChromeTrace(filename.c_str()));
+  BOOST_TEST(countOf(readFile(filename), "\"ph\":\"X\"") == 0);
+  std::remove(filename.c_str());
+}
+
+// enable() and the writers may run while other threads record.
+BOOST_AUTO_TEST_CASE(test_write_while_recording)
+{
+  Tracer& tracer = Tracer::get();
+  tracer.enable();
+  std::atomic<bool> stop(false);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&stop] {
+      // Bounded so the buffers stay small if the writer is slow.
+      for (int i = 0; i < 20000 && !stop; i++) {
+        TraceScope scope(DRT, "busy");
+        traceCounter(DRT, "count", i);
+      }
+    });
+  }
+  const std::string filename = "tracer_busy.json";
+  bool written = true;
+  for (int i = 0; i < 20; i++) {
+    written &= tracer.writeChromeTrace(filename.c_str());
+    if (i % 5 == 0)
+      tracer.enable();
+  }
+  stop = true;
+  for (std::thread& thread : threads)
+    thread.join();
+  {
+    TraceScope scope(DRT, "busy");
+  }
+  tracer.disable();
+  written &= tracer.writeChromeTrace(filename.c_str());
+  BOOST_TEST(written);
+
+  const std::string trace = readFile(filename);
+  const std::string end = "\n],\"displayTimeUnit\":\"ms\"}\n";
+  BOOST_TEST(trace.find("\"name\":\"busy\"") != std::string::npos);
+  BOOST_TEST(trace.size() > end.size());
+  BOOST_TEST(trace.compare(trace.size() - end.size(), end.size(), end) == 0);
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()